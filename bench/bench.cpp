@@ -0,0 +1,984 @@
+/*
+	Benchmarks of the ft:: containers against their std:: counterparts
+
+	Every case runs one workload (insert, find, erase, iterate, copy...) over n
+	keys of one type, for n = 1e2 .. max_n, once with ft:: and once with std::.
+	flat_map, flat_set and static_set have no std:: counterpart in C++98,
+	their find and iterate rows compare with the map and set ones. map and set also run
+	with the B+ tree policy, as impl ft_btree, and with threaded nodes, as
+	impl ft_threaded, and over ft::huge_page_allocator, as impl ft_huge.
+	map/request builds, reads and drops a map and a vector, and runs over
+	the default allocators and over pmr resources (ft_arena, ft_pool).
+	unordered_map and unordered_set compare with std:: in
+	C++11 only, both sides with the same ft::hash. vector and stack also run
+	over ft::small_vector<K, 8>, as impl ft_small, and vector with 1.5x growth
+	rounded to malloc's block sizes, as impl ft_golden_fit, and over
+	ft::realloc_allocator, as impl ft_realloc (its blocks come from malloc and
+	mmap, they are not in allocs_per_op and bytes_per_op).
+	Small sizes are repeated until about min_ops operations were timed.
+	Results are written as CSV or JSON, one record per case:
+
+		container, impl, op, key, n, reps, ns_per_op, allocs_per_op,
+		bytes_per_op, peak_rss_kb
+
+	allocs_per_op and bytes_per_op count calls to the global operator new
+	during the timed part. peak_rss_kb is the high-water mark of the resident
+	set during the case (reset through /proc/self/clear_refs where available,
+	otherwise it is the peak of the whole process)
+
+	usage: bench [--format csv|json] [--max-n N] [--min-ops N]
+	             [--filter SUBSTRING] [--out FILE]
+*/
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <stack>
+#include <time.h>
+#include <sys/resource.h>
+
+#include "../containers/vector.hpp"
+#include "../containers/small_vector.hpp"
+#include "../utils/realloc_allocator.hpp"
+#include "../utils/huge_page_allocator.hpp"
+#include "../containers/pmr.hpp"
+#include "../containers/map.hpp"
+#include "../containers/set.hpp"
+#include "../containers/stack.hpp"
+#include "../containers/flat_map.hpp"
+#include "../containers/flat_set.hpp"
+#include "../containers/static_set.hpp"
+#include "../containers/unordered_map.hpp"
+#include "../containers/unordered_set.hpp"
+#if FT_CXX11
+# include <unordered_map>
+# include <unordered_set>
+#endif
+
+/* Allocation counting ------------------------------------------------------- */
+static size_t	g_allocs = 0;
+static size_t	g_bytes = 0;
+
+/* dynamic exception specifications are gone since C++17 */
+#if FT_CXX11
+# define THROWS_BAD_ALLOC
+# define THROWS_NOTHING 	noexcept
+#else
+# define THROWS_BAD_ALLOC 	throw(std::bad_alloc)
+# define THROWS_NOTHING 	throw()
+#endif
+
+/* kept out of line, GCC would otherwise pair the inlined malloc with delete */
+#if defined(__GNUC__)
+# define NOINLINE 	__attribute__((noinline))
+#else
+# define NOINLINE
+#endif
+
+NOINLINE void *operator new(size_t size) THROWS_BAD_ALLOC
+{
+	void *p = std::malloc(size ? size : 1);
+
+	if (!p)
+		throw std::bad_alloc();
+	g_allocs++;
+	g_bytes += size;
+	return p;
+}
+
+NOINLINE void operator delete(void *p) THROWS_NOTHING
+{
+	std::free(p);
+}
+
+/* C++14 sized deallocation would bypass the replacement above */
+#if defined(__cpp_sized_deallocation)
+NOINLINE void operator delete(void *p, size_t) THROWS_NOTHING
+{
+	operator delete(p);
+}
+#endif
+
+/* Resident set ------------------------------------------------------------- */
+/* asks the kernel to restart VmHWM from the current resident size */
+static void reset_peak_rss()
+{
+	FILE *f = std::fopen("/proc/self/clear_refs", "w");
+
+	if (f)
+	{
+		std::fputs("5", f);
+		std::fclose(f);
+	}
+}
+
+static long peak_rss_kb()
+{
+	FILE 	*f = std::fopen("/proc/self/status", "r");
+	char 	line[256];
+	long 	kb = -1;
+
+	if (f)
+	{
+		while (std::fgets(line, sizeof(line), f))
+		{
+			if (std::strncmp(line, "VmHWM:", 6) == 0)
+			{
+				kb = std::atol(line + 6);
+				break ;
+			}
+		}
+		std::fclose(f);
+	}
+	if (kb < 0)
+	{
+		struct rusage ru;
+
+		getrusage(RUSAGE_SELF, &ru);
+		kb = ru.ru_maxrss;
+	}
+	return kb;
+}
+
+/* Timer --------------------------------------------------------------------- */
+/* accumulates the timed parts of a case, setup and teardown stay outside */
+class Meter
+{
+	public :
+
+		Meter()
+		: __ns(0), __allocs(0), __bytes(0), __start(0), __allocs0(0), __bytes0(0)
+		{}
+
+		void start()
+		{
+			__allocs0 = g_allocs;
+			__bytes0 = g_bytes;
+			__start = now();
+		}
+
+		void stop()
+		{
+			__ns += now() - __start;
+			__allocs += g_allocs - __allocs0;
+			__bytes += g_bytes - __bytes0;
+		}
+
+		double 	ns() const		{ return __ns; }
+		size_t 	allocs() const	{ return __allocs; }
+		size_t 	bytes() const	{ return __bytes; }
+
+	private :
+
+		static double now()
+		{
+			struct timespec ts;
+
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return ts.tv_sec * 1e9 + ts.tv_nsec;
+		}
+
+		double	__ns;
+		size_t	__allocs;
+		size_t	__bytes;
+		double	__start;
+		size_t	__allocs0;
+		size_t	__bytes0;
+};
+
+/* keeps the optimizer from dropping the measured work */
+static volatile size_t g_sink;
+
+/* Key types ----------------------------------------------------------------- */
+/* a 64 byte trivially copyable record ordered by its first field */
+struct Pod64
+{
+	long	id;
+	long	pad[7];
+
+	bool operator<(const Pod64 & rhs) const
+	{
+		return id < rhs.id;
+	}
+	bool operator==(const Pod64 & rhs) const
+	{
+		return id == rhs.id;
+	}
+};
+
+namespace ft
+{
+	template <>
+	struct hash<Pod64>
+	{
+		size_t operator()(const Pod64 & k) const
+		{
+			return static_cast<size_t>(k.id);
+		}
+	};
+}
+
+template <class K>
+struct key_traits;
+
+template <>
+struct key_traits<int>
+{
+	static const char *name() { return "int"; }
+	static int make(size_t i) { return static_cast<int>(i); }
+	static size_t hash(const int & k) { return static_cast<size_t>(k); }
+};
+
+template <>
+struct key_traits<std::string>
+{
+	static const char *name() { return "string"; }
+	/* 24 characters, longer than the small string buffer */
+	static std::string make(size_t i)
+	{
+		char buf[32];
+
+		std::sprintf(buf, "key-%020lu", static_cast<unsigned long>(i));
+		return std::string(buf);
+	}
+	static size_t hash(const std::string & k) { return k.size() + static_cast<unsigned char>(k[k.size() - 1]); }
+};
+
+template <>
+struct key_traits<Pod64>
+{
+	static const char *name() { return "pod64"; }
+	static Pod64 make(size_t i)
+	{
+		Pod64 p;
+
+		p.id = static_cast<long>(i);
+		for (int j = 0; j < 7; ++j)
+			p.pad[j] = static_cast<long>(i) + j;
+		return p;
+	}
+	static size_t hash(const Pod64 & k) { return static_cast<size_t>(k.id); }
+};
+
+/* deterministic permutation of 0 .. n-1 */
+static std::vector<size_t> shuffled(size_t n, unsigned seed)
+{
+	std::vector<size_t> idx(n);
+	unsigned long long 	state = seed * 2654435761ULL + 1;
+
+	for (size_t i = 0; i < n; ++i)
+		idx[i] = i;
+	for (size_t i = n; i > 1; --i)
+	{
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		std::swap(idx[i - 1], idx[(state >> 33) % i]);
+	}
+	return idx;
+}
+
+/* keys 0, 2, 4 ... in random order; odd keys are misses */
+template <class K>
+static std::vector<K> random_keys(size_t n, unsigned seed)
+{
+	std::vector<size_t> idx = shuffled(n, seed);
+	std::vector<K> 		keys;
+
+	keys.reserve(n);
+	for (size_t i = 0; i < n; ++i)
+		keys.push_back(key_traits<K>::make(idx[i] * 2));
+	return keys;
+}
+
+template <class K>
+static std::vector<K> sorted_keys(size_t n)
+{
+	std::vector<K> keys;
+
+	keys.reserve(n);
+	for (size_t i = 0; i < n; ++i)
+		keys.push_back(key_traits<K>::make(i * 2));
+	return keys;
+}
+
+/* Vector workloads ---------------------------------------------------------- */
+template <class V>
+static void vector_push_back(const std::vector<typename V::value_type> & keys, Meter & m)
+{
+	V *v = new V;
+
+	m.start();
+	for (size_t i = 0; i < keys.size(); ++i)
+		v->push_back(keys[i]);
+	m.stop();
+	delete v;
+}
+
+template <class V>
+static void vector_iterate(const V & v, Meter & m)
+{
+	size_t sum = 0;
+
+	m.start();
+	for (typename V::const_iterator it = v.begin(); it != v.end(); ++it)
+		sum += key_traits<typename V::value_type>::hash(*it);
+	m.stop();
+	g_sink = sum;
+}
+
+template <class V>
+static void vector_random_access(const V & v, const std::vector<size_t> & idx, Meter & m)
+{
+	size_t sum = 0;
+
+	m.start();
+	for (size_t i = 0; i < idx.size(); ++i)
+		sum += key_traits<typename V::value_type>::hash(v[idx[i]]);
+	m.stop();
+	g_sink = sum;
+}
+
+template <class V>
+static void vector_copy(const V & v, Meter & m)
+{
+	m.start();
+	V *copy = new V(v);
+	m.stop();
+	g_sink = copy->size();
+	delete copy;
+}
+
+/* many short-lived vectors of 8 elements, where a small_vector stays inline */
+template <class V>
+static void vector_short_lived(const std::vector<typename V::value_type> & keys, Meter & m)
+{
+	size_t sum = 0;
+
+	m.start();
+	for (size_t i = 0; i + 8 <= keys.size(); i += 8)
+	{
+		V v;
+		for (size_t j = i; j < i + 8; ++j)
+			v.push_back(keys[j]);
+		sum += key_traits<typename V::value_type>::hash(v.back());
+	}
+	m.stop();
+	g_sink = sum;
+}
+
+template <class V>
+static void vector_pop_back(V & v, Meter & m)
+{
+	m.start();
+	while (!v.empty())
+		v.pop_back();
+	m.stop();
+}
+
+/* Stack workloads ----------------------------------------------------------- */
+template <class S>
+static void stack_push_pop(const std::vector<typename S::value_type> & keys, Meter & m)
+{
+	S *s = new S;
+
+	m.start();
+	for (size_t i = 0; i < keys.size(); ++i)
+		s->push(keys[i]);
+	while (!s->empty())
+	{
+		g_sink = key_traits<typename S::value_type>::hash(s->top());
+		s->pop();
+	}
+	m.stop();
+	delete s;
+}
+
+/* Map / set workloads ------------------------------------------------------- */
+/* map and set only differ in how a value is built from a key */
+template <class C, class K>
+struct value_of
+{
+	static typename C::value_type make(const K & k)
+	{
+		return typename C::value_type(k, 0);
+	}
+};
+
+template <class K>
+struct value_of<std::set<K>, K>
+{
+	static const K & make(const K & k) { return k; }
+};
+
+template <class K, class C, class A, class P>
+struct value_of<ft::set<K, C, A, P>, K>
+{
+	static const K & make(const K & k) { return k; }
+};
+
+template <class K>
+struct value_of<ft::flat_set<K>, K>
+{
+	static const K & make(const K & k) { return k; }
+};
+
+template <class K>
+struct value_of<ft::static_set<K>, K>
+{
+	static const K & make(const K & k) { return k; }
+};
+
+template <class K>
+struct value_of<ft::unordered_set<K>, K>
+{
+	static const K & make(const K & k) { return k; }
+};
+
+#if FT_CXX11
+template <class K>
+struct value_of<std::unordered_set<K, ft::hash<K> >, K>
+{
+	static const K & make(const K & k) { return k; }
+};
+#endif
+
+template <class C>
+static void assoc_insert(const std::vector<typename C::key_type> & keys, Meter & m)
+{
+	typedef typename C::key_type K;
+	C *c = new C;
+
+	m.start();
+	for (size_t i = 0; i < keys.size(); ++i)
+		c->insert(value_of<C, K>::make(keys[i]));
+	m.stop();
+	delete c;
+}
+
+template <class C>
+static void assoc_insert_hint_end(const std::vector<typename C::key_type> & keys, Meter & m)
+{
+	typedef typename C::key_type K;
+	C *c = new C;
+
+	m.start();
+	for (size_t i = 0; i < keys.size(); ++i)
+		c->insert(c->end(), value_of<C, K>::make(keys[i]));
+	m.stop();
+	delete c;
+}
+
+template <class C>
+static void assoc_find(const C & c, const std::vector<typename C::key_type> & keys, Meter & m)
+{
+	size_t hits = 0;
+
+	m.start();
+	for (size_t i = 0; i < keys.size(); ++i)
+		hits += (c.find(keys[i]) != c.end());
+	m.stop();
+	g_sink = hits;
+}
+
+template <class C>
+static void assoc_erase(C & c, const std::vector<typename C::key_type> & keys, Meter & m)
+{
+	size_t erased = 0;
+
+	m.start();
+	for (size_t i = 0; i < keys.size(); ++i)
+		erased += c.erase(keys[i]);
+	m.stop();
+	g_sink = erased;
+}
+
+template <class C>
+static void assoc_iterate(const C & c, Meter & m)
+{
+	size_t n = 0;
+
+	m.start();
+	for (typename C::const_iterator it = c.begin(); it != c.end(); ++it)
+		n++;
+	m.stop();
+	g_sink = n;
+}
+
+template <class C>
+static void assoc_copy(const C & c, Meter & m)
+{
+	m.start();
+	C *copy = new C(c);
+	m.stop();
+	g_sink = copy->size();
+	delete copy;
+}
+
+/* 
+	a request over memory resource R: a map and a vector are built, read and 
+	dropped, the resource is released. R = no_resource keeps the default 
+	allocation, a pmr container then draws from the resource through the 
+	default resource 
+*/
+struct no_resource
+{
+	void release() {}
+};
+
+static void use_resource(no_resource *) {}
+static void use_resource(ft::pmr::memory_resource *res)
+{
+	ft::pmr::set_default_resource(res);
+}
+
+template <class C, class V, class R>
+static void map_request(const std::vector<typename C::key_type> & keys, Meter & m)
+{
+	typedef typename C::key_type K;
+	size_t hits = 0;
+
+	m.start();
+	{
+		R res;
+
+		use_resource(&res);
+		{
+			C c;
+			V v;
+
+			for (size_t i = 0; i < keys.size(); ++i)
+				c.insert(value_of<C, K>::make(keys[i]));
+			for (size_t i = 0; i < keys.size(); ++i)
+				v.push_back(keys[i]);
+			for (size_t i = 0; i < keys.size(); ++i)
+				hits += (c.find(v[i]) != c.end());
+		}
+		res.release();
+		ft::pmr::set_default_resource(NULL);
+	}
+	m.stop();
+	g_sink = hits;
+}
+
+/* flat containers are built from a whole batch, one insert is O(n) */
+template <class C>
+static void assoc_build(const std::vector<typename C::value_type> & values, Meter & m)
+{
+	m.start();
+	C *c = new C(values.begin(), values.end());
+	m.stop();
+	g_sink = c->size();
+	delete c;
+}
+
+template <class C>
+static void map_subscript(const std::vector<typename C::key_type> & keys, Meter & m)
+{
+	C *c = new C;
+
+	m.start();
+	for (size_t i = 0; i < keys.size(); ++i)
+		(*c)[keys[i]]++;
+	for (size_t i = 0; i < keys.size(); ++i)
+		(*c)[keys[i]]++;
+	m.stop();
+	delete c;
+}
+
+/* Driver -------------------------------------------------------------------- */
+struct Options
+{
+	bool		json;
+	size_t		max_n;
+	size_t		min_ops;
+	const char	*filter;
+	FILE		*out;
+};
+
+static Options 	g_opt;
+static bool 	g_first_record = true;
+
+static void emit(	const char *container, const char *impl, const char *op,
+					const char *key, size_t n, size_t reps, size_t ops,
+					const Meter & m, long rss)
+{
+	double ns_op = m.ns() / ops;
+	double allocs_op = static_cast<double>(m.allocs()) / ops;
+	double bytes_op = static_cast<double>(m.bytes()) / ops;
+
+	if (g_opt.json)
+	{
+		std::fprintf(g_opt.out, "%s\n  {\"container\": \"%s\", \"impl\": \"%s\", \"op\": \"%s\", "
+					"\"key\": \"%s\", \"n\": %lu, \"reps\": %lu, \"ns_per_op\": %.3f, "
+					"\"allocs_per_op\": %.4f, \"bytes_per_op\": %.2f, \"peak_rss_kb\": %ld}",
+					g_first_record ? "" : ",", container, impl, op, key,
+					static_cast<unsigned long>(n), static_cast<unsigned long>(reps),
+					ns_op, allocs_op, bytes_op, rss);
+	}
+	else
+	{
+		std::fprintf(g_opt.out, "%s,%s,%s,%s,%lu,%lu,%.3f,%.4f,%.2f,%ld\n",
+					container, impl, op, key, static_cast<unsigned long>(n),
+					static_cast<unsigned long>(reps), ns_op, allocs_op, bytes_op, rss);
+	}
+	std::fflush(g_opt.out);
+	g_first_record = false;
+}
+
+static bool selected(const char *container, const char *op, const char *key)
+{
+	char name[128];
+
+	if (!g_opt.filter)
+		return true;
+	std::sprintf(name, "%s/%s/%s", container, op, key);
+	return std::strstr(name, g_opt.filter) != NULL;
+}
+
+static size_t reps_for(size_t n)
+{
+	return n >= g_opt.min_ops ? 1 : g_opt.min_ops / n;
+}
+
+/* one container type, one implementation, every op at one size */
+template <class V>
+static void bench_vector(const char *impl, size_t n)
+{
+	typedef typename V::value_type 	K;
+	const char 						*key = key_traits<K>::name();
+	std::vector<K> 					keys = random_keys<K>(n, 1);
+	std::vector<size_t> 			idx = shuffled(n, 2);
+	size_t 							reps = reps_for(n);
+
+	if (selected("vector", "push_back", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			vector_push_back<V>(keys, m);
+		emit("vector", impl, "push_back", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+	if (selected("vector", "short_lived", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			vector_short_lived<V>(keys, m);
+		emit("vector", impl, "short_lived", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+
+	V v;
+	for (size_t i = 0; i < n; ++i)
+		v.push_back(keys[i]);
+	if (selected("vector", "iterate", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			vector_iterate(v, m);
+		emit("vector", impl, "iterate", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+	if (selected("vector", "random_access", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			vector_random_access(v, idx, m);
+		emit("vector", impl, "random_access", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+	if (selected("vector", "copy", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			vector_copy(v, m);
+		emit("vector", impl, "copy", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+	if (selected("vector", "pop_back", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+		{
+			V tmp(v);
+			vector_pop_back(tmp, m);
+		}
+		emit("vector", impl, "pop_back", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+}
+
+template <class S>
+static void bench_stack(const char *impl, size_t n)
+{
+	typedef typename S::value_type 	K;
+	const char 						*key = key_traits<K>::name();
+	std::vector<K> 					keys = random_keys<K>(n, 1);
+	size_t 							reps = reps_for(n);
+
+	if (selected("stack", "push_pop", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			stack_push_pop<S>(keys, m);
+		emit("stack", impl, "push_pop", key, n, reps, 2 * n * reps, m, peak_rss_kb());
+	}
+}
+
+template <class C>
+static void bench_assoc(const char *container, const char *impl, size_t n)
+{
+	typedef typename C::key_type 	K;
+	const char 						*key = key_traits<K>::name();
+	std::vector<K> 					keys = random_keys<K>(n, 1);
+	std::vector<K> 					lookups = random_keys<K>(n, 3);
+	std::vector<K> 					sorted = sorted_keys<K>(n);
+	size_t 							reps = reps_for(n);
+
+	if (selected(container, "insert", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			assoc_insert<C>(keys, m);
+		emit(container, impl, "insert", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+	if (selected(container, "insert_sorted_hint", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			assoc_insert_hint_end<C>(sorted, m);
+		emit(container, impl, "insert_sorted_hint", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+
+	C c;
+	for (size_t i = 0; i < n; ++i)
+		c.insert(value_of<C, K>::make(keys[i]));
+	if (selected(container, "find", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			assoc_find(c, lookups, m);
+		emit(container, impl, "find", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+	if (selected(container, "iterate", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			assoc_iterate(c, m);
+		emit(container, impl, "iterate", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+	if (selected(container, "copy", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			assoc_copy(c, m);
+		emit(container, impl, "copy", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+	if (selected(container, "erase", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+		{
+			C tmp(c);
+			assoc_erase(tmp, lookups, m);
+		}
+		emit(container, impl, "erase", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+}
+
+template <class C>
+static void bench_flat(const char *container, size_t n)
+{
+	typedef typename C::key_type 	K;
+	const char 						*key = key_traits<K>::name();
+	std::vector<K> 					keys = random_keys<K>(n, 1);
+	std::vector<K> 					lookups = random_keys<K>(n, 3);
+	std::vector<typename C::value_type>	values;
+	size_t 							reps = reps_for(n);
+
+	for (size_t i = 0; i < n; ++i)
+		values.push_back(value_of<C, K>::make(keys[i]));
+	if (selected(container, "build", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			assoc_build<C>(values, m);
+		emit(container, "ft", "build", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+
+	C c(values.begin(), values.end());
+	if (selected(container, "find", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			assoc_find(c, lookups, m);
+		emit(container, "ft", "find", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+	if (selected(container, "iterate", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			assoc_iterate(c, m);
+		emit(container, "ft", "iterate", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+	if (selected(container, "copy", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			assoc_copy(c, m);
+		emit(container, "ft", "copy", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+}
+
+template <class C>
+static void bench_subscript(const char *impl, size_t n)
+{
+	typedef typename C::key_type 	K;
+	const char 						*key = key_traits<K>::name();
+	std::vector<K> 					keys = random_keys<K>(n, 1);
+	size_t 							reps = reps_for(n);
+
+	if (selected("map", "subscript", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			map_subscript<C>(keys, m);
+		emit("map", impl, "subscript", key, n, reps, 2 * n * reps, m, peak_rss_kb());
+	}
+}
+
+template <class C, class V, class R>
+static void bench_request(const char *impl, size_t n)
+{
+	typedef typename C::key_type 	K;
+	const char 						*key = key_traits<K>::name();
+	std::vector<K> 					keys = random_keys<K>(n, 1);
+	size_t 							reps = reps_for(n);
+
+	if (selected("map", "request", key))
+	{
+		Meter m;
+		reset_peak_rss();
+		for (size_t r = 0; r < reps; ++r)
+			map_request<C, V, R>(keys, m);
+		emit("map", impl, "request", key, n, reps, n * reps, m, peak_rss_kb());
+	}
+}
+
+template <class K>
+static void bench_key(size_t n)
+{
+	bench_vector< ft::vector<K> >("ft", n);
+	bench_vector< std::vector<K> >("std", n);
+	bench_vector< ft::small_vector<K, 8> >("ft_small", n);
+	bench_vector< ft::vector<K, std::allocator<K>,
+							ft::grow_glibc_fit<ft::grow_golden> > >("ft_golden_fit", n);
+	bench_vector< ft::vector<K, ft::realloc_allocator<K> > >("ft_realloc", n);
+	bench_stack< ft::stack<K> >("ft", n);
+	bench_stack< std::stack<K, std::vector<K> > >("std", n);
+	bench_stack< ft::stack<K, ft::small_vector<K, 8> > >("ft_small", n);
+	bench_assoc< ft::map<K, int> >("map", "ft", n);
+	bench_assoc< std::map<K, int> >("map", "std", n);
+	bench_subscript< ft::map<K, int> >("ft", n);
+	bench_subscript< std::map<K, int> >("std", n);
+	bench_request< ft::map<K, int>, ft::vector<K>, no_resource >("ft", n);
+	bench_request< std::map<K, int>, std::vector<K>, no_resource >("std", n);
+	bench_request< ft::map<K, int, std::less<K>, ft::pmr::polymorphic_allocator<ft::pair<const K, int> > >,
+					ft::vector<K, ft::pmr::polymorphic_allocator<K> >,
+					ft::pmr::monotonic_buffer_resource >("ft_arena", n);
+	bench_request< ft::map<K, int, std::less<K>, ft::pmr::polymorphic_allocator<ft::pair<const K, int> > >,
+					ft::vector<K, ft::pmr::polymorphic_allocator<K> >,
+					ft::pmr::unsynchronized_pool_resource >("ft_pool", n);
+	bench_assoc< ft::set<K> >("set", "ft", n);
+	bench_assoc< std::set<K> >("set", "std", n);
+	bench_assoc< ft::map<K, int, std::less<K>, std::allocator<ft::pair<const K, int> >,
+							ft::btree_nodes<> > >("map", "ft_btree", n);
+	bench_assoc< ft::set<K, std::less<K>, std::allocator<K>, ft::btree_nodes<> > >("set", "ft_btree", n);
+	bench_assoc< ft::map<K, int, std::less<K>, std::allocator<ft::pair<const K, int> >,
+							ft::threaded<> > >("map", "ft_threaded", n);
+	bench_assoc< ft::set<K, std::less<K>, std::allocator<K>, ft::threaded<> > >("set", "ft_threaded", n);
+	bench_assoc< ft::map<K, int, std::less<K>,
+							ft::huge_page_allocator<ft::pair<const K, int> > > >("map", "ft_huge", n);
+	bench_flat< ft::flat_map<K, int> >("flat_map", n);
+	bench_flat< ft::flat_set<K> >("flat_set", n);
+	bench_flat< ft::static_set<K> >("static_set", n);
+	bench_assoc< ft::unordered_map<K, int> >("unordered_map", "ft", n);
+	bench_assoc< ft::unordered_set<K> >("unordered_set", "ft", n);
+#if FT_CXX11
+	bench_assoc< std::unordered_map<K, int, ft::hash<K> > >("unordered_map", "std", n);
+	bench_assoc< std::unordered_set<K, ft::hash<K> > >("unordered_set", "std", n);
+#endif
+}
+
+static void usage(const char *name)
+{
+	std::fprintf(stderr, "usage: %s [--format csv|json] [--max-n N] [--min-ops N] "
+						"[--filter SUBSTRING] [--out FILE]\n", name);
+	std::exit(2);
+}
+
+int main(int argc, char **argv)
+{
+	g_opt.json = false;
+	g_opt.max_n = 10000000;
+	g_opt.min_ops = 1000000;
+	g_opt.filter = NULL;
+	g_opt.out = stdout;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (i + 1 >= argc)
+			usage(argv[0]);
+		if (!std::strcmp(argv[i], "--format"))
+			g_opt.json = !std::strcmp(argv[++i], "json");
+		else if (!std::strcmp(argv[i], "--max-n"))
+			g_opt.max_n = static_cast<size_t>(std::atof(argv[++i]));
+		else if (!std::strcmp(argv[i], "--min-ops"))
+			g_opt.min_ops = static_cast<size_t>(std::atof(argv[++i]));
+		else if (!std::strcmp(argv[i], "--filter"))
+			g_opt.filter = argv[++i];
+		else if (!std::strcmp(argv[i], "--out"))
+		{
+			g_opt.out = std::fopen(argv[++i], "w");
+			if (!g_opt.out)
+			{
+				std::perror(argv[i]);
+				return 1;
+			}
+		}
+		else
+			usage(argv[0]);
+	}
+
+	if (g_opt.json)
+		std::fprintf(g_opt.out, "[");
+	else
+		std::fprintf(g_opt.out, "container,impl,op,key,n,reps,ns_per_op,"
+								"allocs_per_op,bytes_per_op,peak_rss_kb\n");
+	for (size_t n = 100; n <= g_opt.max_n; n *= 10)
+	{
+		bench_key<int>(n);
+		bench_key<std::string>(n);
+		bench_key<Pod64>(n);
+	}
+	if (g_opt.json)
+		std::fprintf(g_opt.out, "\n]\n");
+	if (g_opt.out != stdout)
+		std::fclose(g_opt.out);
+	return 0;
+}
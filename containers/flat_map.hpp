@@ -0,0 +1,869 @@
+#ifndef 	FLAT_MAP_HPP
+# define 	FLAT_MAP_HPP
+
+# include <memory>
+# include <functional>
+# include <algorithm>
+# include <stdexcept>
+# include "vector.hpp"
+# include "../utils/utils.hpp"
+# include "../utils/enable_if.hpp"
+# include "../utils/flat_search.hpp"
+# include "../utils/flat_iterator.hpp"
+
+namespace ft
+{
+	/*
+		Sorted associative container with the interface of ft::map, stored as
+		two parallel sorted ft::vectors: one for the keys, one for the mapped
+		values. A lookup binary searches the dense key array only, and a scan
+		walks contiguous memory, so read-mostly workloads beat the node based
+		tree by a wide margin. The price is O(n) single inserts and erases, and
+		iterators are invalidated by every insert and erase; batch inserts
+		through the range insert, which merges in linear time
+	*/
+	template <class Key, class T, class Compare = std::less<Key>,
+                       class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class flat_map
+	{
+		public :
+
+			/* typedefs ------------------------------------------------------ */
+			typedef Key														key_type;
+			typedef T														mapped_type;
+			typedef ft::pair<Key, T>										value_type;
+			typedef Compare													key_compare;
+			typedef Allocator												allocator_type;
+			typedef	std::ptrdiff_t											difference_type;
+			typedef	size_t													size_type;
+			typedef typename Allocator::template rebind<Key>::other			key_allocator_type;
+			typedef typename Allocator::template rebind<T>::other			mapped_allocator_type;
+			typedef ft::vector<Key, key_allocator_type>						key_container_type;
+			typedef ft::vector<T, mapped_allocator_type>					mapped_container_type;
+
+			class value_compare
+			{
+				friend class flat_map;
+				protected:
+					Compare comp;
+					value_compare(Compare c) : comp(c) {}
+				public:
+					template <class P1, class P2>
+					bool operator()(const P1 & x, const P2 & y) const
+					{
+						return comp(x.first, y.first);
+					}
+			};
+
+			/* iterators ----------------------------------------------------- */
+			typedef flat_map_iter<Key, T, T *>								iterator;
+			typedef flat_map_iter<Key, T, const T *>						const_iterator;
+			typedef typename iterator::reference							reference;
+			typedef typename const_iterator::reference						const_reference;
+			typedef v_reverse_iter<iterator>								reverse_iterator;
+			typedef v_reverse_iter<const_iterator>							const_reverse_iterator;
+
+			/* constructors ---------------------------------------------------*/
+			flat_map()
+			:	__alloc(allocator_type()),
+				__comp(key_compare()),
+				__keys(key_allocator_type(__alloc)),
+				__values(mapped_allocator_type(__alloc))
+			{}
+
+			explicit flat_map(const key_compare & comp, const allocator_type& alloc = allocator_type())
+			: 	__alloc(alloc),
+				__comp(comp),
+				__keys(key_allocator_type(alloc)),
+				__values(mapped_allocator_type(alloc))
+			{}
+
+			template <class InputIt>
+			flat_map(InputIt first, InputIt last, const key_compare& comp = key_compare(),
+												const allocator_type& alloc = allocator_type())
+			: 	__alloc(alloc),
+				__comp(comp),
+				__keys(key_allocator_type(alloc)),
+				__values(mapped_allocator_type(alloc))
+			{
+				__insert_batch(first, last);
+			}
+
+			/* [first, last) is sorted by comp; appended without a sort or a merge */
+			template <class InputIt>
+			flat_map(from_sorted_t, InputIt first, InputIt last, const key_compare& comp = key_compare(),
+												const allocator_type& alloc = allocator_type())
+			: 	__alloc(alloc),
+				__comp(comp),
+				__keys(key_allocator_type(alloc)),
+				__values(mapped_allocator_type(alloc))
+			{
+				for (; first != last; ++first)
+				{
+					if (!__append_sorted(*first))
+					{
+						__insert_batch(first, last);
+						return;
+					}
+				}
+			}
+
+			flat_map(const flat_map & rhs)
+			: 	__alloc(rhs.__alloc),
+				__comp(rhs.__comp),
+				__keys(rhs.__keys),
+				__values(rhs.__values)
+			{}
+
+			flat_map & operator=(const flat_map & rhs)
+			{
+				if (this != &rhs)
+				{
+					__keys = rhs.__keys;
+					__values = rhs.__values;
+					__comp = rhs.__comp;
+					__alloc = rhs.__alloc;
+				}
+				return *this;
+			}
+
+# if FT_CXX11
+			flat_map(flat_map && rhs)
+			: 	__alloc(rhs.__alloc),
+				__comp(rhs.__comp),
+				__keys(std::move(rhs.__keys)),
+				__values(std::move(rhs.__values))
+			{}
+
+			flat_map & operator=(flat_map && rhs)
+			{
+				if (this != &rhs)
+				{
+					__keys = std::move(rhs.__keys);
+					__values = std::move(rhs.__values);
+					__comp = rhs.__comp;
+					__alloc = rhs.__alloc;
+				}
+				return *this;
+			}
+# endif
+
+			~flat_map() {}
+
+			allocator_type get_allocator() const
+			{
+				return __alloc;
+			}
+
+			/* counters of the key and mapped vectors added up, zero unless built with FT_STATS (see stats.hpp) */
+			container_stats stats() const
+			{
+				container_stats res = __keys.stats();
+
+				res += __values.stats();
+				return res;
+			}
+
+			/* iterators ----------------------------------------------------- */
+			iterator begin()
+			{
+				return iterator(__keys.data(), __values.data());
+			}
+			const_iterator begin() const
+			{
+				return const_iterator(__keys.data(), __values.data());
+			}
+			iterator end()
+			{
+				return begin() + size();
+			}
+			const_iterator end() const
+			{
+				return begin() + size();
+			}
+			reverse_iterator rbegin()
+			{
+				return reverse_iterator(end());
+			}
+			const_reverse_iterator rbegin() const
+			{
+				return const_reverse_iterator(end());
+			}
+			reverse_iterator rend()
+			{
+				return reverse_iterator(begin());
+			}
+			const_reverse_iterator rend() const
+			{
+				return const_reverse_iterator(begin());
+			}
+
+			/* capacity ------------------------------------------------------ */
+			bool empty() const
+			{
+				return __keys.empty();
+			}
+			size_type size() const
+			{
+				return __keys.size();
+			}
+			size_type max_size() const
+			{
+				return std::min(__keys.max_size(), __values.max_size());
+			}
+			void reserve(size_type n)
+			{
+				__keys.reserve(n);
+				__values.reserve(n);
+			}
+			size_type capacity() const
+			{
+				return std::min(__keys.capacity(), __values.capacity());
+			}
+
+			/* the underlying sorted arrays ---------------------------------- */
+			const key_container_type & keys() const
+			{
+				return __keys;
+			}
+			const mapped_container_type & values() const
+			{
+				return __values;
+			}
+
+			/* element access ------------------------------------------------ */
+			mapped_type & operator[](const key_type & x)
+			{
+				size_type idx = __lower_index(x);
+
+				if (!__found(idx, x))
+					__emplace_at(idx, x, mapped_type());
+				return __values.data()[idx];
+			}
+
+# if FT_CXX11
+			mapped_type & operator[](key_type && x)
+			{
+				size_type idx = __lower_index(x);
+
+				if (!__found(idx, x))
+					__emplace_at(idx, std::move(x));
+				return __values.data()[idx];
+			}
+# endif
+
+			/* if no such element exists, an exception of type std::out_of_range is thrown */
+			mapped_type & at(const key_type & key)
+			{
+				size_type idx = __lower_index(key);
+
+				if (!__found(idx, key))
+					throw std::out_of_range("no such element");
+				return __values.data()[idx];
+			}
+
+			const mapped_type & at(const key_type & key) const
+			{
+				size_type idx = __lower_index(key);
+
+				if (!__found(idx, key))
+					throw std::out_of_range("no such element");
+				return __values.data()[idx];
+			}
+
+			/* modifiers ----------------------------------------------------- */
+			ft::pair<iterator, bool> insert(const value_type & x)
+			{
+				size_type idx = __lower_index(x.first);
+
+				if (__found(idx, x.first))
+					return ft::make_pair(begin() + idx, false);
+				__emplace_at(idx, x.first, x.second);
+				return ft::make_pair(begin() + idx, true);
+			}
+
+			/* a correct hint saves the binary search */
+			iterator insert(const_iterator position, const value_type & x)
+			{
+				size_type idx = __hint_index(position, x.first);
+
+				if (!__found(idx, x.first))
+					__emplace_at(idx, x.first, x.second);
+				return begin() + idx;
+			}
+
+			/* sorts the batch and merges it in one pass, see __insert_batch */
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				__insert_batch(first, last);
+			}
+
+# if FT_CXX11
+			ft::pair<iterator, bool> insert(value_type && x)
+			{
+				return try_emplace(std::move(x.first), std::move(x.second));
+			}
+
+			iterator insert(const_iterator position, value_type && x)
+			{
+				return try_emplace(position, std::move(x.first), std::move(x.second));
+			}
+
+			/* the key has to be known before the search, so the pair is built first */
+			template <class... Args>
+			ft::pair<iterator, bool> emplace(Args &&... args)
+			{
+				value_type tmp(std::forward<Args>(args)...);
+
+				return insert(std::move(tmp));
+			}
+
+			template <class... Args>
+			iterator emplace_hint(const_iterator position, Args &&... args)
+			{
+				value_type tmp(std::forward<Args>(args)...);
+
+				return insert(position, std::move(tmp));
+			}
+
+			template <class... Args>
+			ft::pair<iterator, bool> try_emplace(const key_type & k, Args &&... args)
+			{
+				size_type idx = __lower_index(k);
+
+				if (__found(idx, k))
+					return ft::make_pair(begin() + idx, false);
+				__emplace_at(idx, k, std::forward<Args>(args)...);
+				return ft::make_pair(begin() + idx, true);
+			}
+
+			template <class... Args>
+			ft::pair<iterator, bool> try_emplace(key_type && k, Args &&... args)
+			{
+				size_type idx = __lower_index(k);
+
+				if (__found(idx, k))
+					return ft::make_pair(begin() + idx, false);
+				__emplace_at(idx, std::move(k), std::forward<Args>(args)...);
+				return ft::make_pair(begin() + idx, true);
+			}
+
+			template <class... Args>
+			iterator try_emplace(const_iterator hint, const key_type & k, Args &&... args)
+			{
+				size_type idx = __hint_index(hint, k);
+
+				if (!__found(idx, k))
+					__emplace_at(idx, k, std::forward<Args>(args)...);
+				return begin() + idx;
+			}
+
+			template <class... Args>
+			iterator try_emplace(const_iterator hint, key_type && k, Args &&... args)
+			{
+				size_type idx = __hint_index(hint, k);
+
+				if (!__found(idx, k))
+					__emplace_at(idx, std::move(k), std::forward<Args>(args)...);
+				return begin() + idx;
+			}
+
+			template <class M>
+			ft::pair<iterator, bool> insert_or_assign(const key_type & k, M && obj)
+			{
+				ft::pair<iterator, bool> res = try_emplace(k, std::forward<M>(obj));
+
+				if (!res.second)
+					res.first->second = std::forward<M>(obj);
+				return res;
+			}
+
+			template <class M>
+			ft::pair<iterator, bool> insert_or_assign(key_type && k, M && obj)
+			{
+				ft::pair<iterator, bool> res = try_emplace(std::move(k), std::forward<M>(obj));
+
+				if (!res.second)
+					res.first->second = std::forward<M>(obj);
+				return res;
+			}
+
+			template <class M>
+			iterator insert_or_assign(const_iterator hint, const key_type & k, M && obj)
+			{
+				size_type idx = __hint_index(hint, k);
+
+				if (__found(idx, k))
+					__values.data()[idx] = std::forward<M>(obj);
+				else
+					__emplace_at(idx, k, std::forward<M>(obj));
+				return begin() + idx;
+			}
+
+			template <class M>
+			iterator insert_or_assign(const_iterator hint, key_type && k, M && obj)
+			{
+				size_type idx = __hint_index(hint, k);
+
+				if (__found(idx, k))
+					__values.data()[idx] = std::forward<M>(obj);
+				else
+					__emplace_at(idx, std::move(k), std::forward<M>(obj));
+				return begin() + idx;
+			}
+# else
+			template <class M>
+			ft::pair<iterator, bool> insert_or_assign(const key_type & k, const M & obj)
+			{
+				size_type idx = __lower_index(k);
+
+				if (__found(idx, k))
+				{
+					__values.data()[idx] = obj;
+					return ft::make_pair(begin() + idx, false);
+				}
+				__emplace_at(idx, k, obj);
+				return ft::make_pair(begin() + idx, true);
+			}
+
+			template <class M>
+			iterator insert_or_assign(const_iterator hint, const key_type & k, const M & obj)
+			{
+				size_type idx = __hint_index(hint, k);
+
+				if (__found(idx, k))
+					__values.data()[idx] = obj;
+				else
+					__emplace_at(idx, k, obj);
+				return begin() + idx;
+			}
+# endif
+
+			void erase(iterator pos)
+			{
+				size_type idx = pos - begin();
+
+				__keys.erase(__keys.begin() + idx);
+				__values.erase(__values.begin() + idx);
+			}
+
+			size_type erase(const key_type & x)
+			{
+				size_type idx = __lower_index(x);
+
+				if (!__found(idx, x))
+					return 0;
+				__keys.erase(__keys.begin() + idx);
+				__values.erase(__values.begin() + idx);
+				return 1;
+			}
+
+			void erase(iterator first, iterator last)
+			{
+				size_type from = first - begin();
+				size_type to = last - begin();
+
+				__keys.erase(__keys.begin() + from, __keys.begin() + to);
+				__values.erase(__values.begin() + from, __values.begin() + to);
+			}
+
+			void swap(flat_map & rhs)
+			{
+				__keys.swap(rhs.__keys);
+				__values.swap(rhs.__values);
+				std::swap(__alloc, rhs.__alloc);
+				std::swap(__comp, rhs.__comp);
+			}
+
+			void clear()
+			{
+				__keys.clear();
+				__values.clear();
+			}
+
+			/* observers ----------------------------------------------------- */
+			key_compare key_comp() const
+			{
+				return __comp;
+			}
+
+			value_compare value_comp() const
+			{
+				return value_compare(__comp);
+			}
+
+			/* map operations ------------------------------------------------ */
+			iterator find(const key_type & x)
+			{
+				return __find(x);
+			}
+			const_iterator find(const key_type & x) const
+			{
+				return __find(x);
+			}
+			size_type count(const key_type & x) const
+			{
+				return __found(__lower_index(x), x);
+			}
+			iterator lower_bound(const key_type & x)
+			{
+				return begin() + __lower_index(x);
+			}
+			const_iterator lower_bound(const key_type & x) const
+			{
+				return begin() + __lower_index(x);
+			}
+			iterator upper_bound(const key_type & x)
+			{
+				return begin() + __upper_index(x);
+			}
+			const_iterator upper_bound(const key_type & x) const
+			{
+				return begin() + __upper_index(x);
+			}
+			ft::pair<iterator, iterator> equal_range(const key_type & x)
+			{
+				size_type idx = __lower_index(x);
+
+				return ft::make_pair(begin() + idx, begin() + idx + __found(idx, x));
+			}
+			ft::pair<const_iterator, const_iterator> equal_range(const key_type & x) const
+			{
+				size_type idx = __lower_index(x);
+
+				return ft::make_pair(begin() + idx, begin() + idx + __found(idx, x));
+			}
+
+			/* heterogeneous lookup, only with a transparent key_compare ----- */
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			find(const K & x)
+			{
+				return __find(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, const_iterator>::type
+			find(const K & x) const
+			{
+				return __find(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, size_type>::type
+			count(const K & x) const
+			{
+				return __upper_index(x) - __lower_index(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			lower_bound(const K & x)
+			{
+				return begin() + __lower_index(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, const_iterator>::type
+			lower_bound(const K & x) const
+			{
+				return begin() + __lower_index(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			upper_bound(const K & x)
+			{
+				return begin() + __upper_index(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, const_iterator>::type
+			upper_bound(const K & x) const
+			{
+				return begin() + __upper_index(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, ft::pair<iterator, iterator> >::type
+			equal_range(const K & x)
+			{
+				return ft::make_pair(begin() + __lower_index(x), begin() + __upper_index(x));
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value,
+								ft::pair<const_iterator, const_iterator> >::type
+			equal_range(const K & x) const
+			{
+				return ft::make_pair(begin() + __lower_index(x), begin() + __upper_index(x));
+			}
+
+		private :
+			/* orders batch positions by the key they point to */
+			struct __index_less
+			{
+				const key_type 	*keys;
+				key_compare		comp;
+
+				__index_less(const key_type * k, const key_compare & c)
+				: keys(k), comp(c)
+				{}
+				bool operator()(size_type a, size_type b) const
+				{
+					return comp(keys[a], keys[b]);
+				}
+			};
+
+			allocator_type 			__alloc;
+			key_compare				__comp;
+			key_container_type		__keys;
+			mapped_container_type	__values;
+
+			template <class K>
+			size_type __lower_index(const K & x) const
+			{
+				return branchless_lower_bound(__keys.data(), __keys.size(), x, __comp) - __keys.data();
+			}
+
+			template <class K>
+			size_type __upper_index(const K & x) const
+			{
+				return branchless_upper_bound(__keys.data(), __keys.size(), x, __comp) - __keys.data();
+			}
+
+			/* idx is the lower bound of x */
+			template <class K>
+			bool __found(size_type idx, const K & x) const
+			{
+				return idx != __keys.size() && !__comp(x, __keys.data()[idx]);
+			}
+
+			template <class K>
+			iterator __find(const K & x)
+			{
+				size_type idx = __lower_index(x);
+
+				return __found(idx, x) ? begin() + idx : end();
+			}
+
+			template <class K>
+			const_iterator __find(const K & x) const
+			{
+				size_type idx = __lower_index(x);
+
+				return __found(idx, x) ? begin() + idx : end();
+			}
+
+			/* the lower bound of x, taken from the hint when it is the right slot */
+			size_type __hint_index(const_iterator hint, const key_type & x) const
+			{
+				size_type 		idx = hint - begin();
+				const key_type	*k = __keys.data();
+
+				if ((idx == 0 || __comp(k[idx - 1], x)) && (idx == size() || __comp(x, k[idx])))
+					return idx;
+				return __lower_index(x);
+			}
+
+			/* both arrays grow together: a failed mapped insert takes the key back */
+# if FT_CXX11
+			template <class K, class... Args>
+			void __emplace_at(size_type idx, K && k, Args &&... args)
+			{
+				__keys.emplace(__keys.begin() + idx, std::forward<K>(k));
+				try
+				{
+					__values.emplace(__values.begin() + idx, std::forward<Args>(args)...);
+				}
+				catch (...)
+				{
+					__keys.erase(__keys.begin() + idx);
+					throw;
+				}
+			}
+# else
+			void __emplace_at(size_type idx, const key_type & k, const mapped_type & m)
+			{
+				__keys.insert(__keys.begin() + idx, k);
+				try
+				{
+					__values.insert(__values.begin() + idx, m);
+				}
+				catch (...)
+				{
+					__keys.erase(__keys.begin() + idx);
+					throw;
+				}
+			}
+# endif
+
+			void __push_back(const key_type & k, const mapped_type & m)
+			{
+				__keys.push_back(k);
+				try
+				{
+					__values.push_back(m);
+				}
+				catch (...)
+				{
+					__keys.pop_back();
+					throw;
+				}
+			}
+
+			/* appends p if it goes last, returns false if it belongs further in */
+			template <class P>
+			bool __append_sorted(const P & p)
+			{
+				if (__keys.empty() || __comp(__keys.back(), p.first))
+					__push_back(p.first, p.second);
+				else if (__comp(p.first, __keys.back()))
+					return false;
+				return true;
+			}
+
+			template <class P>
+			static void __push_pair(key_container_type & k, mapped_container_type & m, const P & p)
+			{
+				k.push_back(p.first);
+				m.push_back(p.second);
+			}
+
+			/*
+				Range insert. The batch is copied out, its positions are stable
+				sorted by key (skipped when already sorted), so the first of
+				equal keys wins as with repeated insert(). A batch that goes
+				after every key is appended in place; otherwise both sequences
+				are merged into new arrays, where each run of old elements is
+				located by a binary search and moved as a block. If an element
+				operation throws during the merge the map is left empty, like
+				std::flat_map
+			*/
+			template <class InputIt>
+			void __insert_batch(InputIt first, InputIt last)
+			{
+				key_container_type		bk;
+				mapped_container_type	bv;
+				ft::vector<size_type>	order;
+				size_type				m;
+				size_type				*ord;
+				bool					sorted = true;
+
+				for (; first != last; ++first)
+					__push_pair(bk, bv, *first);
+				m = bk.size();
+				if (m == 0)
+					return;
+				order.reserve(m);
+				for (size_type i = 0; i < m; ++i)
+				{
+					order.push_back(i);
+					if (i && sorted && __comp(bk.data()[i], bk.data()[i - 1]))
+						sorted = false;
+				}
+				ord = order.data();
+				if (!sorted)
+					std::stable_sort(ord, ord + m, __index_less(bk.data(), __comp));
+
+				if (__keys.empty() || __comp(__keys.back(), bk.data()[ord[0]]))
+				{
+					reserve(size() + m);
+					for (size_type j = 0; j < m; ++j)
+						if (__keys.empty() || __comp(__keys.back(), bk.data()[ord[j]]))
+							__push_back(bk.data()[ord[j]], bv.data()[ord[j]]);
+					return;
+				}
+				try
+				{
+					__merge(bk, bv, ord, m);
+				}
+				catch (...)
+				{
+					clear();
+					throw;
+				}
+			}
+
+			void __merge(key_container_type & bk, mapped_container_type & bv,
+						const size_type * ord, size_type m)
+			{
+				key_container_type		keys((key_allocator_type(__alloc)));
+				mapped_container_type	vals((mapped_allocator_type(__alloc)));
+				key_type				*ok = __keys.data();
+				mapped_type				*ov = __values.data();
+				size_type				n = __keys.size();
+				size_type				i = 0;
+				size_type				stop;
+
+				keys.reserve(n + m);
+				vals.reserve(n + m);
+				for (size_type j = 0; j < m; ++j)
+				{
+					key_type &k = bk.data()[ord[j]];
+
+					stop = branchless_lower_bound(ok + i, n - i, k, __comp) - ok;
+					for (; i < stop; ++i)
+					{
+						keys.push_back(FT_MOVE(ok[i]));
+						vals.push_back(FT_MOVE(ov[i]));
+					}
+					if ((i < n && !__comp(k, ok[i])) || (!keys.empty() && !__comp(keys.back(), k)))
+						continue;
+					keys.push_back(FT_MOVE(k));
+					vals.push_back(FT_MOVE(bv.data()[ord[j]]));
+				}
+				for (; i < n; ++i)
+				{
+					keys.push_back(FT_MOVE(ok[i]));
+					vals.push_back(FT_MOVE(ov[i]));
+				}
+				__keys.swap(keys);
+				__values.swap(vals);
+			}
+	};
+
+	template <class Key, class T, class Compare, class Allocator>
+	bool operator==(const flat_map<Key, T, Compare, Allocator> & x,
+					const flat_map<Key, T, Compare, Allocator> & y)
+	{
+		return x.keys() == y.keys() && x.values() == y.values();
+	}
+
+	template <class Key, class T, class Compare, class Allocator>
+	bool operator!=(const flat_map<Key, T, Compare, Allocator> & x,
+					const flat_map<Key, T, Compare, Allocator> & y)
+	{
+		return !(x == y);
+	}
+
+	template <class Key, class T, class Compare, class Allocator>
+	bool operator<(	const flat_map<Key, T, Compare, Allocator> & x,
+					const flat_map<Key, T, Compare, Allocator> & y)
+	{
+		return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+
+	template <class Key, class T, class Compare, class Allocator>
+	bool operator>(	const flat_map<Key, T, Compare, Allocator> & x,
+					const flat_map<Key, T, Compare, Allocator> & y)
+	{
+		return y < x;
+	}
+
+	template <class Key, class T, class Compare, class Allocator>
+	bool operator>=(const flat_map<Key, T, Compare, Allocator> & x,
+					const flat_map<Key, T, Compare, Allocator> & y)
+	{
+		return !(x < y);
+	}
+
+	template <class Key, class T, class Compare, class Allocator>
+	bool operator<=(const flat_map<Key, T, Compare, Allocator> & x,
+					const flat_map<Key, T, Compare, Allocator> & y)
+	{
+		return !(y < x);
+	}
+
+	template <class Key, class T, class Compare, class Allocator>
+	void swap(	ft::flat_map<Key, T, Compare, Allocator> & lhs,
+				ft::flat_map<Key, T, Compare, Allocator> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -0,0 +1,509 @@
+#ifndef 	FLAT_SET_HPP
+# define 	FLAT_SET_HPP
+
+# include <memory>
+# include <functional>
+# include <algorithm>
+# include "vector.hpp"
+# include "../utils/utils.hpp"
+# include "../utils/enable_if.hpp"
+# include "../utils/flat_search.hpp"
+
+namespace ft
+{
+	/*
+		ft::set interface over one sorted ft::vector, see flat_map.hpp. Keys
+		cannot be modified in place, iterator and const_iterator are the same
+		read-only type
+	*/
+	template <class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key> >
+	class flat_set
+	{
+		public :
+			/* typedefs ---------------------------------------------------------- */
+			typedef Key 													key_type;
+			typedef Key 													value_type;
+			typedef std::size_t												size_type;
+			typedef std::ptrdiff_t											difference_type;
+			typedef Compare													key_compare;
+			typedef Compare													value_compare;
+			typedef Allocator												allocator_type;
+			typedef value_type & 											reference;
+			typedef const value_type & 										const_reference;
+			typedef typename Allocator::pointer 							pointer;
+			typedef typename Allocator::const_pointer						const_pointer;
+			typedef ft::vector<Key, Allocator>								container_type;
+			/* iterators --------------------------------------------------------- */
+			typedef random_access_it<const Key>								iterator;
+			typedef random_access_it<const Key>								const_iterator;
+			typedef v_reverse_iter<iterator>								reverse_iterator;
+			typedef v_reverse_iter<const_iterator>							const_reverse_iterator;
+
+			/* constructors ------------------------------------------------------ */
+			flat_set()
+			:	__comp(key_compare()),
+				__keys()
+			{}
+
+			explicit flat_set(	const key_compare & comp,
+								const allocator_type & alloc = allocator_type())
+			:	__comp(comp),
+				__keys(alloc)
+			{}
+
+			template <class InputIt>
+			flat_set(InputIt first, InputIt last, const key_compare & comp = key_compare(),
+											 const allocator_type & alloc = allocator_type())
+			:	__comp(comp),
+				__keys(alloc)
+			{
+				__insert_batch(first, last);
+			}
+
+			/* [first, last) is sorted by comp; appended without a sort or a merge */
+			template <class InputIt>
+			flat_set(from_sorted_t, InputIt first, InputIt last, const key_compare & comp = key_compare(),
+											 const allocator_type & alloc = allocator_type())
+			:	__comp(comp),
+				__keys(alloc)
+			{
+				for (; first != last; ++first)
+				{
+					if (__keys.empty() || __comp(__keys.back(), *first))
+						__keys.push_back(*first);
+					else if (__comp(*first, __keys.back()))
+					{
+						__insert_batch(first, last);
+						return;
+					}
+				}
+			}
+
+			flat_set(const flat_set & other)
+			:	__comp(other.__comp),
+				__keys(other.__keys)
+			{}
+
+			flat_set & operator=(const flat_set & other)
+			{
+				if (this != &other)
+				{
+					__keys = other.__keys;
+					__comp = other.__comp;
+				}
+				return *this;
+			}
+
+# if FT_CXX11
+			flat_set(flat_set && other)
+			:	__comp(other.__comp),
+				__keys(std::move(other.__keys))
+			{}
+
+			flat_set & operator=(flat_set && other)
+			{
+				if (this != &other)
+				{
+					__keys = std::move(other.__keys);
+					__comp = other.__comp;
+				}
+				return *this;
+			}
+# endif
+
+			~flat_set() {}
+
+			allocator_type get_allocator() const
+			{
+				return __keys.get_allocator();
+			}
+
+			/* counters of the key vector, zero unless built with FT_STATS (see stats.hpp) */
+			container_stats stats() const
+			{
+				return __keys.stats();
+			}
+
+			/* iterators --------------------------------------------------------- */
+			iterator begin() const
+			{
+				return iterator(__keys.data());
+			}
+			iterator end() const
+			{
+				return iterator(__keys.data() + __keys.size());
+			}
+			reverse_iterator rbegin() const
+			{
+				return reverse_iterator(end());
+			}
+			reverse_iterator rend() const
+			{
+				return reverse_iterator(begin());
+			}
+
+			/* capacity ---------------------------------------------------------- */
+			bool empty() const
+			{
+				return __keys.empty();
+			}
+			size_type size() const
+			{
+				return __keys.size();
+			}
+			size_type max_size() const
+			{
+				return __keys.max_size();
+			}
+			void reserve(size_type n)
+			{
+				__keys.reserve(n);
+			}
+			size_type capacity() const
+			{
+				return __keys.capacity();
+			}
+
+			/* the underlying sorted array */
+			const container_type & keys() const
+			{
+				return __keys;
+			}
+
+			/* modifiers --------------------------------------------------------- */
+			ft::pair<iterator, bool> insert(const value_type & value)
+			{
+				size_type idx = __lower_index(value);
+
+				if (__found(idx, value))
+					return ft::make_pair(begin() + idx, false);
+				__keys.insert(__keys.begin() + idx, value);
+				return ft::make_pair(begin() + idx, true);
+			}
+
+			/* a correct hint saves the binary search */
+			iterator insert(const_iterator hint, const value_type & value)
+			{
+				size_type idx = __hint_index(hint, value);
+
+				if (!__found(idx, value))
+					__keys.insert(__keys.begin() + idx, value);
+				return begin() + idx;
+			}
+
+			/* sorts the batch and merges it in one pass, see flat_map */
+			template <class InputIt>
+			void insert(InputIt first, InputIt last)
+			{
+				__insert_batch(first, last);
+			}
+
+# if FT_CXX11
+			ft::pair<iterator, bool> insert(value_type && value)
+			{
+				size_type idx = __lower_index(value);
+
+				if (__found(idx, value))
+					return ft::make_pair(begin() + idx, false);
+				__keys.insert(__keys.begin() + idx, std::move(value));
+				return ft::make_pair(begin() + idx, true);
+			}
+
+			iterator insert(const_iterator hint, value_type && value)
+			{
+				size_type idx = __hint_index(hint, value);
+
+				if (!__found(idx, value))
+					__keys.insert(__keys.begin() + idx, std::move(value));
+				return begin() + idx;
+			}
+
+			/* the key has to be known before the search, so it is built first */
+			template <class... Args>
+			ft::pair<iterator, bool> emplace(Args &&... args)
+			{
+				return insert(value_type(std::forward<Args>(args)...));
+			}
+
+			template <class... Args>
+			iterator emplace_hint(const_iterator hint, Args &&... args)
+			{
+				return insert(hint, value_type(std::forward<Args>(args)...));
+			}
+# endif
+
+			void erase(iterator pos)
+			{
+				__keys.erase(__keys.begin() + (pos - begin()));
+			}
+
+			size_type erase(const key_type & x)
+			{
+				size_type idx = __lower_index(x);
+
+				if (!__found(idx, x))
+					return 0;
+				__keys.erase(__keys.begin() + idx);
+				return 1;
+			}
+
+			void erase(iterator first, iterator last)
+			{
+				__keys.erase(__keys.begin() + (first - begin()), __keys.begin() + (last - begin()));
+			}
+
+			void swap(flat_set & other)
+			{
+				__keys.swap(other.__keys);
+				std::swap(__comp, other.__comp);
+			}
+
+			void clear()
+			{
+				__keys.clear();
+			}
+
+			/* observers --------------------------------------------------------- */
+			key_compare key_comp() const
+			{
+				return __comp;
+			}
+			value_compare value_comp() const
+			{
+				return __comp;
+			}
+
+			/* set operations ---------------------------------------------------- */
+			iterator find(const key_type & x) const
+			{
+				return __find(x);
+			}
+			size_type count(const key_type & x) const
+			{
+				return __found(__lower_index(x), x);
+			}
+			iterator lower_bound(const key_type & x) const
+			{
+				return begin() + __lower_index(x);
+			}
+			iterator upper_bound(const key_type & x) const
+			{
+				return begin() + __upper_index(x);
+			}
+			ft::pair<iterator, iterator> equal_range(const key_type & x) const
+			{
+				size_type idx = __lower_index(x);
+
+				return ft::make_pair(begin() + idx, begin() + idx + __found(idx, x));
+			}
+
+			/* heterogeneous lookup, only with a transparent key_compare --------- */
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			find(const K & x) const
+			{
+				return __find(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, size_type>::type
+			count(const K & x) const
+			{
+				return __upper_index(x) - __lower_index(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			lower_bound(const K & x) const
+			{
+				return begin() + __lower_index(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			upper_bound(const K & x) const
+			{
+				return begin() + __upper_index(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, ft::pair<iterator, iterator> >::type
+			equal_range(const K & x) const
+			{
+				return ft::make_pair(begin() + __lower_index(x), begin() + __upper_index(x));
+			}
+
+		private :
+			/* orders batch positions by the key they point to */
+			struct __index_less
+			{
+				const key_type 	*keys;
+				key_compare		comp;
+
+				__index_less(const key_type * k, const key_compare & c)
+				: keys(k), comp(c)
+				{}
+				bool operator()(size_type a, size_type b) const
+				{
+					return comp(keys[a], keys[b]);
+				}
+			};
+
+			key_compare			__comp;
+			container_type		__keys;
+
+			template <class K>
+			size_type __lower_index(const K & x) const
+			{
+				return branchless_lower_bound(__keys.data(), __keys.size(), x, __comp) - __keys.data();
+			}
+
+			template <class K>
+			size_type __upper_index(const K & x) const
+			{
+				return branchless_upper_bound(__keys.data(), __keys.size(), x, __comp) - __keys.data();
+			}
+
+			/* idx is the lower bound of x */
+			template <class K>
+			bool __found(size_type idx, const K & x) const
+			{
+				return idx != __keys.size() && !__comp(x, __keys.data()[idx]);
+			}
+
+			template <class K>
+			iterator __find(const K & x) const
+			{
+				size_type idx = __lower_index(x);
+
+				return __found(idx, x) ? begin() + idx : end();
+			}
+
+			size_type __hint_index(const_iterator hint, const key_type & x) const
+			{
+				size_type 		idx = hint - begin();
+				const key_type	*k = __keys.data();
+
+				if ((idx == 0 || __comp(k[idx - 1], x)) && (idx == size() || __comp(x, k[idx])))
+					return idx;
+				return __lower_index(x);
+			}
+
+			/* same algorithm as flat_map::__insert_batch */
+			template <class InputIt>
+			void __insert_batch(InputIt first, InputIt last)
+			{
+				container_type			batch;
+				ft::vector<size_type>	order;
+				size_type				m;
+				size_type				*ord;
+				bool					sorted = true;
+
+				for (; first != last; ++first)
+					batch.push_back(*first);
+				m = batch.size();
+				if (m == 0)
+					return;
+				order.reserve(m);
+				for (size_type i = 0; i < m; ++i)
+				{
+					order.push_back(i);
+					if (i && sorted && __comp(batch.data()[i], batch.data()[i - 1]))
+						sorted = false;
+				}
+				ord = order.data();
+				if (!sorted)
+					std::stable_sort(ord, ord + m, __index_less(batch.data(), __comp));
+
+				if (__keys.empty() || __comp(__keys.back(), batch.data()[ord[0]]))
+				{
+					__keys.reserve(size() + m);
+					for (size_type j = 0; j < m; ++j)
+						if (__keys.empty() || __comp(__keys.back(), batch.data()[ord[j]]))
+							__keys.push_back(FT_MOVE(batch.data()[ord[j]]));
+					return;
+				}
+				try
+				{
+					__merge(batch, ord, m);
+				}
+				catch (...)
+				{
+					clear();
+					throw;
+				}
+			}
+
+			void __merge(container_type & batch, const size_type * ord, size_type m)
+			{
+				container_type	keys(__keys.get_allocator());
+				key_type		*ok = __keys.data();
+				size_type		n = __keys.size();
+				size_type		i = 0;
+				size_type		stop;
+
+				keys.reserve(n + m);
+				for (size_type j = 0; j < m; ++j)
+				{
+					key_type &k = batch.data()[ord[j]];
+
+					stop = branchless_lower_bound(ok + i, n - i, k, __comp) - ok;
+					for (; i < stop; ++i)
+						keys.push_back(FT_MOVE(ok[i]));
+					if ((i < n && !__comp(k, ok[i])) || (!keys.empty() && !__comp(keys.back(), k)))
+						continue;
+					keys.push_back(FT_MOVE(k));
+				}
+				for (; i < n; ++i)
+					keys.push_back(FT_MOVE(ok[i]));
+				__keys.swap(keys);
+			}
+	};
+
+	template <class Key, class Compare, class Allocator>
+	bool operator==(const flat_set<Key, Compare, Allocator> & lhs,
+					const flat_set<Key, Compare, Allocator> & rhs)
+	{
+		return lhs.keys() == rhs.keys();
+	}
+
+	template <class Key, class Compare, class Allocator>
+	bool operator!=(const flat_set<Key, Compare, Allocator> & lhs,
+					const flat_set<Key, Compare, Allocator> & rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class Key, class Compare, class Allocator>
+	bool operator<(	const flat_set<Key, Compare, Allocator> & lhs,
+					const flat_set<Key, Compare, Allocator> & rhs)
+	{
+		return lhs.keys() < rhs.keys();
+	}
+
+	template <class Key, class Compare, class Allocator>
+	bool operator>(	const flat_set<Key, Compare, Allocator> & lhs,
+					const flat_set<Key, Compare, Allocator> & rhs)
+	{
+		return rhs < lhs;
+	}
+
+	template <class Key, class Compare, class Allocator>
+	bool operator<=(const flat_set<Key, Compare, Allocator> & lhs,
+					const flat_set<Key, Compare, Allocator> & rhs)
+	{
+		return !(rhs < lhs);
+	}
+
+	template <class Key, class Compare, class Allocator>
+	bool operator>=(const flat_set<Key, Compare, Allocator> & lhs,
+					const flat_set<Key, Compare, Allocator> & rhs)
+	{
+		return !(lhs < rhs);
+	}
+
+	template <class Key, class Compare, class Allocator>
+	void swap(	ft::flat_set<Key, Compare, Allocator> & lhs,
+				ft::flat_set<Key, Compare, Allocator> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -5,12 +5,19 @@
 # include <functional>
 # include <algorithm>
 # include "../utils/utils.hpp"
-# include "../utils/tree.hpp"
+# include "../utils/enable_if.hpp"
+# include "../utils/functional.hpp"
+# include "../utils/tree_select.hpp"
 
 namespace ft
 {
+	/*
+		Policy picks the tree: ft::no_augment, ft::order_statistics to enable
+		nth and rank, or ft::btree_nodes<N> for a B+ tree (see btree.hpp)
+	*/
 	template <class Key, class T, class Compare = std::less<Key>,
-                       class Allocator = std::allocator<ft::pair<const Key, T> > >
+                       class Allocator = std::allocator<ft::pair<const Key, T> >,
+					   class Policy = ft::no_augment >
 	class map
 	{
 		public :
@@ -41,22 +48,24 @@ namespace ft
 					} 
 			};
 
-			typedef rbtree<value_type, value_compare, allocator_type>	rbtree;
+			/* the tree orders values by key, lookups never build a value_type */
+			typedef typename select_tree<Policy, value_type, key_compare, allocator_type,
+										ft::select1st<value_type> >::type	tree_type;
 
 			/* iterators ----------------------------------------------------- */
-			typedef Node<value_type>									node;
-			typedef node *												node_pointer;
-			typedef const node *										const_node_pointer;
-			typedef tree_iter<node_pointer, value_pointer>				iterator;
-			typedef tree_iter<node_pointer, const_value_pointer>		const_iterator;
+			typedef typename tree_type::iterator						iterator;
+			typedef typename tree_type::const_iterator					const_iterator;
 			typedef reverse_iter<iterator>								reverse_iterator;
 			typedef reverse_iter<const_iterator>						const_reverse_iterator;
+			/* node handles ------------------------------------------------- */
+			typedef typename select_node_handle<Policy, map_node_handle<tree_type> >::type	node_type;
+			typedef node_insert_return<iterator, node_type>				insert_return_type;
 
 			/* constructors ---------------------------------------------------*/
 			map()
 			:	__alloc(allocator_type()),
 				__comp(key_compare()),
-				__tree(__comp, __alloc)
+				__tree(key_compare(), __alloc)
 			{}
 
 			explicit map(const key_compare & comp, const allocator_type& alloc = allocator_type())
@@ -75,6 +84,21 @@ namespace ft
 				__tree.insert(first, last);
 			}
 
+			/* 
+				precondition, not checked: [first, last) is strictly increasing 
+				by comp (sorted, no equal keys). The tree is then built in 
+				linear time without comparing keys 
+			*/
+			template <class InputIt>
+			map(from_sorted_t, InputIt first, InputIt last, const key_compare& comp = key_compare(),
+												const allocator_type& alloc = allocator_type())
+			: 	__alloc(alloc),
+				__comp(comp),
+				__tree(comp, alloc)
+			{
+				__tree.build_sorted(first, last);
+			}
+
         	map(const map & rhs)
 			: 	__alloc(rhs.__alloc),
 				__comp(rhs.__comp),
@@ -92,6 +116,25 @@ namespace ft
 				return *this;
 			}
 
+# if FT_CXX11
+			map(map && rhs)
+			: 	__alloc(rhs.__alloc),
+				__comp(rhs.__comp),
+				__tree(std::move(rhs.__tree))
+			{}
+
+			map & operator=(map && rhs)
+			{
+				if (this != &rhs)
+				{
+					__tree = std::move(rhs.__tree);
+					__comp = rhs.__comp;
+					__alloc = rhs.__alloc;
+				}
+				return *this;
+			}
+# endif
+
        		~map() {};
 
 			allocator_type get_allocator() const
@@ -99,6 +142,12 @@ namespace ft
 				return __alloc;
 			}
 
+			/* counters of the underlying tree, zero unless built with FT_STATS (see stats.hpp) */
+			container_stats stats() const
+			{
+				return __tree.stats();
+			}
+
 			/* iterators ----------------------------------------------------- */
 			iterator begin()
 			{
@@ -148,13 +197,23 @@ namespace ft
 			}
 
 			/* element access ------------------------------------------------ */
+# if FT_CXX11
+			mapped_type & operator[](const key_type & x)
+			{
+				return this->try_emplace(x).first->second;
+			}
+
+			mapped_type & operator[](key_type && x)
+			{
+				return this->try_emplace(std::move(x)).first->second;
+			}
+# else
+			/* one descent, mapped_type() is only built for a missing key */
 			mapped_type & operator[](const key_type & x)
 			{
-				iterator found = this->find(x);
-				if (found != this->end())
-					return found->second;
-				return this->insert(ft::make_pair(x, mapped_type())).first->second; /* if the key does not exist */
+				return __tree.find_or_insert(x, __make_default(x)).first->second;
 			}
+# endif
 
 			/* if no such element exists, an exception of type std::out_of_range is thrown */
 			mapped_type & at(const key_type & key)
@@ -191,6 +250,132 @@ namespace ft
 				__tree.insert(first, last);
 			}
 
+			/* inserts (k, obj), or assigns obj to the mapped value of k */
+# if FT_CXX11
+			template <class M>
+			ft::pair<iterator, bool> insert_or_assign(const key_type & k, M && obj)
+			{
+				ft::pair<iterator, bool> res = __tree.find_or_emplace(k, ft::piecewise_construct, 
+																k, std::forward<M>(obj));
+				if (!res.second)
+					res.first->second = std::forward<M>(obj);
+				return res;
+			}
+
+			template <class M>
+			ft::pair<iterator, bool> insert_or_assign(key_type && k, M && obj)
+			{
+				ft::pair<iterator, bool> res = __tree.find_or_emplace(k, ft::piecewise_construct, 
+																std::move(k), std::forward<M>(obj));
+				if (!res.second)
+					res.first->second = std::forward<M>(obj);
+				return res;
+			}
+
+			template <class M>
+			iterator insert_or_assign(iterator hint, const key_type & k, M && obj)
+			{
+				ft::pair<iterator, bool> res = __tree.find_or_emplace_hint(hint, k, ft::piecewise_construct, 
+																k, std::forward<M>(obj));
+				if (!res.second)
+					res.first->second = std::forward<M>(obj);
+				return res.first;
+			}
+
+			template <class M>
+			iterator insert_or_assign(iterator hint, key_type && k, M && obj)
+			{
+				ft::pair<iterator, bool> res = __tree.find_or_emplace_hint(hint, k, ft::piecewise_construct, 
+																std::move(k), std::forward<M>(obj));
+				if (!res.second)
+					res.first->second = std::forward<M>(obj);
+				return res.first;
+			}
+# else
+			template <class M>
+			ft::pair<iterator, bool> insert_or_assign(const key_type & k, const M & obj)
+			{
+				ft::pair<iterator, bool> res = __tree.find_or_insert(k, __make_value<M>(k, obj));
+
+				if (!res.second)
+					res.first->second = obj;
+				return res;
+			}
+
+			template <class M>
+			iterator insert_or_assign(iterator hint, const key_type & k, const M & obj)
+			{
+				ft::pair<iterator, bool> res = __tree.find_or_insert_hint(hint, k, __make_value<M>(k, obj));
+
+				if (!res.second)
+					res.first->second = obj;
+				return res.first;
+			}
+# endif
+
+# if FT_CXX11
+			ft::pair<iterator, bool> insert(value_type && x)
+			{
+				return __tree.emplace(std::move(x));
+			}
+
+			/* anything value_type is constructible from, e.g. pair<Key, T> */
+			template <class P>
+			ft::pair<iterator, bool> insert(P && x)
+			{
+				return __tree.emplace(std::forward<P>(x));
+			}
+
+			iterator insert(iterator position, value_type && x)
+			{
+				return __tree.emplace_hint(position, std::move(x));
+			}
+
+			template <class... Args>
+			ft::pair<iterator, bool> emplace(Args &&... args)
+			{
+				return __tree.emplace(std::forward<Args>(args)...);
+			}
+
+			template <class... Args>
+			iterator emplace_hint(iterator position, Args &&... args)
+			{
+				return __tree.emplace_hint(position, std::forward<Args>(args)...);
+			}
+
+			/* 
+				does nothing, args included, when the key is already there; 
+				otherwise the mapped value is built in place from args 
+			*/
+			template <class... Args>
+			ft::pair<iterator, bool> try_emplace(const key_type & k, Args &&... args)
+			{
+				return __tree.find_or_emplace(k, ft::piecewise_construct, 
+											k, std::forward<Args>(args)...);
+			}
+
+			template <class... Args>
+			ft::pair<iterator, bool> try_emplace(key_type && k, Args &&... args)
+			{
+				return __tree.find_or_emplace(k, ft::piecewise_construct, 
+											std::move(k), std::forward<Args>(args)...);
+			}
+
+			template <class... Args>
+			iterator try_emplace(iterator hint, const key_type & k, Args &&... args)
+			{
+				return __tree.find_or_emplace_hint(hint, k, ft::piecewise_construct, 
+											k, std::forward<Args>(args)...).first;
+			}
+
+			template <class... Args>
+			iterator try_emplace(iterator hint, key_type && k, Args &&... args)
+			{
+				return __tree.find_or_emplace_hint(hint, k, ft::piecewise_construct, 
+											std::move(k), std::forward<Args>(args)...).first;
+			}
+# endif
+
 			void erase(iterator pos)
 			{
 				__tree.erase(pos);
@@ -198,7 +383,7 @@ namespace ft
 
 			size_type erase(const key_type & x)
 			{
-				return __tree.erase(ft::make_pair(x, mapped_type()));
+				return __tree.erase(x);
 			}
 
 			void erase(iterator first, iterator last)
@@ -206,13 +391,132 @@ namespace ft
 				__tree.erase(first, last);
 			}
 
-			void swap(map<Key, T, Compare, Allocator> & rhs)
+			void swap(map & rhs)
 			{
-				std::swap(this->__tree, rhs.__tree);
+				this->__tree.swap(rhs.__tree);
 				std::swap(this->__alloc, rhs.__alloc);
 				std::swap(this->__comp, rhs.__comp);
 			}
 
+			/* node handles, red-black trees only ---------------------------- */
+			/* unlinks an element, which stays in its node, see node_handle.hpp */
+			node_type extract(iterator position)
+			{
+				return node_type(__tree.extract(position), __tree, __alloc);
+			}
+			/* an empty handle when x is missing */
+			node_type extract(const key_type & x)
+			{
+				iterator position = this->find(x);
+
+				if (position == this->end())
+					return node_type();
+				return extract(position);
+			}
+			/* links the node of nh back, unless its key is taken: nh is then handed back in the result */
+			insert_return_type insert(node_type & nh)
+			{
+				insert_return_type			res;
+				ft::pair<iterator, bool>	found;
+
+				res.position = this->end();
+				res.inserted = false;
+				if (nh.empty())
+					return res;
+				__tree.share_pool(nh.group());
+				found = __tree.insert_node(nh.base());
+				res.position = found.first;
+				res.inserted = found.second;
+				if (found.second)
+					nh.release();
+				else
+					res.node = FT_MOVE(nh);
+				return res;
+			}
+			/* nh keeps its node when the key is taken */
+			iterator insert(iterator hint, node_type & nh)
+			{
+				iterator position;
+
+				if (nh.empty())
+					return this->end();
+				__tree.share_pool(nh.group());
+				position = __tree.insert_node(hint, nh.base());
+				if (position.base() == nh.base())
+					nh.release();
+				return position;
+			}
+# if FT_CXX11
+			insert_return_type insert(node_type && nh)
+			{
+				return insert(nh);
+			}
+			iterator insert(iterator hint, node_type && nh)
+			{
+				return insert(hint, nh);
+			}
+# endif
+
+			/* bulk operations, red-black trees only ------------------------- */
+			/* 
+				nodes are relinked, never copied, in O(log n) for join and 
+				O(m log(n / m + 1)) for the set operations, m <= n being the 
+				sizes. split_at is O(log n) with ft::order_statistics, which 
+				keeps the sizes of the two parts; otherwise it also walks the 
+				smaller part to count it, O(log n + min(k, n - k)). The allocators must compare equal and key_compare 
+				must not throw. With ft::parallel the work is spread over the 
+				hardware threads, key_compare must then be safe to call from 
+				several threads at once. The two containers then share their 
+				node pools: until one of them is cleared or destroyed, they 
+				must not be used from different threads at once
+			*/
+			/* moves in the elements of other whose key is missing here */
+			void merge(map & other)
+			{
+				__tree.merge(other.__tree);
+			}
+			void merge(map & other, parallel_t)
+			{
+				__tree.merge(other.__tree, tree_type::parallel_forks());
+			}
+			/* adds a copy of the elements of other whose key is missing here */
+			void set_union(const map & other)
+			{
+				__tree.unite(other.__tree);
+			}
+			void set_union(const map & other, parallel_t)
+			{
+				__tree.unite(other.__tree, tree_type::parallel_forks());
+			}
+			/* keeps the elements whose key is in other */
+			void set_intersection(const map & other)
+			{
+				__tree.intersect(other.__tree);
+			}
+			void set_intersection(const map & other, parallel_t)
+			{
+				__tree.intersect(other.__tree, tree_type::parallel_forks());
+			}
+			/* removes the elements whose key is in other */
+			void set_difference(const map & other)
+			{
+				__tree.subtract(other.__tree);
+			}
+			void set_difference(const map & other, parallel_t)
+			{
+				__tree.subtract(other.__tree, tree_type::parallel_forks());
+			}
+			/* appends greater, whose keys are all above the keys here */
+			void join(map & greater)
+			{
+				__tree.join(greater.__tree);
+			}
+			/* the elements whose key is not less than key move to greater */
+			void split_at(const key_type & key, map & greater)
+			{
+				__tree.split(key, greater.__tree);
+			}
+
 			void clear()
 			{
 				__tree.clear();
@@ -230,52 +534,158 @@ namespace ft
 			(key-value pairs) by using key_comp to compare the first components of the pairs */
 			value_compare value_comp() const
 			{
-				return this->value_comp(key_compare());
+				return value_compare(this->__comp);
 			}
 
 			/* map operations ------------------------------------------------ */
 			iterator find(const key_type & x)
 			{
-				iterator it = __tree.find(ft::make_pair(x, mapped_type()));
-				return it;
+				return __tree.find(x);
 			}
 			const_iterator find(const key_type & x) const
 			{
-				const_iterator it = __tree.find(ft::make_pair(x, mapped_type()));
-				return it;
+				return __tree.find(x);
 			}
 			size_type count(const key_type & x) const
 			{
-				return (find(x) == end()) ? 0 : 1;
+				return __tree.count(x);
 			}
 			iterator       lower_bound(const key_type & x)
 			{
-				return __tree.lower_bound(ft::make_pair(x, mapped_type()));
+				return __tree.lower_bound(x);
 			}
 			const_iterator lower_bound(const key_type & x) const
 			{
-				return __tree.lower_bound(ft::make_pair(x, mapped_type()));
+				return __tree.lower_bound(x);
 			}
 			iterator       upper_bound(const key_type & x)
 			{
-				return __tree.upper_bound(ft::make_pair(x, mapped_type()));
+				return __tree.upper_bound(x);
 			}
 			const_iterator upper_bound(const key_type & x) const
 			{
-				return __tree.upper_bound(ft::make_pair(x, mapped_type()));
+				return __tree.upper_bound(x);
 			}
 			ft::pair<iterator, iterator> equal_range(const key_type & key)
 			{
-				return __tree.equal_range(ft::make_pair(key, mapped_type()));
+				return __tree.equal_range(key);
 			}
 			ft::pair<const_iterator, const_iterator> equal_range(const key_type & key) const
 			{
-				return __tree.equal_range(ft::make_pair(key, mapped_type()));
+				return __tree.equal_range(key);
 			}
+
+			/* order statistics, only with the order_statistics policy ------ */
+			/* the element at position n in key order, end() past the last one */
+			iterator nth(size_type n)
+			{
+				return __tree.nth(n);
+			}
+			const_iterator nth(size_type n) const
+			{
+				return __tree.nth(n);
+			}
+			/* the number of elements whose key is less than x */
+			size_type rank(const key_type & x) const
+			{
+				return __tree.rank(x);
+			}
+			/* std::distance(first, last) in O(log n) */
+			difference_type distance(const_iterator first, const_iterator last) const
+			{
+				return __tree.distance(first, last);
+			}
+
+			/* heterogeneous lookup, only with a transparent key_compare ----- */
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			find(const K & x)
+			{
+				return __tree.find(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, const_iterator>::type
+			find(const K & x) const
+			{
+				return __tree.find(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, size_type>::type
+			count(const K & x) const
+			{
+				return __tree.count(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			lower_bound(const K & x)
+			{
+				return __tree.lower_bound(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, const_iterator>::type
+			lower_bound(const K & x) const
+			{
+				return __tree.lower_bound(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			upper_bound(const K & x)
+			{
+				return __tree.upper_bound(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, const_iterator>::type
+			upper_bound(const K & x) const
+			{
+				return __tree.upper_bound(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, ft::pair<iterator, iterator> >::type
+			equal_range(const K & x)
+			{
+				return __tree.equal_range(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, 
+								ft::pair<const_iterator, const_iterator> >::type
+			equal_range(const K & x) const
+			{
+				return __tree.equal_range(x);
+			}
+
 		private :
+			/* build the value_type for a missing key, see rbtree::find_or_insert */
+			struct __make_default
+			{
+				const key_type 	& k;
+
+				explicit __make_default(const key_type & key)
+				: k(key)
+				{}
+				value_type operator()() const
+				{
+					return value_type(k, mapped_type());
+				}
+			};
+
+			template <class M>
+			struct __make_value
+			{
+				const key_type 	& k;
+				const M 		& m;
+
+				__make_value(const key_type & key, const M & obj)
+				: k(key), m(obj)
+				{}
+				value_type operator()() const
+				{
+					return value_type(k, m);
+				}
+			};
+
 			allocator_type 	__alloc;
 			key_compare		__comp;	
-			rbtree 			__tree;
+			tree_type 		__tree;
 	};
 
 	/* 	
@@ -283,51 +693,51 @@ namespace ft
 		same number of elements and each element in lhs compares equal with the element 
 		in rhs at the same position 
 	*/
-	template <class Key, class T, class Compare, class Allocator>
-	bool operator==(const map<Key, T, Compare, Allocator> & x,
-					const map<Key, T, Compare, Allocator> & y)
+	template <class Key, class T, class Compare, class Allocator, class Policy>
+	bool operator==(const map<Key, T, Compare, Allocator, Policy> & x,
+					const map<Key, T, Compare, Allocator, Policy> & y)
 	{
 		return (x.size() == y.size()) 
 						&& ft::equal(x.begin(), x.end(), y.begin());
 	}
 
-	template <class Key, class T, class Compare, class Allocator>
-	bool operator!=(	const map<Key, T, Compare, Allocator>& x,
-						const map<Key, T, Compare, Allocator>& y)
+	template <class Key, class T, class Compare, class Allocator, class Policy>
+	bool operator!=(	const map<Key, T, Compare, Allocator, Policy>& x,
+						const map<Key, T, Compare, Allocator, Policy>& y)
 	{
 		return !(x == y);
 	}
 
-	template <class Key, class T, class Compare, class Allocator>
-	bool operator<(	const map<Key, T, Compare, Allocator>& x,
-					const map<Key, T, Compare, Allocator>& y)
+	template <class Key, class T, class Compare, class Allocator, class Policy>
+	bool operator<(	const map<Key, T, Compare, Allocator, Policy>& x,
+					const map<Key, T, Compare, Allocator, Policy>& y)
 	{
 		return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 	}
 
-	template <class Key, class T, class Compare, class Allocator>
-	bool operator> (	const map<Key, T, Compare, Allocator> & x,
-						const map<Key, T, Compare, Allocator> & y)
+	template <class Key, class T, class Compare, class Allocator, class Policy>
+	bool operator> (	const map<Key, T, Compare, Allocator, Policy> & x,
+						const map<Key, T, Compare, Allocator, Policy> & y)
 	{
 		return y < x;
 	}
 
-	template <class Key, class T, class Compare, class Allocator>
-	bool operator>=(	const map<Key, T, Compare, Allocator> & x,
-						const map<Key, T, Compare, Allocator> & y)
+	template <class Key, class T, class Compare, class Allocator, class Policy>
+	bool operator>=(	const map<Key, T, Compare, Allocator, Policy> & x,
+						const map<Key, T, Compare, Allocator, Policy> & y)
 	{
 		return !(x < y);
 	}
-	template <class Key, class T, class Compare, class Allocator>
-	bool operator<=(	const map<Key, T, Compare, Allocator> & x,
-						const map<Key, T, Compare, Allocator> & y)
+	template <class Key, class T, class Compare, class Allocator, class Policy>
+	bool operator<=(	const map<Key, T, Compare, Allocator, Policy> & x,
+						const map<Key, T, Compare, Allocator, Policy> & y)
 	{
 		return !(x > y);
 	}
 
-	template <class Key, class T, class Compare, class Allocator>
-	void swap(	ft::map<Key, T, Compare, Allocator> & lhs,
-           		ft::map<Key, T, Compare, Allocator> & rhs)
+	template <class Key, class T, class Compare, class Allocator, class Policy>
+	void swap(	ft::map<Key, T, Compare, Allocator, Policy> & lhs,
+           		ft::map<Key, T, Compare, Allocator, Policy> & rhs)
 	{
 		lhs.swap(rhs);
 	}
@@ -0,0 +1,39 @@
+#ifndef 	PMR_HPP
+# define 	PMR_HPP
+
+# include "vector.hpp"
+# include "map.hpp"
+# include "set.hpp"
+# include "stack.hpp"
+# include "../utils/memory_resource.hpp"
+
+/*
+	Containers over a memory resource, see memory_resource.hpp:
+
+		ft::pmr::monotonic_buffer_resource	arena;
+		ft::pmr::map<int, int>				m(std::less<int>(), &arena);
+
+	Before C++11 there are no alias templates, the full types are spelled
+	with ft::pmr::polymorphic_allocator<value_type>
+*/
+# if FT_CXX11
+namespace ft
+{
+namespace pmr
+{
+	template <class T>
+	using vector = ft::vector<T, polymorphic_allocator<T> >;
+
+	template <class Key, class T, class Compare = std::less<Key>, class Policy = ft::no_augment>
+	using map = ft::map<Key, T, Compare, polymorphic_allocator<ft::pair<const Key, T> >, Policy>;
+
+	template <class Key, class Compare = std::less<Key>, class Policy = ft::no_augment>
+	using set = ft::set<Key, Compare, polymorphic_allocator<Key>, Policy>;
+
+	template <class T>
+	using stack = ft::stack<T, ft::pmr::vector<T> >;
+}
+}
+# endif
+
+#endif
@@ -5,12 +5,18 @@
 # include <algorithm>
 # include <functional>
 # include "../utils/utils.hpp"
-# include "../utils/tree.hpp"
+# include "../utils/enable_if.hpp"
+# include "../utils/tree_select.hpp"
 
 namespace ft
 {
+	/*
+		Policy picks the tree: ft::no_augment, ft::order_statistics to enable
+		nth and rank, or ft::btree_nodes<N> for a B+ tree (see btree.hpp)
+	*/
 	template <class Key, class Compare = std::less <Key>, 
-										class Allocator = std::allocator <Key> >
+										class Allocator = std::allocator <Key>,
+										class Policy = ft::no_augment >
 	class set
 	{
 		public :
@@ -26,20 +32,22 @@ namespace ft
 			typedef const value_type & 										const_reference;
 			typedef typename Allocator::pointer 							pointer;
 			typedef typename Allocator::const_pointer						const_pointer;
-			typedef Node<value_type>										node;
-			typedef node * 													node_pointer;
-			typedef rbtree<value_type, value_compare, allocator_type>		rbtree;
+			typedef typename select_tree<Policy, value_type, value_compare, allocator_type,
+										ft::identity<value_type> >::type		tree_type;
 			/* iterators --------------------------------------------------------- */
-			typedef tree_iter<node_pointer, pointer>						iterator;
-			typedef tree_iter<node_pointer, const_pointer>					const_iterator;											
+			typedef typename tree_type::iterator							iterator;
+			typedef typename tree_type::const_iterator						const_iterator;
 			typedef reverse_iter<iterator>									reverse_iterator;
 			typedef reverse_iter<const_iterator>							const_reverse_iterator;
+			/* node handles ------------------------------------------------------ */
+			typedef typename select_node_handle<Policy, node_handle<tree_type> >::type		node_type;
+			typedef node_insert_return<iterator, node_type>					insert_return_type;
 			
 			/* constructors ------------------------------------------------------ */
 			set()
 			:	__comp(key_compare()),
 				__alloc(allocator_type()),
-				__tree(__comp, __alloc)
+				__tree(key_compare(), allocator_type())
 			{}
 
 			explicit set(	const key_compare & comp, 
@@ -59,6 +67,21 @@ namespace ft
 				__tree.insert(first, last);
 			}
 
+			/* 
+				precondition, not checked: [first, last) is strictly increasing 
+				by comp (sorted, no equal keys). The tree is then built in 
+				linear time without comparing keys 
+			*/
+			template <class InputIt>
+			set(from_sorted_t, InputIt first, InputIt last, const key_compare & comp = key_compare(), 
+											 const allocator_type & alloc = allocator_type())
+			:	__comp(comp),
+				__alloc(alloc),
+				__tree(comp, alloc)
+			{
+				__tree.build_sorted(first, last);
+			}
+
 			set(const set & other)
 			:	__comp(other.__comp),
 				__alloc(other.__alloc),
@@ -76,6 +99,25 @@ namespace ft
 				return *this;
 			}
 
+# if FT_CXX11
+			set(set && other)
+			:	__comp(other.__comp),
+				__alloc(other.__alloc),
+				__tree(std::move(other.__tree))
+			{}
+
+			set & operator=(set && rhs)
+			{
+				if (this != &rhs)
+				{
+					__tree = std::move(rhs.__tree);
+					__comp = rhs.__comp;
+					__alloc = rhs.__alloc;
+				}
+				return *this;
+			}
+# endif
+
 			~set()
 			{}
 
@@ -84,6 +126,12 @@ namespace ft
 				return __alloc;
 			}
 
+			/* counters of the underlying tree, zero unless built with FT_STATS (see stats.hpp) */
+			container_stats stats() const
+			{
+				return __tree.stats();
+			}
+
 			/* iterators ----------------------------------------------------- */
 			iterator begin()
 			{
@@ -164,6 +212,30 @@ namespace ft
 				__tree.insert(first, last);
 			}
 
+# if FT_CXX11
+			ft::pair<iterator, bool> insert(value_type && value)
+			{
+				return __tree.emplace(std::move(value));
+			}
+
+			iterator insert(iterator hint, value_type && value)
+			{
+				return __tree.emplace_hint(hint, std::move(value));
+			}
+
+			template <class... Args>
+			ft::pair<iterator, bool> emplace(Args &&... args)
+			{
+				return __tree.emplace(std::forward<Args>(args)...);
+			}
+
+			template <class... Args>
+			iterator emplace_hint(iterator hint, Args &&... args)
+			{
+				return __tree.emplace_hint(hint, std::forward<Args>(args)...);
+			}
+# endif
+
 			void erase(iterator pos)
 			{
 				__tree.erase(pos);
@@ -181,11 +253,130 @@ namespace ft
 
 			void swap(set & rhs)
 			{
-				std::swap(this->__tree, rhs.__tree);
+				this->__tree.swap(rhs.__tree);
 				std::swap(this->__alloc, rhs.__alloc);
 				std::swap(this->__comp, rhs.__comp);
 			}
 
+			/* node handles, red-black trees only ---------------------------- */
+			/* unlinks an element, which stays in its node, see node_handle.hpp */
+			node_type extract(iterator position)
+			{
+				return node_type(__tree.extract(position), __tree, __alloc);
+			}
+			/* an empty handle when x is missing */
+			node_type extract(const key_type & x)
+			{
+				iterator position = this->find(x);
+
+				if (position == this->end())
+					return node_type();
+				return extract(position);
+			}
+			/* links the node of nh back, unless its key is taken: nh is then handed back in the result */
+			insert_return_type insert(node_type & nh)
+			{
+				insert_return_type			res;
+				ft::pair<iterator, bool>	found;
+
+				res.position = this->end();
+				res.inserted = false;
+				if (nh.empty())
+					return res;
+				__tree.share_pool(nh.group());
+				found = __tree.insert_node(nh.base());
+				res.position = found.first;
+				res.inserted = found.second;
+				if (found.second)
+					nh.release();
+				else
+					res.node = FT_MOVE(nh);
+				return res;
+			}
+			/* nh keeps its node when the key is taken */
+			iterator insert(iterator hint, node_type & nh)
+			{
+				iterator position;
+
+				if (nh.empty())
+					return this->end();
+				__tree.share_pool(nh.group());
+				position = __tree.insert_node(hint, nh.base());
+				if (position.base() == nh.base())
+					nh.release();
+				return position;
+			}
+# if FT_CXX11
+			insert_return_type insert(node_type && nh)
+			{
+				return insert(nh);
+			}
+			iterator insert(iterator hint, node_type && nh)
+			{
+				return insert(hint, nh);
+			}
+# endif
+
+			/* bulk operations, red-black trees only ------------------------- */
+			/* 
+				nodes are relinked, never copied, in O(log n) for join and 
+				O(m log(n / m + 1)) for the set operations, m <= n being the 
+				sizes. split_at is O(log n) with ft::order_statistics, which 
+				keeps the sizes of the two parts; otherwise it also walks the 
+				smaller part to count it, O(log n + min(k, n - k)). The allocators must compare equal and key_compare 
+				must not throw. With ft::parallel the work is spread over the 
+				hardware threads, key_compare must then be safe to call from 
+				several threads at once. The two containers then share their 
+				node pools: until one of them is cleared or destroyed, they 
+				must not be used from different threads at once
+			*/
+			/* moves in the elements of other whose key is missing here */
+			void merge(set & other)
+			{
+				__tree.merge(other.__tree);
+			}
+			void merge(set & other, parallel_t)
+			{
+				__tree.merge(other.__tree, tree_type::parallel_forks());
+			}
+			/* adds a copy of the elements of other whose key is missing here */
+			void set_union(const set & other)
+			{
+				__tree.unite(other.__tree);
+			}
+			void set_union(const set & other, parallel_t)
+			{
+				__tree.unite(other.__tree, tree_type::parallel_forks());
+			}
+			/* keeps the elements whose key is in other */
+			void set_intersection(const set & other)
+			{
+				__tree.intersect(other.__tree);
+			}
+			void set_intersection(const set & other, parallel_t)
+			{
+				__tree.intersect(other.__tree, tree_type::parallel_forks());
+			}
+			/* removes the elements whose key is in other */
+			void set_difference(const set & other)
+			{
+				__tree.subtract(other.__tree);
+			}
+			void set_difference(const set & other, parallel_t)
+			{
+				__tree.subtract(other.__tree, tree_type::parallel_forks());
+			}
+			/* appends greater, whose keys are all above the keys here */
+			void join(set & greater)
+			{
+				__tree.join(greater.__tree);
+			}
+			/* the elements whose key is not less than key move to greater */
+			void split_at(const key_type & key, set & greater)
+			{
+				__tree.split(key, greater.__tree);
+			}
+
 			/* lookup -------------------------------------------------------- */
 			iterator find(const key_type & key)
 			{
@@ -199,7 +390,7 @@ namespace ft
 
 			size_type count(const key_type & key) const
 			{
-				return (find(key) == end()) ? 0 : 1;
+				return __tree.count(key);
 			}
 
 			iterator lower_bound(const key_type & key)
@@ -230,6 +421,84 @@ namespace ft
 			{
 				return __tree.equal_range(key);
 			}
+
+			/* heterogeneous lookup, only with a transparent key_compare ----- */
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			find(const K & x)
+			{
+				return __tree.find(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, const_iterator>::type
+			find(const K & x) const
+			{
+				return __tree.find(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, size_type>::type
+			count(const K & x) const
+			{
+				return __tree.count(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			lower_bound(const K & x)
+			{
+				return __tree.lower_bound(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, const_iterator>::type
+			lower_bound(const K & x) const
+			{
+				return __tree.lower_bound(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			upper_bound(const K & x)
+			{
+				return __tree.upper_bound(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, const_iterator>::type
+			upper_bound(const K & x) const
+			{
+				return __tree.upper_bound(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, ft::pair<iterator, iterator> >::type
+			equal_range(const K & x)
+			{
+				return __tree.equal_range(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, 
+								ft::pair<const_iterator, const_iterator> >::type
+			equal_range(const K & x) const
+			{
+				return __tree.equal_range(x);
+			}
+			/* order statistics, only with the order_statistics policy ------ */
+			/* the element at position n in key order, end() past the last one */
+			iterator nth(size_type n)
+			{
+				return __tree.nth(n);
+			}
+			const_iterator nth(size_type n) const
+			{
+				return __tree.nth(n);
+			}
+			/* the number of elements whose key is less than x */
+			size_type rank(const key_type & x) const
+			{
+				return __tree.rank(x);
+			}
+			/* std::distance(first, last) in O(log n) */
+			difference_type distance(const_iterator first, const_iterator last) const
+			{
+				return __tree.distance(first, last);
+			}
+
 			/* observers ----------------------------------------------------- */
 			key_compare key_comp() const
 			{
@@ -239,54 +508,54 @@ namespace ft
 		protected :
 			key_compare 	__comp;
 			allocator_type 	__alloc;
-			rbtree 			__tree;
+			tree_type 		__tree;
 	};
 
-	template <class Key, class Compare, class Allocator>
-	bool operator==(const set<Key, Compare, Allocator> & x,
-					const set<Key, Compare, Allocator> & y)
+	template <class Key, class Compare, class Allocator, class Policy>
+	bool operator==(const set<Key, Compare, Allocator, Policy> & x,
+					const set<Key, Compare, Allocator, Policy> & y)
 	{
 		return (x.size() == y.size()) 
 				&& ft::equal(x.begin(), x.end(), y.begin());
 	}
 
-	template <class Key, class Compare, class Allocator>
-	bool operator!=(	const set<Key, Compare, Allocator> & x,
-						const set<Key, Compare, Allocator> & y)
+	template <class Key, class Compare, class Allocator, class Policy>
+	bool operator!=(	const set<Key, Compare, Allocator, Policy> & x,
+						const set<Key, Compare, Allocator, Policy> & y)
 	{
 		return !(x == y);
 	}
 
-	template <class Key, class Compare, class Allocator>
-	bool operator<(	const set<Key, Compare, Allocator> & x,
-					const set<Key, Compare, Allocator> & y)
+	template <class Key, class Compare, class Allocator, class Policy>
+	bool operator<(	const set<Key, Compare, Allocator, Policy> & x,
+					const set<Key, Compare, Allocator, Policy> & y)
 	{
 		return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 	}
 
-	template <class Key, class Compare, class Allocator>
-	bool operator> (	const set<Key, Compare, Allocator> & x,
-						const set<Key, Compare, Allocator> & y)
+	template <class Key, class Compare, class Allocator, class Policy>
+	bool operator> (	const set<Key, Compare, Allocator, Policy> & x,
+						const set<Key, Compare, Allocator, Policy> & y)
 	{
 		return y < x;
 	}
 
-	template <class Key, class Compare, class Allocator>
-	bool operator>=(	const set<Key, Compare, Allocator> & x,
-						const set<Key, Compare, Allocator> & y)
+	template <class Key, class Compare, class Allocator, class Policy>
+	bool operator>=(	const set<Key, Compare, Allocator, Policy> & x,
+						const set<Key, Compare, Allocator, Policy> & y)
 	{
 		return !(x < y);
 	}
-	template <class Key, class Compare, class Allocator>
-	bool operator<=(	const set<Key, Compare, Allocator> & x,
-						const set<Key, Compare, Allocator> & y)
+	template <class Key, class Compare, class Allocator, class Policy>
+	bool operator<=(	const set<Key, Compare, Allocator, Policy> & x,
+						const set<Key, Compare, Allocator, Policy> & y)
 	{
 		return !(x > y);
 	}
 
-	template <class Key, class Compare, class Allocator>
-	void swap(	ft::set<Key, Compare, Allocator> & lhs,
-           		ft::set<Key, Compare, Allocator> & rhs)
+	template <class Key, class Compare, class Allocator, class Policy>
+	void swap(	ft::set<Key, Compare, Allocator, Policy> & lhs,
+           		ft::set<Key, Compare, Allocator, Policy> & rhs)
 	{
 		lhs.swap(rhs);
 	}
@@ -0,0 +1,91 @@
+#ifndef		SMALL_VECTOR_HPP
+# define	SMALL_VECTOR_HPP
+
+# include "vector.hpp"
+
+namespace ft
+{
+	/*
+		ft::vector whose first N elements live inside the object: building,
+		filling and destroying a short vector never touches the heap. Past N
+		the elements move to a heap buffer and it behaves as a vector. Moving
+		or swapping an inline small_vector moves its elements one by one, and
+		every iterator is invalidated by it. Usable as the container of
+		ft::stack
+	*/
+	template <class T, size_t N, class Allocator = std::allocator<T>,
+								class GrowthPolicy = ft::grow_double>
+	class small_vector : public vector<T, Allocator, GrowthPolicy, N>
+	{
+		public:
+			typedef vector<T, Allocator, GrowthPolicy, N>	base_type;
+			typedef typename base_type::size_type		size_type;
+			typedef typename base_type::const_reference	const_reference;
+			typedef typename base_type::allocator_type	allocator_type;
+
+			static const size_t	inline_capacity = N;
+
+			/* ------------------------ constructors ------------------------- */
+			small_vector()
+			:	base_type()
+			{}
+
+			explicit small_vector(const allocator_type & alloc)
+			:	base_type(alloc)
+			{}
+
+			explicit small_vector(	size_type count, const_reference value = T(),
+									const allocator_type & alloc = allocator_type())
+			:	base_type(count, value, alloc)
+			{}
+
+			template <class InputIt>
+			small_vector(typename enable_if<is_iterator<InputIt>::value, InputIt>::type first,
+						InputIt last, const allocator_type & alloc = allocator_type())
+			:	base_type(first, last, alloc)
+			{}
+
+			small_vector(const small_vector & other)
+			:	base_type(other)
+			{}
+
+			small_vector & operator=(const small_vector & other)
+			{
+				base_type::operator=(other);
+				return *this;
+			}
+# if FT_CXX11
+			small_vector(small_vector && other)
+			:	base_type(std::move(other))
+			{}
+
+			small_vector & operator=(small_vector && other)
+			{
+				base_type::operator=(std::move(other));
+				return *this;
+			}
+# endif
+
+			~small_vector() {}
+
+			/* true while the elements are still in the inline buffer */
+			bool is_inline() const
+			{
+				return this->capacity() == N;
+			}
+
+			void swap(small_vector & rhs)
+			{
+				base_type::swap(rhs);
+			}
+	};
+
+	template <class T, size_t N, class Allocator, class GrowthPolicy>
+	void swap(	small_vector<T, N, Allocator, GrowthPolicy> & lhs,
+				small_vector<T, N, Allocator, GrowthPolicy> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
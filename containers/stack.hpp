@@ -31,6 +31,21 @@ namespace ft
 				__cont = other.__cont;
 				return *this;
 			}
+# if FT_CXX11
+			explicit stack(container_type && cont)
+			: __cont(std::move(cont))
+			{}
+
+			stack(stack && other)
+			: __cont(std::move(other.__cont))
+			{}
+
+			stack & operator=(stack && other)
+			{
+				__cont = std::move(other.__cont);
+				return *this;
+			}
+# endif
 			~stack()
 			{}
 
@@ -60,39 +75,51 @@ namespace ft
 			{
 				__cont.push_back(value);
 			}
+# if FT_CXX11
+			void push(value_type && value)
+			{
+				__cont.push_back(std::move(value));
+			}
+			template <class... Args>
+			void emplace(Args &&... args)
+			{
+				__cont.emplace_back(std::forward<Args>(args)...);
+			}
+# endif
 			void pop()
 			{
 				__cont.pop_back();
 			}
 
+			/* ---------------------------- stats ----------------------------- */
+			/* counters of the underlying ft container (see stats.hpp) */
+			container_stats stats() const
+			{
+				return __cont.stats();
+			}
+
 			/* -------------------- non-member functions ---------------------- */
-			template <class A, class Cont>
-			friend bool operator==(const stack<A,Cont>& lhs, const stack<A,Cont>& rhs)
+			friend bool operator==(const stack & lhs, const stack & rhs)
 			{
 				return lhs.__cont == rhs.__cont;
 			}
-			template <class A, class Cont>
-			friend bool operator!=(const stack<A,Cont>& lhs, const stack<A,Cont>& rhs)
+			friend bool operator!=(const stack & lhs, const stack & rhs)
 			{
 				return lhs.__cont != rhs.__cont;
 			}
-			template <class A, class Cont>
-			friend bool operator<(const stack<A,Cont>& lhs, const stack<A,Cont>& rhs)
+			friend bool operator<(const stack & lhs, const stack & rhs)
 			{
 				return lhs.__cont < rhs.__cont;
 			}
-			template <class A, class Cont>
-			friend bool operator<=(const stack<A,Cont>& lhs, const stack<A,Cont>& rhs)
+			friend bool operator<=(const stack & lhs, const stack & rhs)
 			{
 				return lhs.__cont <= rhs.__cont;
 			}
-			template <class A, class Cont>
-			friend bool operator>(const stack<A,Cont>& lhs, const stack<A,Cont>& rhs)
+			friend bool operator>(const stack & lhs, const stack & rhs)
 			{
 				return lhs.__cont > rhs.__cont;
 			}
-			template <class A, class Cont>
-			friend bool operator>=(const stack<A,Cont>& lhs, const stack<A,Cont>& rhs)
+			friend bool operator>=(const stack & lhs, const stack & rhs)
 			{
 				return lhs.__cont >= rhs.__cont;
 			}
@@ -0,0 +1,371 @@
+#ifndef 	STATIC_SET_HPP
+# define 	STATIC_SET_HPP
+
+# include <memory>
+# include <functional>
+# include <algorithm>
+# include "vector.hpp"
+# include "set.hpp"
+# include "flat_set.hpp"
+# include "../utils/utils.hpp"
+# include "../utils/enable_if.hpp"
+# include "../utils/bidirectional_iterator.hpp"
+# include "../utils/eytzinger_search.hpp"
+# include "../utils/eytzinger_iterator.hpp"
+
+namespace ft
+{
+	/*
+		Immutable set for containers that are built once and then only
+		searched. The keys are stored alone, in one array in eytzinger order
+		(see eytzinger_search.hpp): no pointers, and lookups are branchless
+		and prefetch the levels ahead. Iteration is in key order, as for
+		ft::set, but slower than a sorted array's.
+
+		Built from a range like a set, or from an ft::set or ft::flat_set with
+		ft::freeze(). There are no modifiers except assignment and swap
+	*/
+	template <class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key> >
+	class static_set
+	{
+		public :
+			/* typedefs ---------------------------------------------------------- */
+			typedef Key 													key_type;
+			typedef Key 													value_type;
+			typedef std::size_t												size_type;
+			typedef std::ptrdiff_t											difference_type;
+			typedef Compare													key_compare;
+			typedef Compare													value_compare;
+			typedef Allocator												allocator_type;
+			typedef value_type & 											reference;
+			typedef const value_type & 										const_reference;
+			typedef typename Allocator::pointer 							pointer;
+			typedef typename Allocator::const_pointer						const_pointer;
+			typedef ft::vector<Key, Allocator>								container_type;
+			/* iterators --------------------------------------------------------- */
+			typedef eytzinger_iter<Key>										iterator;
+			typedef eytzinger_iter<Key>										const_iterator;
+			typedef reverse_iter<iterator>									reverse_iterator;
+			typedef reverse_iter<const_iterator>							const_reverse_iterator;
+
+			/* constructors ------------------------------------------------------ */
+			static_set()
+			:	__comp(key_compare()),
+				__keys()
+			{}
+
+			explicit static_set(const key_compare & comp,
+								const allocator_type & alloc = allocator_type())
+			:	__comp(comp),
+				__keys(alloc)
+			{}
+
+			/* duplicates are dropped, as by ft::set */
+			template <class InputIt>
+			static_set(InputIt first, InputIt last, const key_compare & comp = key_compare(),
+											 const allocator_type & alloc = allocator_type())
+			:	__comp(comp),
+				__keys(alloc)
+			{
+				flat_set<Key, Compare, Allocator> sorted(first, last, comp, alloc);
+
+				__layout(sorted);
+			}
+
+			/* [first, last) is sorted by comp, see flat_set */
+			template <class InputIt>
+			static_set(from_sorted_t, InputIt first, InputIt last, const key_compare & comp = key_compare(),
+											 const allocator_type & alloc = allocator_type())
+			:	__comp(comp),
+				__keys(alloc)
+			{
+				flat_set<Key, Compare, Allocator> sorted(from_sorted, first, last, comp, alloc);
+
+				__layout(sorted);
+			}
+
+			static_set(const static_set & other)
+			:	__comp(other.__comp),
+				__keys(other.__keys)
+			{}
+
+			static_set & operator=(const static_set & other)
+			{
+				if (this != &other)
+				{
+					__keys = other.__keys;
+					__comp = other.__comp;
+				}
+				return *this;
+			}
+
+# if FT_CXX11
+			static_set(static_set && other)
+			:	__comp(other.__comp),
+				__keys(std::move(other.__keys))
+			{}
+
+			static_set & operator=(static_set && other)
+			{
+				if (this != &other)
+				{
+					__keys = std::move(other.__keys);
+					__comp = other.__comp;
+				}
+				return *this;
+			}
+# endif
+
+			~static_set() {}
+
+			allocator_type get_allocator() const
+			{
+				return __keys.get_allocator();
+			}
+
+			/* counters of the key vector, zero unless built with FT_STATS (see stats.hpp) */
+			container_stats stats() const
+			{
+				return __keys.stats();
+			}
+
+			/* iterators --------------------------------------------------------- */
+			iterator begin() const
+			{
+				return __at(eytzinger_first(size()));
+			}
+			iterator end() const
+			{
+				return __at(0);
+			}
+			reverse_iterator rbegin() const
+			{
+				return reverse_iterator(end());
+			}
+			reverse_iterator rend() const
+			{
+				return reverse_iterator(begin());
+			}
+
+			/* capacity ---------------------------------------------------------- */
+			bool empty() const
+			{
+				return __keys.empty();
+			}
+			size_type size() const
+			{
+				return __keys.size();
+			}
+			size_type max_size() const
+			{
+				return __keys.max_size();
+			}
+
+			/* the keys in eytzinger order */
+			const container_type & keys() const
+			{
+				return __keys;
+			}
+
+			void swap(static_set & other)
+			{
+				__keys.swap(other.__keys);
+				std::swap(__comp, other.__comp);
+			}
+
+			/* observers --------------------------------------------------------- */
+			key_compare key_comp() const
+			{
+				return __comp;
+			}
+			value_compare value_comp() const
+			{
+				return __comp;
+			}
+
+			/* set operations ---------------------------------------------------- */
+			iterator find(const key_type & x) const
+			{
+				return __find(x);
+			}
+			size_type count(const key_type & x) const
+			{
+				return __found(__lower(x), x);
+			}
+			iterator lower_bound(const key_type & x) const
+			{
+				return __at(__lower(x));
+			}
+			iterator upper_bound(const key_type & x) const
+			{
+				return __at(__upper(x));
+			}
+			ft::pair<iterator, iterator> equal_range(const key_type & x) const
+			{
+				size_type k = __lower(x);
+
+				if (__found(k, x))
+					return ft::make_pair(__at(k), ++__at(k));
+				return ft::make_pair(__at(k), __at(k));
+			}
+
+			/* heterogeneous lookup, only with a transparent key_compare --------- */
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			find(const K & x) const
+			{
+				return __find(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, size_type>::type
+			count(const K & x) const
+			{
+				return __found(__lower(x), x);
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			lower_bound(const K & x) const
+			{
+				return __at(__lower(x));
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, iterator>::type
+			upper_bound(const K & x) const
+			{
+				return __at(__upper(x));
+			}
+			template <class K>
+			typename enable_if<is_transparent<key_compare, K>::value, ft::pair<iterator, iterator> >::type
+			equal_range(const K & x) const
+			{
+				return ft::make_pair(__at(__lower(x)), __at(__upper(x)));
+			}
+
+		private :
+			key_compare			__comp;
+			container_type		__keys;
+
+			iterator __at(size_type k) const
+			{
+				return iterator(__keys.data(), __keys.size(), k);
+			}
+
+			template <class K>
+			size_type __lower(const K & x) const
+			{
+				return eytzinger_lower_bound(__keys.data(), __keys.size(), x, __comp);
+			}
+
+			template <class K>
+			size_type __upper(const K & x) const
+			{
+				return eytzinger_upper_bound(__keys.data(), __keys.size(), x, __comp);
+			}
+
+			/* k is the lower bound of x */
+			template <class K>
+			bool __found(size_type k, const K & x) const
+			{
+				return k != 0 && !__comp(x, __keys.data()[k - 1]);
+			}
+
+			template <class K>
+			iterator __find(const K & x) const
+			{
+				size_type k = __lower(x);
+
+				return __at(__found(k, x) ? k : 0);
+			}
+
+			/*
+				the in-order walk of the implicit tree hands out the sorted keys.
+				sorted is the caller's temporary, its keys are moved out
+			*/
+			void __layout(flat_set<Key, Compare, Allocator> & sorted)
+			{
+				size_type				n = sorted.size();
+				ft::vector<size_type>	from;
+				size_type				k = eytzinger_first(n);
+				key_type				*src = const_cast<key_type *>(sorted.keys().data());
+
+				if (n == 0)
+					return;
+				from.resize(n);
+				for (size_type i = 0; i < n; ++i)
+				{
+					from[k - 1] = i;
+					k = eytzinger_next(k, n);
+				}
+				__keys.reserve(n);
+				for (size_type j = 0; j < n; ++j)
+					__keys.push_back(FT_MOVE(src[from[j]]));
+			}
+	};
+
+	/* the layout only depends on the keys, equal sets have equal arrays */
+	template <class Key, class Compare, class Allocator>
+	bool operator==(const static_set<Key, Compare, Allocator> & lhs,
+					const static_set<Key, Compare, Allocator> & rhs)
+	{
+		return lhs.keys() == rhs.keys();
+	}
+
+	template <class Key, class Compare, class Allocator>
+	bool operator!=(const static_set<Key, Compare, Allocator> & lhs,
+					const static_set<Key, Compare, Allocator> & rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class Key, class Compare, class Allocator>
+	bool operator<(	const static_set<Key, Compare, Allocator> & lhs,
+					const static_set<Key, Compare, Allocator> & rhs)
+	{
+		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template <class Key, class Compare, class Allocator>
+	bool operator>(	const static_set<Key, Compare, Allocator> & lhs,
+					const static_set<Key, Compare, Allocator> & rhs)
+	{
+		return rhs < lhs;
+	}
+
+	template <class Key, class Compare, class Allocator>
+	bool operator<=(const static_set<Key, Compare, Allocator> & lhs,
+					const static_set<Key, Compare, Allocator> & rhs)
+	{
+		return !(rhs < lhs);
+	}
+
+	template <class Key, class Compare, class Allocator>
+	bool operator>=(const static_set<Key, Compare, Allocator> & lhs,
+					const static_set<Key, Compare, Allocator> & rhs)
+	{
+		return !(lhs < rhs);
+	}
+
+	template <class Key, class Compare, class Allocator>
+	void swap(	ft::static_set<Key, Compare, Allocator> & lhs,
+				ft::static_set<Key, Compare, Allocator> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+	/* read-only snapshot of a set, for lookups only ----------------------- */
+	template <class Key, class Compare, class Allocator, class Policy>
+	static_set<Key, Compare, Allocator> freeze(const set<Key, Compare, Allocator, Policy> & s)
+	{
+		return static_set<Key, Compare, Allocator>(from_sorted, s.begin(), s.end(),
+													s.key_comp(), s.get_allocator());
+	}
+
+	template <class Key, class Compare, class Allocator>
+	static_set<Key, Compare, Allocator> freeze(const flat_set<Key, Compare, Allocator> & s)
+	{
+		return static_set<Key, Compare, Allocator>(from_sorted, s.begin(), s.end(),
+													s.key_comp(), s.get_allocator());
+	}
+}
+
+#endif
@@ -0,0 +1,459 @@
+#ifndef 	UNORDERED_MAP_HPP
+# define 	UNORDERED_MAP_HPP
+
+# include <memory>
+# include <functional>
+# include <stdexcept>
+# include "../utils/utils.hpp"
+# include "../utils/enable_if.hpp"
+# include "../utils/functional.hpp"
+# include "../utils/hash.hpp"
+# include "../utils/swiss_table.hpp"
+
+namespace ft
+{
+	/*
+		Hash map over an open addressing swiss table, see swiss_table.hpp:
+		find, insert and erase take one probe of a few groups of control
+		bytes instead of a tree descent. A bucket is one slot of the table,
+		there is no bucket interface. Iterators are forward only, and every
+		insertion may invalidate them
+	*/
+	template <class Key, class T, class Hash = ft::hash<Key>,
+									class KeyEqual = std::equal_to<Key>,
+									class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class unordered_map
+	{
+		public :
+
+			/* typedefs ------------------------------------------------------ */
+			typedef Key										key_type;
+			typedef T										mapped_type;
+			typedef pair<const Key, T>						value_type;
+			typedef Hash									hasher;
+			typedef KeyEqual								key_equal;
+			typedef Allocator								allocator_type;
+			typedef typename Allocator::reference			reference;
+			typedef typename Allocator::const_reference		const_reference;
+			typedef typename Allocator::pointer				pointer;
+			typedef typename Allocator::const_pointer		const_pointer;
+			typedef	std::ptrdiff_t							difference_type;
+			typedef	size_t									size_type;
+
+			typedef swiss_table<value_type, hasher, key_equal, allocator_type,
+								ft::select1st<value_type> >	table_type;
+
+			/* iterators ----------------------------------------------------- */
+			typedef typename table_type::iterator			iterator;
+			typedef typename table_type::const_iterator		const_iterator;
+
+			/* constructors ---------------------------------------------------*/
+			unordered_map()
+			:	__table()
+			{}
+
+			explicit unordered_map(	size_type bucket_count,
+									const hasher & hash = hasher(),
+									const key_equal & eq = key_equal(),
+									const allocator_type & alloc = allocator_type())
+			:	__table(bucket_count, hash, eq, alloc)
+			{}
+
+			template <class InputIt>
+			unordered_map(	InputIt first, InputIt last, size_type bucket_count = 0,
+							const hasher & hash = hasher(),
+							const key_equal & eq = key_equal(),
+							const allocator_type & alloc = allocator_type())
+			:	__table(bucket_count, hash, eq, alloc)
+			{
+				__table.insert(first, last);
+			}
+
+			unordered_map(const unordered_map & rhs)
+			:	__table(rhs.__table)
+			{}
+
+			unordered_map & operator=(const unordered_map & rhs)
+			{
+				__table = rhs.__table;
+				return *this;
+			}
+
+# if FT_CXX11
+			unordered_map(unordered_map && rhs)
+			:	__table(std::move(rhs.__table))
+			{}
+
+			unordered_map & operator=(unordered_map && rhs)
+			{
+				__table = std::move(rhs.__table);
+				return *this;
+			}
+# endif
+
+			~unordered_map() {}
+
+			allocator_type get_allocator() const
+			{
+				return __table.get_allocator();
+			}
+
+			/* counters of the underlying table, zero unless built with FT_STATS (see stats.hpp) */
+			container_stats stats() const
+			{
+				return __table.stats();
+			}
+
+			/* iterators ----------------------------------------------------- */
+			iterator begin()
+			{
+				return __table.begin();
+			}
+			const_iterator begin() const
+			{
+				return __table.begin();
+			}
+			iterator end()
+			{
+				return __table.end();
+			}
+			const_iterator end() const
+			{
+				return __table.end();
+			}
+
+			/* capacity ------------------------------------------------------ */
+			bool empty() const
+			{
+				return __table.empty();
+			}
+			size_type size() const
+			{
+				return __table.size();
+			}
+			size_type max_size() const
+			{
+				return __table.max_size();
+			}
+
+			/* element access ------------------------------------------------ */
+# if FT_CXX11
+			mapped_type & operator[](const key_type & x)
+			{
+				return this->try_emplace(x).first->second;
+			}
+
+			mapped_type & operator[](key_type && x)
+			{
+				return this->try_emplace(std::move(x)).first->second;
+			}
+# else
+			/* one probe, mapped_type() is only built for a missing key */
+			mapped_type & operator[](const key_type & x)
+			{
+				return __table.find_or_insert(x, __make_default(x)).first->second;
+			}
+# endif
+
+			/* if no such element exists, an exception of type std::out_of_range is thrown */
+			mapped_type & at(const key_type & key)
+			{
+				iterator found = this->find(key);
+				if (found == this->end())
+					throw std::out_of_range("no such element");
+				return found->second;
+			}
+
+			const mapped_type & at(const key_type & key) const
+			{
+				const_iterator found = this->find(key);
+				if (found == this->end())
+					throw std::out_of_range("no such element");
+				return found->second;
+			}
+
+			/* modifiers ----------------------------------------------------- */
+			ft::pair<iterator, bool> insert(const value_type & x)
+			{
+				return __table.insert(x);
+			}
+
+			/* the hint is ignored, a probe does not start from a position */
+			iterator insert(const_iterator, const value_type & x)
+			{
+				return __table.insert(x).first;
+			}
+
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				__table.insert(first, last);
+			}
+
+			/* inserts (k, obj), or assigns obj to the mapped value of k */
+# if FT_CXX11
+			template <class M>
+			ft::pair<iterator, bool> insert_or_assign(const key_type & k, M && obj)
+			{
+				ft::pair<iterator, bool> res = __table.find_or_emplace(k, ft::piecewise_construct,
+																k, std::forward<M>(obj));
+				if (!res.second)
+					res.first->second = std::forward<M>(obj);
+				return res;
+			}
+
+			template <class M>
+			ft::pair<iterator, bool> insert_or_assign(key_type && k, M && obj)
+			{
+				ft::pair<iterator, bool> res = __table.find_or_emplace(k, ft::piecewise_construct,
+																std::move(k), std::forward<M>(obj));
+				if (!res.second)
+					res.first->second = std::forward<M>(obj);
+				return res;
+			}
+# else
+			template <class M>
+			ft::pair<iterator, bool> insert_or_assign(const key_type & k, const M & obj)
+			{
+				ft::pair<iterator, bool> res = __table.find_or_insert(k, __make_value<M>(k, obj));
+
+				if (!res.second)
+					res.first->second = obj;
+				return res;
+			}
+# endif
+
+# if FT_CXX11
+			ft::pair<iterator, bool> insert(value_type && x)
+			{
+				return __table.insert(std::move(x));
+			}
+
+			/* anything value_type is constructible from, e.g. pair<Key, T> */
+			template <class P>
+			ft::pair<iterator, bool> insert(P && x)
+			{
+				return __table.emplace(std::forward<P>(x));
+			}
+
+			iterator insert(const_iterator, value_type && x)
+			{
+				return __table.insert(std::move(x)).first;
+			}
+
+			template <class... Args>
+			ft::pair<iterator, bool> emplace(Args &&... args)
+			{
+				return __table.emplace(std::forward<Args>(args)...);
+			}
+
+			template <class... Args>
+			iterator emplace_hint(const_iterator, Args &&... args)
+			{
+				return __table.emplace(std::forward<Args>(args)...).first;
+			}
+
+			/*
+				does nothing, args included, when the key is already there;
+				otherwise the mapped value is built in place from args
+			*/
+			template <class... Args>
+			ft::pair<iterator, bool> try_emplace(const key_type & k, Args &&... args)
+			{
+				return __table.find_or_emplace(k, ft::piecewise_construct,
+											k, std::forward<Args>(args)...);
+			}
+
+			template <class... Args>
+			ft::pair<iterator, bool> try_emplace(key_type && k, Args &&... args)
+			{
+				return __table.find_or_emplace(k, ft::piecewise_construct,
+											std::move(k), std::forward<Args>(args)...);
+			}
+# endif
+
+			void erase(const_iterator pos)
+			{
+				__table.erase(pos);
+			}
+
+			size_type erase(const key_type & x)
+			{
+				return __table.erase(x);
+			}
+
+			void erase(const_iterator first, const_iterator last)
+			{
+				__table.erase(first, last);
+			}
+
+			void swap(unordered_map & rhs)
+			{
+				__table.swap(rhs.__table);
+			}
+
+			void clear()
+			{
+				__table.clear();
+			}
+
+			/* lookup -------------------------------------------------------- */
+			iterator find(const key_type & x)
+			{
+				return __table.find(x);
+			}
+			const_iterator find(const key_type & x) const
+			{
+				return __table.find(x);
+			}
+			size_type count(const key_type & x) const
+			{
+				return __table.count(x);
+			}
+			ft::pair<iterator, iterator> equal_range(const key_type & x)
+			{
+				return __table.equal_range(x);
+			}
+			ft::pair<const_iterator, const_iterator> equal_range(const key_type & x) const
+			{
+				return __table.equal_range(x);
+			}
+
+			/* heterogeneous lookup, only with a transparent hasher and key_equal */
+			template <class K>
+			typename enable_if<is_transparent_hash<hasher, key_equal, K>::value, iterator>::type
+			find(const K & x)
+			{
+				return __table.find(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent_hash<hasher, key_equal, K>::value, const_iterator>::type
+			find(const K & x) const
+			{
+				return __table.find(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent_hash<hasher, key_equal, K>::value, size_type>::type
+			count(const K & x) const
+			{
+				return __table.count(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent_hash<hasher, key_equal, K>::value,
+								ft::pair<iterator, iterator> >::type
+			equal_range(const K & x)
+			{
+				return __table.equal_range(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent_hash<hasher, key_equal, K>::value,
+								ft::pair<const_iterator, const_iterator> >::type
+			equal_range(const K & x) const
+			{
+				return __table.equal_range(x);
+			}
+
+			/* hash policy --------------------------------------------------- */
+			size_type bucket_count() const
+			{
+				return __table.bucket_count();
+			}
+			float load_factor() const
+			{
+				return __table.load_factor();
+			}
+			float max_load_factor() const
+			{
+				return __table.max_load_factor();
+			}
+			void max_load_factor(float ml)
+			{
+				__table.max_load_factor(ml);
+			}
+			void rehash(size_type n)
+			{
+				__table.rehash(n);
+			}
+			void reserve(size_type n)
+			{
+				__table.reserve(n);
+			}
+
+			/* observers ----------------------------------------------------- */
+			hasher hash_function() const
+			{
+				return __table.hash_function();
+			}
+			key_equal key_eq() const
+			{
+				return __table.key_eq();
+			}
+
+		private :
+			/* build the value_type for a missing key, see rbtree::find_or_insert */
+			struct __make_default
+			{
+				const key_type 	& k;
+
+				explicit __make_default(const key_type & key)
+				: k(key)
+				{}
+				value_type operator()() const
+				{
+					return value_type(k, mapped_type());
+				}
+			};
+
+			template <class M>
+			struct __make_value
+			{
+				const key_type 	& k;
+				const M 		& m;
+
+				__make_value(const key_type & key, const M & obj)
+				: k(key), m(obj)
+				{}
+				value_type operator()() const
+				{
+					return value_type(k, m);
+				}
+			};
+
+			table_type		__table;
+	};
+
+	/* same elements, in any order */
+	template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+	bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Allocator> & x,
+					const unordered_map<Key, T, Hash, KeyEqual, Allocator> & y)
+	{
+		typedef typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::const_iterator	const_iterator;
+
+		if (x.size() != y.size())
+			return false;
+		for (const_iterator it = x.begin(); it != x.end(); ++it)
+		{
+			const_iterator found = y.find(it->first);
+
+			if (found == y.end() || !(found->second == it->second))
+				return false;
+		}
+		return true;
+	}
+
+	template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+	bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Allocator> & x,
+					const unordered_map<Key, T, Hash, KeyEqual, Allocator> & y)
+	{
+		return !(x == y);
+	}
+
+	template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+	void swap(	ft::unordered_map<Key, T, Hash, KeyEqual, Allocator> & lhs,
+				ft::unordered_map<Key, T, Hash, KeyEqual, Allocator> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef 	UNORDERED_SET_HPP
+# define 	UNORDERED_SET_HPP
+
+# include <memory>
+# include <functional>
+# include "../utils/utils.hpp"
+# include "../utils/enable_if.hpp"
+# include "../utils/functional.hpp"
+# include "../utils/hash.hpp"
+# include "../utils/swiss_table.hpp"
+
+namespace ft
+{
+	/*
+		Hash set over an open addressing swiss table, see unordered_map.hpp.
+		Keys cannot be modified in place, iterator and const_iterator are the
+		same read-only type
+	*/
+	template <class Key, class Hash = ft::hash<Key>,
+						class KeyEqual = std::equal_to<Key>,
+						class Allocator = std::allocator<Key> >
+	class unordered_set
+	{
+		public :
+			/* typedefs ---------------------------------------------------------- */
+			typedef Key 													key_type;
+			typedef Key 													value_type;
+			typedef std::size_t												size_type;
+			typedef std::ptrdiff_t											difference_type;
+			typedef Hash													hasher;
+			typedef KeyEqual												key_equal;
+			typedef Allocator												allocator_type;
+			typedef value_type & 											reference;
+			typedef const value_type & 										const_reference;
+			typedef typename Allocator::pointer 							pointer;
+			typedef typename Allocator::const_pointer						const_pointer;
+			typedef swiss_table<value_type, hasher, key_equal, allocator_type,
+								ft::identity<value_type> >					table_type;
+			/* iterators --------------------------------------------------------- */
+			typedef typename table_type::const_iterator						iterator;
+			typedef typename table_type::const_iterator						const_iterator;
+
+			/* constructors ------------------------------------------------------ */
+			unordered_set()
+			:	__table()
+			{}
+
+			explicit unordered_set(	size_type bucket_count,
+									const hasher & hash = hasher(),
+									const key_equal & eq = key_equal(),
+									const allocator_type & alloc = allocator_type())
+			:	__table(bucket_count, hash, eq, alloc)
+			{}
+
+			template <class InputIt>
+			unordered_set(	InputIt first, InputIt last, size_type bucket_count = 0,
+							const hasher & hash = hasher(),
+							const key_equal & eq = key_equal(),
+							const allocator_type & alloc = allocator_type())
+			:	__table(bucket_count, hash, eq, alloc)
+			{
+				__table.insert(first, last);
+			}
+
+			unordered_set(const unordered_set & other)
+			:	__table(other.__table)
+			{}
+
+			unordered_set & operator=(const unordered_set & other)
+			{
+				__table = other.__table;
+				return *this;
+			}
+
+# if FT_CXX11
+			unordered_set(unordered_set && other)
+			:	__table(std::move(other.__table))
+			{}
+
+			unordered_set & operator=(unordered_set && other)
+			{
+				__table = std::move(other.__table);
+				return *this;
+			}
+# endif
+
+			~unordered_set() {}
+
+			allocator_type get_allocator() const
+			{
+				return __table.get_allocator();
+			}
+
+			/* counters of the underlying table, zero unless built with FT_STATS (see stats.hpp) */
+			container_stats stats() const
+			{
+				return __table.stats();
+			}
+
+			/* iterators --------------------------------------------------------- */
+			iterator begin() const
+			{
+				return __table.begin();
+			}
+			iterator end() const
+			{
+				return __table.end();
+			}
+
+			/* capacity ---------------------------------------------------------- */
+			bool empty() const
+			{
+				return __table.empty();
+			}
+			size_type size() const
+			{
+				return __table.size();
+			}
+			size_type max_size() const
+			{
+				return __table.max_size();
+			}
+
+			/* modifiers --------------------------------------------------------- */
+			ft::pair<iterator, bool> insert(const value_type & value)
+			{
+				return __table.insert(value);
+			}
+
+			/* the hint is ignored, a probe does not start from a position */
+			iterator insert(const_iterator, const value_type & value)
+			{
+				return __table.insert(value).first;
+			}
+
+			template <class InputIt>
+			void insert(InputIt first, InputIt last)
+			{
+				__table.insert(first, last);
+			}
+
+# if FT_CXX11
+			ft::pair<iterator, bool> insert(value_type && value)
+			{
+				return __table.insert(std::move(value));
+			}
+
+			iterator insert(const_iterator, value_type && value)
+			{
+				return __table.insert(std::move(value)).first;
+			}
+
+			template <class... Args>
+			ft::pair<iterator, bool> emplace(Args &&... args)
+			{
+				return __table.emplace(std::forward<Args>(args)...);
+			}
+
+			template <class... Args>
+			iterator emplace_hint(const_iterator, Args &&... args)
+			{
+				return __table.emplace(std::forward<Args>(args)...).first;
+			}
+# endif
+
+			void erase(const_iterator pos)
+			{
+				__table.erase(pos);
+			}
+
+			size_type erase(const key_type & x)
+			{
+				return __table.erase(x);
+			}
+
+			void erase(const_iterator first, const_iterator last)
+			{
+				__table.erase(first, last);
+			}
+
+			void swap(unordered_set & other)
+			{
+				__table.swap(other.__table);
+			}
+
+			void clear()
+			{
+				__table.clear();
+			}
+
+			/* lookup ------------------------------------------------------------ */
+			iterator find(const key_type & x) const
+			{
+				return __table.find(x);
+			}
+			size_type count(const key_type & x) const
+			{
+				return __table.count(x);
+			}
+			ft::pair<iterator, iterator> equal_range(const key_type & x) const
+			{
+				return __table.equal_range(x);
+			}
+
+			/* heterogeneous lookup, only with a transparent hasher and key_equal */
+			template <class K>
+			typename enable_if<is_transparent_hash<hasher, key_equal, K>::value, iterator>::type
+			find(const K & x) const
+			{
+				return __table.find(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent_hash<hasher, key_equal, K>::value, size_type>::type
+			count(const K & x) const
+			{
+				return __table.count(x);
+			}
+			template <class K>
+			typename enable_if<is_transparent_hash<hasher, key_equal, K>::value,
+								ft::pair<iterator, iterator> >::type
+			equal_range(const K & x) const
+			{
+				return __table.equal_range(x);
+			}
+
+			/* hash policy ------------------------------------------------------- */
+			size_type bucket_count() const
+			{
+				return __table.bucket_count();
+			}
+			float load_factor() const
+			{
+				return __table.load_factor();
+			}
+			float max_load_factor() const
+			{
+				return __table.max_load_factor();
+			}
+			void max_load_factor(float ml)
+			{
+				__table.max_load_factor(ml);
+			}
+			void rehash(size_type n)
+			{
+				__table.rehash(n);
+			}
+			void reserve(size_type n)
+			{
+				__table.reserve(n);
+			}
+
+			/* observers --------------------------------------------------------- */
+			hasher hash_function() const
+			{
+				return __table.hash_function();
+			}
+			key_equal key_eq() const
+			{
+				return __table.key_eq();
+			}
+
+		private :
+
+			table_type		__table;
+	};
+
+	/* same keys, in any order */
+	template <class Key, class Hash, class KeyEqual, class Allocator>
+	bool operator==(const unordered_set<Key, Hash, KeyEqual, Allocator> & lhs,
+					const unordered_set<Key, Hash, KeyEqual, Allocator> & rhs)
+	{
+		typedef typename unordered_set<Key, Hash, KeyEqual, Allocator>::const_iterator	const_iterator;
+
+		if (lhs.size() != rhs.size())
+			return false;
+		for (const_iterator it = lhs.begin(); it != lhs.end(); ++it)
+			if (rhs.find(*it) == rhs.end())
+				return false;
+		return true;
+	}
+
+	template <class Key, class Hash, class KeyEqual, class Allocator>
+	bool operator!=(const unordered_set<Key, Hash, KeyEqual, Allocator> & lhs,
+					const unordered_set<Key, Hash, KeyEqual, Allocator> & rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class Key, class Hash, class KeyEqual, class Allocator>
+	void swap(	ft::unordered_set<Key, Hash, KeyEqual, Allocator> & lhs,
+				ft::unordered_set<Key, Hash, KeyEqual, Allocator> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -3,18 +3,79 @@
 
 # include <memory> 				/* std::allocator */
 # include <algorithm> 			/* std::swap */
+# include <cstring> 			/* std::memcpy */
+# include <stdexcept> 			/* std::length_error */
+# include "../utils/config.hpp"
 # include "../utils/utils.hpp"
 # include "../utils/enable_if.hpp"
+# include "../utils/is_trivially_relocatable.hpp"
+# include "../utils/growth_policy.hpp"
+# include "../utils/reallocate_traits.hpp"
+# include "../utils/stats.hpp"
 # include "../utils/random_access_iterator.hpp"
 
 namespace ft
 {
 
+/* ------------------------------- inline buffer ----------------------------- */
+/*
+	room for N elements inside the vector object itself, where a small_vector
+	keeps its elements until they outgrow it. Aligned for any scalar type. The
+	N = 0 buffer of ft::vector is an empty base and takes no space
+*/
+template <class T, size_t N>
+class vector_buffer
+{
+	protected:
+		T *__inline_data() const
+		{
+			return reinterpret_cast<T *>(const_cast<unsigned char *>(__storage.__bytes));
+		}
+
+	private:
+		union
+		{
+			unsigned char	__bytes[N * sizeof(T)];
+			long double		__align_ld;
+			long long		__align_ll;
+			void			*__align_p;
+		}	__storage;
+};
+
+template <class T>
+class vector_buffer<T, 0>
+{
+	protected:
+		T *__inline_data() const
+		{
+			return NULL;
+		}
+};
+
+/* one element built outside a vector, relocated into it by its bytes */
+template <class T>
+class vector_element : private vector_buffer<T, 1>
+{
+	public:
+		T *get() const
+		{
+			return this->__inline_data();
+		}
+};
+
+/* 
+	GrowthPolicy picks the capacity of every new buffer, see growth_policy.hpp. 
+	InlineCapacity is only set by ft::small_vector (see small_vector.hpp): the 
+	first InlineCapacity elements are stored in the object, the heap is only 
+	used past them 
+*/
 template<
     class T,
-    class Allocator = std::allocator<T>
+    class Allocator = std::allocator<T>,
+	class GrowthPolicy = ft::grow_double,
+	size_t InlineCapacity = 0
 >
-class vector
+class vector : private vector_buffer<T, InlineCapacity>, private stats_slot<stats_vector>
 {
 	public:
 		/* --------------------------- member types -------------------------- */
@@ -26,6 +87,7 @@ class vector
 		typedef typename allocator_type::pointer			pointer;
 		typedef typename allocator_type::const_pointer 		const_pointer;
 		typedef typename allocator_type::difference_type	difference_type; 		/* typedef ptrdiff_t difference_type */
+		typedef GrowthPolicy								growth_policy;
 		
 		/* ---------------------------- iterators ---------------------------- */
 		typedef random_access_it<T>						iterator;
@@ -42,6 +104,10 @@ class vector
 							InputIt last, const allocator_type & alloc = allocator_type());
 		vector(const vector & other);
 		vector &operator=(const vector & other);
+# if FT_CXX11
+		vector(vector && other);
+		vector &operator=(vector && other);
+# endif
 		void assign(size_type n, const_reference value);
 		
 		template <class InputIt>
@@ -72,6 +138,8 @@ class vector
 		const_reference front() const;
 		reference back();
 		const_reference back() const;
+		pointer data();
+		const_pointer data() const;
 
 		/* ---------------------------- capacity ----------------------------- */
 		bool empty() const;
@@ -80,6 +148,7 @@ class vector
 		void resize(size_type count, value_type value = T());
 		size_type capacity() const;
 		void reserve(size_type n);
+		void shrink_to_fit();
 
 		/* ----------------------------- modifiers ---------------------------- */
 		void clear();
@@ -92,103 +161,132 @@ class vector
 		iterator erase(iterator pos);
 		iterator erase(iterator first, iterator last);
 		void push_back(const value_type & value);
+# if FT_CXX11
+		iterator insert(iterator pos, value_type && value);
+		template <class... Args>
+		iterator emplace(iterator pos, Args &&... args);
+		void push_back(value_type && value);
+		template <class... Args>
+		reference emplace_back(Args &&... args);
+# endif
 		void pop_back();
-		void swap(vector<T, allocator_type> & rhs);
+		void swap(vector & rhs);
 
 		/* ----------------------------- allocator ---------------------------- */
 		allocator_type get_allocator() const;
 
+		/* ------------------------------- stats ------------------------------ */
+		/* counters of this vector, zero unless built with FT_STATS (see stats.hpp) */
+		container_stats stats() const;
+
 		private:
+			bool __is_inline() const;
+			pointer __allocate(size_type n);
+			void __deallocate(pointer arr, size_type cap);
+			size_type __next_capacity(size_type needed) const;
+			bool __can_reallocate() const;
+			void __reallocate(size_type new_cap);
+			void __relocate_into(pointer new_arr, size_type new_cap, size_type idx, size_type count);
+			void __rotate_in(size_type idx, size_type count);
+			void __swap_elements(pointer a, pointer b);
+
 			allocator_type 	__alloc; 		/* allocator */
 			size_t			__size;
 			size_type 		__capacity; 	/* the total number of elements that the vector can hold without requiring reallocation */
 			pointer			__arr; 			/* pointer to the first element */
 };
 
-template <class T, class Alloc>
-vector<T, Alloc>::vector()
+/* 
+	a vector only points to its heap buffer, moving its bytes is enough. Not a 
+	small_vector, whose data may point into itself, nor a vector that the 
+	stats registry links to by address 
+*/
+template <class T, class Alloc, class G>
+struct is_trivially_relocatable< vector<T, Alloc, G, 0> >
+{
+	static const bool value = !FT_STATS;
+};
+
+template <class T, class Alloc, class G, size_t N>
+vector<T, Alloc, G, N>::vector()
 :	__alloc(allocator_type()),
 	__size(0),
-	__capacity(__size),
-	__arr(NULL)
+	__capacity(N),
+	__arr(this->__inline_data())
 {}
 
-template <class T, class Alloc>
-vector<T, Alloc>::vector(const allocator_type & alloc)
+template <class T, class Alloc, class G, size_t N>
+vector<T, Alloc, G, N>::vector(const allocator_type & alloc)
 : 	__alloc(alloc),
 	__size(0),
-	__capacity(0),
-	__arr(NULL)
+	__capacity(N),
+	__arr(this->__inline_data())
 {}
 
-template <class T, class Alloc>
-vector<T, Alloc>::vector(	size_type count,
+template <class T, class Alloc, class G, size_t N>
+vector<T, Alloc, G, N>::vector(	size_type count,
 							const_reference value,
 							const allocator_type& alloc)
 : 	__alloc(alloc),
 	__size(count),
-	__capacity(count)
+	__capacity(count > N ? G::fit(count, sizeof(T)) : N)
 {
-	size_type	i;
+	size_type	i = 0;
 
-	__arr = __alloc.allocate(__capacity);
+	__arr = count > N ? __allocate(__capacity) : this->__inline_data();
 	/* strong exception guarantee */
 	try
 	{
-		for (size_type i = 0; i < __size; ++i)
+		for (; i < __size; ++i)
 			__alloc.construct(&__arr[i], value);   
 	}
 	catch (...)
 	{
 		for (; i > 0; --i)
 			__alloc.destroy(&__arr[i - 1]);
-		__alloc.deallocate(__arr, __capacity);
+		__deallocate(__arr, __capacity);
 		throw  ;
 	}	
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class G, size_t N>
 template <class InputIt>
-vector<T, Alloc>::vector(	typename enable_if<is_iterator<InputIt>::value, 
+vector<T, Alloc, G, N>::vector(	typename enable_if<is_iterator<InputIt>::value, 
 											InputIt>::type first, 
 											InputIt last, 
 											const allocator_type & alloc)
 :   __alloc(alloc)
 {
-	size_type 	i;
-	InputIt 	tmp(first);
+	size_type 	i = 0;
 
-	__size = 0;
-	while (*tmp != *last)
-	{
-		tmp++;
-		__size++;
-	}
-	__capacity = __size;
-	__arr = __alloc.allocate(__capacity);
+	__size = ft::do_distance(first, last);
+	__capacity = __size > N ? G::fit(__size, sizeof(T)) : N;
+	__arr = __size > N ? __allocate(__capacity) : this->__inline_data();
 	try
 	{
-		for (i = 0; *first != *last; ++i, first++)
+		for (; first != last; ++i, first++)
 			__alloc.construct(&__arr[i], *first);
 	}
 	catch	(...)
 	{
 		for (; i > 0; --i)
 			__alloc.destroy(&__arr[i - 1]);
-		__alloc.deallocate(__arr, __capacity);
+		__deallocate(__arr, __capacity);
 		throw  ;
 	}
 }
 
-template <class T, class Alloc>
-vector<T, Alloc>::vector(const vector &other)
-:	__alloc(other.__alloc),
+/* the copy keeps the capacity of other, unless its elements fit inline */
+template <class T, class Alloc, class G, size_t N>
+vector<T, Alloc, G, N>::vector(const vector &other)
+:	stats_slot<stats_vector>(),
+	__alloc(other.__alloc),
 	__size(other.__size),
-	__capacity(other.__capacity)
+	__capacity(other.__size > N ? other.__capacity : N)
 {
-	if (__capacity)
-		__arr = __alloc.allocate(__capacity);
 	size_type i;
+
+	__arr = other.__size > N ? __allocate(__capacity) : this->__inline_data();
 	/* strong exception guarantee */
 	try
 	{
@@ -199,23 +297,37 @@ vector<T, Alloc>::vector(const vector &other)
 	{
 		for (; i > 0; --i)
 			__alloc.destroy(&__arr[i - 1]);
-		__alloc.deallocate(__arr, __capacity);
+		__deallocate(__arr, __capacity);
 		throw  ;
 	}
 }
 
-template <class T, class Alloc>
-vector<T, Alloc> &vector<T, Alloc>::operator=(const vector &other)
+/* 
+	strong exception guarantee: the copy is built in a new buffer, or in the 
+	inline one when it is free, before the old elements are destroyed. When 
+	both vectors fit inline the elements are replaced in place, and a throwing 
+	copy leaves the ones copied so far 
+*/
+template <class T, class Alloc, class G, size_t N>
+vector<T, Alloc, G, N> &vector<T, Alloc, G, N>::operator=(const vector &other)
 {
 	if (this == &other)
 		return *this;
 
 	T *tmp;
 	size_type i;
+	size_type new_cap;
 
+	if (other.__size <= N && __is_inline())
+	{
+		clear();
+		for (; __size < other.__size; ++__size)
+			__alloc.construct(&__arr[__size], other.__arr[__size]);
+		return *this;
+	}
+	new_cap = other.__size > N ? other.__capacity : N;
 	/* may throw std::bad__alloc and exit */
-	tmp = __alloc.allocate(other.__capacity); 
-	/* strong exception guarantee */
+	tmp = other.__size > N ? __allocate(new_cap) : this->__inline_data(); 
 	try
 	{
 		for (i = 0; i < other.__size; ++i)
@@ -225,38 +337,91 @@ vector<T, Alloc> &vector<T, Alloc>::operator=(const vector &other)
 	{
 		for (; i > 0; --i)
 			__alloc.destroy(&tmp[i - 1]);
-		__alloc.deallocate(tmp, other.__capacity);
+		__deallocate(tmp, new_cap);
 		throw  ;
 	}
-	for (size_type i = 0; i < __size; ++i)
-		__alloc.destroy(&__arr[i]);
-	if (__capacity)
-		__alloc.deallocate(__arr, __capacity);
+	clear();
+	__deallocate(__arr, __capacity);
 	__size = other.__size;
-	__capacity = other.__capacity;
+	__capacity = new_cap;
 	__arr = tmp;
 	return *this;
 }
 
-template <class T, class Alloc>
-vector<T, Alloc>::~vector()
+# if FT_CXX11
+/* 
+	steals the buffer, other is left empty. Inline elements cannot be stolen, 
+	they are moved one by one, and so are the elements of a buffer that other's 
+	allocator owns when the allocators compare unequal (pmr allocators on two 
+	resources): they move into memory from this vector's own allocator 
+*/
+template <class T, class Alloc, class G, size_t N>
+vector<T, Alloc, G, N>::vector(vector &&other)
+:	__alloc(other.__alloc),
+	__size(0),
+	__capacity(N),
+	__arr(this->__inline_data())
+{
+	*this = std::move(other);
+}
+
+template <class T, class Alloc, class G, size_t N>
+vector<T, Alloc, G, N> &vector<T, Alloc, G, N>::operator=(vector &&other)
 {
+	if (this == &other)
+		return *this;
+
 	clear();
-	if (__capacity)
-		__alloc.deallocate(__arr, __capacity);
+	if (other.__is_inline() || !(__alloc == other.__alloc))
+	{
+		if (other.__is_inline() && !__is_inline())
+		{
+			__deallocate(__arr, __capacity);
+			__arr = this->__inline_data();
+			__capacity = N;
+		}
+		reserve(other.__size);
+		for (; __size < other.__size; ++__size)
+			::new (static_cast<void *>(__arr + __size)) value_type(std::move(other.__arr[__size]));
+		other.clear();
+		return *this;
+	}
+	__deallocate(__arr, __capacity);
+	__size = other.__size;
+	__capacity = other.__capacity;
+	__arr = other.__arr;
+	other.__size = 0;
+	other.__capacity = N;
+	other.__arr = other.__inline_data();
+	return *this;
+}
+# endif
+
+template <class T, class Alloc, class G, size_t N>
+vector<T, Alloc, G, N>::~vector()
+{
+	clear();
+	__deallocate(__arr, __capacity);
 }
 
-template <class T, class Alloc>
-void vector<T, Alloc>::assign(size_type n, const_reference value)
+/* strong guarantee when a new buffer is needed, basic otherwise */
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::assign(size_type n, const_reference value)
 {
 	T 			*tmp;
-	size_type 	i;
+	size_type 	i, new_cap;
 
-	if (n > __capacity)
-		tmp = __alloc.allocate(n);
+	if (n <= __capacity)
+	{
+		clear();
+		for (; __size < n; ++__size)
+			__alloc.construct(&__arr[__size], value);
+		return ;
+	}
+	new_cap = G::fit(n, sizeof(T));
+	tmp = __allocate(new_cap);
 	try
 	{
-		/* strong exception guarantee */
 		for (i = 0; i < n; ++i)
 			__alloc.construct(&tmp[i], value);
 	}
@@ -264,38 +429,34 @@ void vector<T, Alloc>::assign(size_type n, const_reference value)
 	{
 		for (; i > 0; --i)
 			__alloc.destroy(&tmp[i - 1]);
-		__alloc.deallocate(tmp, n);
+		__alloc.deallocate(tmp, new_cap);
 		throw ;
 	}
-	for (i = 0; i < __size; ++i)
-		__alloc.destroy(&__arr[i]);
-	__alloc.deallocate(__arr, __capacity);
+	clear();
+	__deallocate(__arr, __capacity);
 	__size = n;
-	if (n > __capacity)
-		__capacity = __size;
+	__capacity = new_cap;
 	__arr = tmp;
 }
 
-template <class T, class Alloc> 
+template <class T, class Alloc, class G, size_t N> 
 template <class InputIt>
-void vector<T, Alloc>::assign(typename enable_if<is_iterator<InputIt>::value, InputIt>::type first, 
+void vector<T, Alloc, G, N>::assign(typename enable_if<is_iterator<InputIt>::value, InputIt>::type first, 
 						InputIt last)
 {
-	size_type n = 0;
-	InputIt t(first);
+	size_type 	n = ft::do_distance(first, last);
 	T 			*tmp;
-	size_type 	i;
+	size_type 	i, new_cap;
 
-	while (t != last)
+	if (n <= __capacity)
 	{
-		t++;
-		n++;
+		clear();
+		for (; __size < n; ++__size, ++first)
+			__alloc.construct(&__arr[__size], *first);
+		return ;
 	}
-
-	if (n > __capacity)
-		tmp = __alloc.allocate(n);
-	else
-		tmp = __alloc.allocate(__capacity);
+	new_cap = G::fit(n, sizeof(T));
+	tmp = __allocate(new_cap);
 	try
 	{
 		for (i = 0; i < n; ++i, first++)
@@ -305,81 +466,141 @@ void vector<T, Alloc>::assign(typename enable_if<is_iterator<InputIt>::value, In
 	{
 		for (; i > 0; --i)
 			__alloc.destroy(&tmp[i - 1]);
-		__alloc.deallocate(tmp, n);
+		__alloc.deallocate(tmp, new_cap);
 		throw  ;
 	}
-	for (i = 0; i < __size; ++i)
-		__alloc.destroy(&__arr[i]);
-	__alloc.deallocate(__arr, __capacity);
+	clear();
+	__deallocate(__arr, __capacity);
 	__size = n;
-	if (n > __capacity)
-		__capacity = __size;
+	__capacity = new_cap;
 	__arr = tmp;
 }
 
+/* true when the elements are in the inline buffer of a small_vector */
+template <class T, class Alloc, class G, size_t N>
+bool vector<T, Alloc, G, N>::__is_inline() const
+{
+	return N && __arr == this->__inline_data();
+}
+
+/* capacity of the buffer that will hold needed elements, from the growth policy */
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::size_type 
+				vector<T, Alloc, G, N>::__next_capacity(typename vector<T, Alloc, G, N>::size_type needed) const
+{
+	size_type new_cap;
+
+	if (needed > this->max_size())
+		throw std::length_error("Unable to allocate");
+	new_cap = G::grow(__capacity, needed, sizeof(T));
+	return new_cap > this->max_size() ? this->max_size() : new_cap;
+}
+
+/* 
+	a heap buffer of trivially relocatable elements is resized by the allocator 
+	itself when it can (see reallocate_traits.hpp): in place, or remapped 
+	without copying the elements 
+*/
+template <class T, class Alloc, class G, size_t N>
+bool vector<T, Alloc, G, N>::__can_reallocate() const
+{
+	return reallocate_traits<allocator_type>::value && is_trivially_relocatable<value_type>::value 
+			&& __capacity && !__is_inline();
+}
+
+/* strong guarantee: if the allocator throws, the old buffer is untouched */
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::__reallocate(typename vector<T, Alloc, G, N>::size_type new_cap)
+{
+	__arr = reallocate_traits<allocator_type>::reallocate(__alloc, __arr, __capacity, new_cap);
+	__capacity = new_cap;
+	this->__stat_allocation(new_cap * sizeof(T));
+	this->__stat_reallocation();
+}
+
+/* every buffer of the vector comes from here */
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::pointer 
+				vector<T, Alloc, G, N>::__allocate(typename vector<T, Alloc, G, N>::size_type n)
+{
+	pointer arr = __alloc.allocate(n);
+
+	this->__stat_allocation(n * sizeof(T));
+	return arr;
+}
+
+/* frees a buffer of cap elements, unless it is the inline one */
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::__deallocate(	typename vector<T, Alloc, G, N>::pointer arr, 
+										typename vector<T, Alloc, G, N>::size_type cap)
+{
+	if (cap && arr != this->__inline_data())
+		__alloc.deallocate(arr, cap);
+}
+
 /* --------------------------------------------------------------------------- */
-template <class T, class Alloc> 
-typename vector<T, Alloc>::iterator vector<T, Alloc>::begin()
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::iterator vector<T, Alloc, G, N>::begin()
 {
 	return iterator(__arr);
 }
 
-template <class T, class Alloc> 
-typename vector<T, Alloc>::const_iterator vector<T, Alloc>::begin() const
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::const_iterator vector<T, Alloc, G, N>::begin() const
 {
 	return const_iterator(__arr);
 }
 
-template <class T, class Alloc> 
-typename vector<T, Alloc>::iterator vector<T, Alloc>::end()
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::iterator vector<T, Alloc, G, N>::end()
 {
 	return iterator(__arr + __size);
 }
 
-template <class T, class Alloc> 
-typename vector<T, Alloc>::const_iterator vector<T, Alloc>::end() const
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::const_iterator vector<T, Alloc, G, N>::end() const
 {
 	return const_iterator(__arr + __size);
 }
 
 /* --------------------------------------------------------------------------- */
-template <class T, class Alloc>
-typename vector<T, Alloc>::reverse_iterator  vector<T, Alloc>::rbegin()
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::reverse_iterator  vector<T, Alloc, G, N>::rbegin()
 {
 	return reverse_iterator(this->end());
 }
 
-template <class T, class Alloc>
-typename vector<T, Alloc>::const_reverse_iterator 	vector<T, Alloc>::rbegin() const
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::const_reverse_iterator 	vector<T, Alloc, G, N>::rbegin() const
 {
 	return const_reverse_iterator(this->end());
 }
 
-template <class T, class Alloc>
-typename vector<T, Alloc>::reverse_iterator 	vector<T, Alloc>::rend()
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::reverse_iterator 	vector<T, Alloc, G, N>::rend()
 {
 	return reverse_iterator(this->begin());
 }
 
-template <class T, class Alloc> 
-typename vector<T, Alloc>::const_reverse_iterator 	vector<T, Alloc>::rend() const
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::const_reverse_iterator 	vector<T, Alloc, G, N>::rend() const
 {
 	return const_reverse_iterator(this->begin());
 }
 
 /* --------------------------------------------------------------------------- */
-template <class T, class Alloc>
-typename vector<T, Alloc>::reference 
-		vector<T, Alloc>::at(typename vector<T, Alloc>::size_type pos)
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::reference 
+		vector<T, Alloc, G, N>::at(typename vector<T, Alloc, G, N>::size_type pos)
 {
 	if (!(pos < __size))
 		throw std::out_of_range("Index out of range");
 	return __arr[pos];
 }
 
-template <class T, class Alloc>
-typename vector<T, Alloc>::const_reference 
-		vector<T, Alloc>::at(typename vector<T, Alloc>::size_type pos) const
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::const_reference 
+		vector<T, Alloc, G, N>::at(typename vector<T, Alloc, G, N>::size_type pos) const
 {
 	if (!(pos < __size))
 		throw std::out_of_range("Index out of range");
@@ -387,70 +608,83 @@ typename vector<T, Alloc>::const_reference
 }
 
 /* accessing a nonexistent element through operator[] is undefined behavior */
-template <class T, class Alloc>
-typename vector<T, Alloc>::reference 
-		vector<T, Alloc>::operator[](typename vector<T, Alloc>::size_type pos)
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::reference 
+		vector<T, Alloc, G, N>::operator[](typename vector<T, Alloc, G, N>::size_type pos)
 {
 	if (!(pos < __size))
 		throw std::out_of_range("Index out of range");
 	return __arr[pos];
 }
 
-template <class T, class Alloc> 
-typename vector<T, Alloc>::const_reference 
-		vector<T, Alloc>::operator[](typename vector<T, Alloc>::size_type pos) const
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::const_reference 
+		vector<T, Alloc, G, N>::operator[](typename vector<T, Alloc, G, N>::size_type pos) const
 {
 	if (!(pos < __size))
 		throw std::out_of_range("Index out of range");
 	return __arr[pos];
 }
 
-template <class T, class Alloc>
-typename vector<T, Alloc>::reference vector<T, Alloc>::front()
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::reference vector<T, Alloc, G, N>::front()
 {
 	return __arr[0];
 }
 
-template <class T, class Alloc>
-typename vector<T, Alloc>::const_reference vector<T, Alloc>::front() const
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::const_reference vector<T, Alloc, G, N>::front() const
 {
 	return __arr[0];
 }
 
-template <class T, class Alloc>
-typename vector<T, Alloc>::reference vector<T, Alloc>::back()
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::reference vector<T, Alloc, G, N>::back()
 {
 	return __arr[__size - 1];
 }
 
-template <class T, class Alloc>
-typename vector<T, Alloc>::const_reference vector<T, Alloc>::back() const
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::const_reference vector<T, Alloc, G, N>::back() const
 {
 	return __arr[__size - 1];
 }
 
+/* the underlying array, NULL when nothing was ever allocated */
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::pointer vector<T, Alloc, G, N>::data()
+{
+	return __arr;
+}
+
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::const_pointer vector<T, Alloc, G, N>::data() const
+{
+	return __arr;
+}
+
 /* --------------------------------------------------------------------------- */
-template <class T, class Alloc> 
-bool vector<T, Alloc>::empty() const
+template <class T, class Alloc, class G, size_t N>
+bool vector<T, Alloc, G, N>::empty() const
 {
 	return __size == 0;
 }
 
-template <class T, class Alloc>
-typename vector<T, Alloc>::size_type vector<T, Alloc>::size() const
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::size_type vector<T, Alloc, G, N>::size() const
 {
 	return end() - begin();
 }
 
 /* returns the maximum number of elements the container is able to hold due to system */
-template <class T, class Alloc>
-typename vector<T, Alloc>::size_type vector<T, Alloc>::max_size() const
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::size_type vector<T, Alloc, G, N>::max_size() const
 {
 	return __alloc.max_size();
 }
 
-template <class T, class Alloc>
-void vector<T, Alloc>::resize(typename vector<T, Alloc>::size_type count, T value)
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::resize(typename vector<T, Alloc, G, N>::size_type count, T value)
 {
 	size_type tmp;
 	size_type i;
@@ -479,52 +713,188 @@ void vector<T, Alloc>::resize(typename vector<T, Alloc>::size_type count, T valu
 	}
 }
 
-template <class T, class Alloc>
-typename vector<T, Alloc>::size_type vector<T, Alloc>::capacity() const
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::size_type vector<T, Alloc, G, N>::capacity() const
 {
 	return __capacity;
 }
 
 /* increases the capacity of the vector to a value that's greater or equal to new_cap 
 if new_cap is greater than the current capacity(), new storage is allocated, otherwise the function does nothing */
-template <class T, class Alloc>
-void vector<T, Alloc>::reserve(typename vector<T, Alloc>::size_type n)
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::reserve(typename vector<T, Alloc, G, N>::size_type n)
 {
 	if (n > this->max_size())
 		throw std::length_error("Unable to allocate");
 	if (n <= __capacity)
 		return ;
 
-	T			*tmp;
-	size_type 	i;
+	n = G::fit(n, sizeof(T));
+	if (__can_reallocate())
+		__reallocate(n);
+	else
+		__relocate_into(__allocate(n), n, __size, 0);
+}
 
-	tmp = __alloc.allocate(n);
-	try
+/* 
+	moves the elements to a buffer of fit(size()) elements, or back to the 
+	inline buffer of a small_vector, and frees the old one. Strong guarantee 
+*/
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::shrink_to_fit()
+{
+	size_type new_cap;
+
+	if (__size <= N)
+	{
+		if (!__is_inline())
+			__relocate_into(this->__inline_data(), N, __size, 0);
+		return ;
+	}
+	new_cap = G::fit(__size, sizeof(T));
+	if (new_cap >= __capacity)
+		return ;
+	if (__can_reallocate())
+		__reallocate(new_cap);
+	else
+		__relocate_into(__allocate(new_cap), new_cap, __size, 0);
+}
+
+/* 
+	moves every element to new_arr, which already holds count new elements at 
+	idx, then releases the old buffer. Relocatable types are moved with memcpy; 
+	the others are copied (or moved, when their move constructor cannot throw) 
+	first and only destroyed once all copies succeeded, otherwise new_arr (new 
+	elements included) is destroyed and freed 
+*/
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::__relocate_into(	typename vector<T, Alloc, G, N>::pointer new_arr, 
+										typename vector<T, Alloc, G, N>::size_type new_cap,
+										typename vector<T, Alloc, G, N>::size_type idx, 
+										typename vector<T, Alloc, G, N>::size_type count)
+{
+	size_type i, j;
+
+	if (is_trivially_relocatable<value_type>::value)
+	{
+		if (idx)
+			std::memcpy(static_cast<void *>(new_arr), static_cast<const void *>(__arr), 
+						idx * sizeof(value_type));
+		if (__size > idx)
+			std::memcpy(static_cast<void *>(new_arr + idx + count), static_cast<const void *>(__arr + idx), 
+						(__size - idx) * sizeof(value_type));
+	}
+	else
 	{
+		i = 0;
+		j = idx;
+		try
+		{
+			for (; i < idx; ++i)
+				__alloc.construct(&new_arr[i], FT_MOVE_IF_NOEXCEPT(__arr[i]));
+			for (; j < __size; ++j)
+				__alloc.construct(&new_arr[j + count], FT_MOVE_IF_NOEXCEPT(__arr[j]));
+		}
+		catch (...)
+		{
+			for (; i > 0; --i)
+				__alloc.destroy(&new_arr[i - 1]);
+			for (; j > idx; --j)
+				__alloc.destroy(&new_arr[j - 1 + count]);
+			for (j = idx; j < idx + count; ++j)
+				__alloc.destroy(&new_arr[j]);
+			__deallocate(new_arr, new_cap);
+			throw ;
+		}
 		for (i = 0; i < __size; ++i)
-			__alloc.construct(&tmp[i], __arr[i]);
+			__alloc.destroy(&__arr[i]);
 	}
-	catch	(...)
+	if (__capacity)
+		this->__stat_reallocation();
+	__deallocate(__arr, __capacity);
+	__capacity = new_cap;
+	__arr = new_arr;
+}
+
+/* 
+	the count elements just constructed at the end, [size, size + count), are 
+	moved to idx and the tail [idx, size) is shifted behind them. The new 
+	elements are built in their final buffer before anything moves, so a value 
+	referring to an element of the vector is read while it is still intact. 
+	If an assignment throws, the slots past size are destroyed: the vector 
+	keeps its size elements, in an unspecified order 
+*/
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::__rotate_in(	typename vector<T, Alloc, G, N>::size_type idx, 
+									typename vector<T, Alloc, G, N>::size_type count)
+{
+	size_type i, j;
+
+	if (idx == __size || count == 0)
+		return ;
+	if (count == 1 && is_trivially_relocatable<value_type>::value)
 	{
-		for (; i > 0; --i)
-			__alloc.destroy(&tmp[i - 1]);
-		__alloc.deallocate(tmp, n);
-		throw  ;
+		unsigned char buf[sizeof(value_type)];
+
+		std::memcpy(buf, static_cast<const void *>(__arr + __size), sizeof(value_type));
+		std::memmove(static_cast<void *>(__arr + idx + 1), static_cast<const void *>(__arr + idx), 
+						(__size - idx) * sizeof(value_type));
+		std::memcpy(static_cast<void *>(__arr + idx), buf, sizeof(value_type));
+		return ;
+	}
+	try
+	{
+		if (count == 1)
+		{
+			value_type tmp(FT_MOVE(__arr[__size]));
+
+			for (i = __size; i > idx; --i)
+				__arr[i] = FT_MOVE(__arr[i - 1]);
+			__arr[idx] = FT_MOVE(tmp);
+			return ;
+		}
+		/* rotation by three reversals */
+		for (i = idx, j = __size - 1; i < j; ++i, --j)
+			__swap_elements(__arr + i, __arr + j);
+		for (i = __size, j = __size + count - 1; i < j; ++i, --j)
+			__swap_elements(__arr + i, __arr + j);
+		for (i = idx, j = __size + count - 1; i < j; ++i, --j)
+			__swap_elements(__arr + i, __arr + j);
+	}
+	catch (...)
+	{
+		for (i = count; i > 0; --i)
+			__alloc.destroy(&__arr[__size + i - 1]);
+		throw ;
+	}
+}
+
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::__swap_elements(	typename vector<T, Alloc, G, N>::pointer a, 
+										typename vector<T, Alloc, G, N>::pointer b)
+{
+	if (is_trivially_relocatable<value_type>::value)
+	{
+		unsigned char buf[sizeof(value_type)];
+
+		std::memcpy(buf, static_cast<const void *>(a), sizeof(value_type));
+		std::memcpy(static_cast<void *>(a), static_cast<const void *>(b), sizeof(value_type));
+		std::memcpy(static_cast<void *>(b), buf, sizeof(value_type));
+	}
+	else
+	{
+		value_type tmp(FT_MOVE(*a));
+
+		*a = FT_MOVE(*b);
+		*b = FT_MOVE(tmp);
 	}
-	
-	for (size_type i = 0; i < __size; ++i)
-		__alloc.destroy(&__arr[i]);
-	__alloc.deallocate(__arr, __capacity);
-	
-	__capacity = n;
-	__arr = tmp;
 }
 
 /* --------------------------------------------------------------------------- */
 
 /* Erases all elements from the container. After this call, size() returns zero */
-template <class T, class Alloc>
-void vector<T, Alloc>::clear()
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::clear()
 {
 	for (unsigned int i = 0; i < __size; ++i)
 		__alloc.destroy(&__arr[i]);
@@ -538,391 +908,345 @@ void vector<T, Alloc>::clear()
 	otherwise, only the iterators and references before the insertion point remain valid. 
 	the past-the-end iterator is also invalidated
 */
-template <class T, class Alloc>
-typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(typename vector<T, Alloc>::iterator pos, 
-								const typename vector<T, Alloc>::value_type & value)
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::iterator vector<T, Alloc, G, N>::insert(typename vector<T, Alloc, G, N>::iterator pos, 
+								const typename vector<T, Alloc, G, N>::value_type & value)
 {
-	size_type 	i, new_cap;
+	size_type 	new_cap;
 	T 			*new__arr;
 
 	size_type idx = pos - begin();
 	if (__size + 1 > __capacity)
 	{
-		new_cap = __capacity * 2;
-		new__arr = __alloc.allocate(new_cap);
-		for (i = 0; i < idx; ++i)
-		{
-			try
-			{
-				__alloc.construct(&new__arr[i], __arr[i]);
-			}
-			catch (...)
-			{
-				for (; i > 0; --i)
-					__alloc.destroy(&new__arr[i]);
-				__alloc.deallocate(new__arr, new_cap);
-				throw ;
-			}
-			__alloc.destroy(&__arr[i]);
-		}
+		new_cap = __next_capacity(__size + 1);
+		new__arr = __allocate(new_cap);
+		/* value may live in the old buffer, construct it before moving */
 		try
 		{
-			__alloc.construct(&new__arr[i], value);
+			__alloc.construct(&new__arr[idx], value);
 		}
 		catch (...)
 		{
+			__alloc.deallocate(new__arr, new_cap);
 			throw ;
 		}
-		for (; i < __size; i++)
-		{
-			try
-			{
-				__alloc.construct(&new__arr[i + 1], __arr[i]);
-			}
-			catch (...)
-			{
-				for (; i > 0; --i)
-					__alloc.destroy(&new__arr[i - 1]);
-				__alloc.deallocate(new__arr, new_cap);
-			}
-			__alloc.destroy(&__arr[i]);
-		}
-		__alloc.deallocate(__arr, __capacity);
-		__capacity *= 2;
+		__relocate_into(new__arr, new_cap, idx, 1);
 		__size++;
-		__arr = new__arr;
 	}
 	else
 	{
-		size_type x =__size;
-		for (; x != idx; x--)
-		{
-			try
-			{
-				__alloc.construct(&__arr[x], __arr[x - 1]);
-			}
-			catch (...)
-			{
-				for (; x < __size; ++x)
-					__alloc.destroy(&__arr[x]);
-				throw ;
-			}
-			__alloc.destroy(&__arr[x - 1]);
-		}
+		__alloc.construct(&__arr[__size], value);
+		__rotate_in(idx, 1);
+		__size++;
+	}
+	return __arr + idx;
+}
+
+# if FT_CXX11
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::iterator vector<T, Alloc, G, N>::insert(typename vector<T, Alloc, G, N>::iterator pos, 
+								typename vector<T, Alloc, G, N>::value_type && value)
+{
+	return emplace(pos, std::move(value));
+}
+
+/* 
+	allocator::construct only takes one argument before C++11 and is gone in 
+	C++20, the emplace family constructs with placement new 
+*/
+template <class T, class Alloc, class G, size_t N>
+template <class... Args>
+typename vector<T, Alloc, G, N>::iterator vector<T, Alloc, G, N>::emplace(typename vector<T, Alloc, G, N>::iterator pos, 
+								Args &&... args)
+{
+	size_type 	new_cap;
+	T 			*new__arr;
+
+	size_type idx = pos - begin();
+	if (__size + 1 > __capacity)
+	{
+		new_cap = __next_capacity(__size + 1);
+		new__arr = __allocate(new_cap);
 		try
 		{
-			__alloc.construct(&__arr[x], value);
+			::new (static_cast<void *>(new__arr + idx)) value_type(std::forward<Args>(args)...);
 		}
 		catch (...)
 		{
+			__alloc.deallocate(new__arr, new_cap);
 			throw ;
 		}
-		__size++;
+		__relocate_into(new__arr, new_cap, idx, 1);
 	}
+	else
+	{
+		::new (static_cast<void *>(__arr + __size)) value_type(std::forward<Args>(args)...);
+		__rotate_in(idx, 1);
+	}
+	__size++;
 	return __arr + idx;
 }
+# endif
 
 /* inserts count copies of the value before pos */
-template <class T, class Alloc>
-void vector<T, Alloc>::insert(	typename vector<T, Alloc>::iterator pos, 
-								typename vector<T, Alloc>::size_type count, 
-								const typename vector<T, Alloc>::value_type& value)
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::insert(	typename vector<T, Alloc, G, N>::iterator pos, 
+								typename vector<T, Alloc, G, N>::size_type count, 
+								const typename vector<T, Alloc, G, N>::value_type& value)
 {
 	if (count == 0)
 		return ;
 
 	T 			*tmp;
-	size_type 	new_cap, idx, tmp_idx;
-	size_type 	i, j;
+	size_type 	new_cap, idx;
+	size_type 	i;
 	idx = pos - begin();
 	
 	if (__size + count > __capacity)
 	{
-		new_cap = __capacity * 2 >= __size + count ? __capacity * 2 : __size + count;
+		new_cap = __next_capacity(__size + count);
 
-		tmp = __alloc.allocate(new_cap);
-		try
-		{
-			for (i = 0; i < idx; ++i)
-				__alloc.construct(&tmp[i], __arr[i]);
-		}
-		catch (...)
-		{
-			for (; i > 0; --i)
-				__alloc.destroy(&tmp[i - 1]);
-			__alloc.deallocate(tmp, new_cap);
-			throw ;
-		}
+		tmp = __allocate(new_cap);
 		try
 		{
-			for (j = 0; j < count; ++j, ++i)
-				__alloc.construct(&tmp[i], value);
+			for (i = 0; i < count; ++i)
+				__alloc.construct(&tmp[idx + i], value);
 		}
 		catch (...)
 		{
 			for (; i > 0; --i)
-				__alloc.destroy(&tmp[i - 1]);
+				__alloc.destroy(&tmp[idx + i - 1]);
 			__alloc.deallocate(tmp, new_cap);
 			throw ;
 		}
-		try
-		{
-			for (; idx < __size; ++idx, ++i)
-				__alloc.construct(&tmp[i], __arr[idx]);
-		}
-		catch (...)
-		{
-			for (; i > 0; i--)
-				__alloc.destroy(&tmp[i - 1]);
-			__alloc.deallocate(tmp, new_cap);
-			throw ;
-		}
-		for (i = 0; i < __size; ++i)
-			__alloc.destroy(&__arr[i]);
-		__alloc.deallocate(__arr, __capacity);
-		__capacity = new_cap;
+		__relocate_into(tmp, new_cap, idx, count);
 		__size += count;
-		__arr = tmp;
 		return ;
 	}
 	else
 	{
-		try
-		{
-			for (i = size() - 1; i >= idx; --i) 
-				__alloc.construct(&__arr[i + count], __arr[i]);
-		}
-		catch (...)
-		{
-			for (; idx < i; ++idx)
-				__alloc.destroy(&__arr[idx]);
-			throw ;
-		}
 		try 
 		{
-			tmp_idx = idx;
-			for (i = 0; i < count; ++i, ++tmp_idx) 
-				__alloc.construct(&__arr[tmp_idx], value);
+			for (i = 0; i < count; ++i) 
+				__alloc.construct(&__arr[__size + i], value);
 		} 
 		catch (...)
 		{
-			for (; tmp_idx > idx; --tmp_idx)
-				__alloc.destroy(&__arr[tmp_idx - 1]);
+			for (; i > 0; --i)
+				__alloc.destroy(&__arr[__size + i - 1]);
 			throw ;
 		}
+		__rotate_in(idx, count);
 		__size += count;
 	}
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class G, size_t N>
 template <class InputIt>
-void vector<T, Alloc>::insert(vector<T, Alloc>::iterator pos,
+void vector<T, Alloc, G, N>::insert(vector<T, Alloc, G, N>::iterator pos,
 						typename enable_if<is_iterator<InputIt>::value, InputIt>::type first,
 						InputIt last)
 {
 	size_type count = ft::do_distance(first, last);
-	size_type new_cap, idx, i, tmp_idx;
+	size_type new_cap, idx, i;
 	T *tmp;
 
 	idx = pos - begin();
-	tmp_idx = idx;
 	if (__size + count > __capacity)
 	{
-		new_cap = __capacity * 2 >= __size + count ? __capacity * 2 : __size + count;
-		tmp = __alloc.allocate(new_cap);
-		try
-		{
-			for (i = 0; i < idx; ++i)
-				__alloc.construct(&tmp[i], __arr[i]);
-		}
-		catch (...)
-		{
-			for (; i > 0; --i)
-				__alloc.destroy(&tmp[i - 1]);
-			__alloc.deallocate(tmp, new_cap);
-			throw ;
-		}
+		new_cap = __next_capacity(__size + count);
+		tmp = __allocate(new_cap);
 		try
 		{
-			for (; first < last; ++first, ++i)
-				__alloc.construct(&tmp[i], *first);
+			for (i = 0; i < count; ++i, ++first)
+				__alloc.construct(&tmp[idx + i], *first);
 		}
 		catch (...)
 		{
 			for (; i > 0; --i)
-				__alloc.destroy(&tmp[i - 1]);
+				__alloc.destroy(&tmp[idx + i - 1]);
 			__alloc.deallocate(tmp, new_cap);
 			throw ;
 		}
-		try
-		{
-			for (; idx < __size; ++idx, ++i)
-				__alloc.construct(&tmp[i], __arr[idx]);
-		}
-		catch (...)
-		{
-			for (; i > 0; --i)
-				__alloc.destroy(&tmp[i - 1]);
-			__alloc.deallocate(tmp, new_cap);
-			throw ;
-		}
-		for (i = 0; i < __size; ++i)
-			__alloc.destroy(&__arr[i]);
-		__alloc.deallocate(__arr, __capacity);
-		__capacity = new_cap;
+		__relocate_into(tmp, new_cap, idx, count);
 		__size += count;
-		__arr = tmp;
 	}
 	else
 	{
-
-		for (i = size() - 1; i >= idx; --i)
-		{
-			try
-			{
-				__alloc.construct(&__arr[i + count], __arr[i]);
-			}
-			catch (...) /* handle any type of exception */
-			{
-				for (; idx < i; ++idx)
-					__alloc.destroy(&__arr[idx]);
-				throw ;
-			}
-			__alloc.destroy(&__arr[i]);
-		}
 		try 
 		{
-			for (i = 0; i < count; ++i, ++tmp_idx, first++) 
-				__alloc.construct(&__arr[tmp_idx], *first);
+			for (i = 0; i < count; ++i, first++) 
+				__alloc.construct(&__arr[__size + i], *first);
 		} 
 		catch (...)
 		{
-			for (; tmp_idx > idx; --tmp_idx)
-				__alloc.destroy(&__arr[tmp_idx - 1]);
+			for (; i > 0; --i)
+				__alloc.destroy(&__arr[__size + i - 1]);
 			throw ;
 		}
+		__rotate_in(idx, count);
 		__size += count;
 	}
 }
 
-template <class T, class Alloc>
-typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(typename vector<T, Alloc>::iterator pos)
+/* the tail is shifted down by (move) assignment, the last slots are destroyed */
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::iterator vector<T, Alloc, G, N>::erase(typename vector<T, Alloc, G, N>::iterator pos)
 {
 	size_type idx = pos - begin();
 
-	for (size_type i = idx; i < __size - 1; ++i)
-	{
-		__alloc.destroy(&__arr[i]);
-		try
-		{
-			__alloc.construct(&__arr[i], __arr[i + 1]);
-		}
-		catch	(...)
-		{
-			for (size_type start = idx; start < i; ++start)
-				__alloc.destroy(&__arr[start]);
-			throw ;
-		}
-	}
+	for (size_type i = idx; i + 1 < __size; ++i)
+		__arr[i] = FT_MOVE(__arr[i + 1]);
 	__alloc.destroy(&__arr[__size - 1]);
 	__size -= 1;
 	return iterator(__arr + idx);
 }
 
-template <class T, class Alloc>
-typename vector<T, Alloc>::iterator 
-				vector<T, Alloc>::erase(	typename vector<T, Alloc>::iterator first, 
-											typename vector<T, Alloc>::iterator last)
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::iterator 
+				vector<T, Alloc, G, N>::erase(	typename vector<T, Alloc, G, N>::iterator first, 
+											typename vector<T, Alloc, G, N>::iterator last)
 {
 	size_type idx = first - begin();
 	size_type count = last - first;
-	size_type tmp = idx;
 
-	for (size_type i = 0; i < count; ++i)
-		__alloc.destroy(&__arr[tmp + i]);
+	if (count == 0)
+		return first;
+	for (size_type i = idx; i + count < __size; ++i)
+		__arr[i] = FT_MOVE(__arr[i + count]);
+	for (size_type i = __size - count; i < __size; ++i)
+		__alloc.destroy(&__arr[i]);
 	__size -= count;
-	for (; tmp < __size; ++tmp)
-	{
-		// basic exception guarantee
-		try
-		{
-			__alloc.construct(&__arr[tmp], __arr[tmp + count]);
-		}
-		catch	(...)
-		{
-			for (; tmp >= idx; --tmp)
-				__alloc.destroy(&__arr[tmp]);
-			for (; last != end(); *last++)
-				__alloc.destroy(&__arr[*last]);
-			throw ;
-		}
-		
-		__alloc.destroy(&__arr[tmp + count]);
-	}
 	return iterator(__arr + idx);
 }
 
-template <class T, class Alloc>
-void vector<T, Alloc>::push_back(const typename vector<T, Alloc>::value_type & value)
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::push_back(const typename vector<T, Alloc, G, N>::value_type & value)
 {
 	T 			*tmp;
 	size_type 	new_cap;
-	size_type 	i;
 
-	if (__capacity == 0)
-	{
-		__arr = __alloc.allocate(1);
-		__capacity = 1;
-	}
 	if (__capacity < __size + 1)
 	{
-		new_cap = __capacity * 2;
-		tmp = __alloc.allocate(new_cap);
+		new_cap = __next_capacity(__size + 1);
+		if (__can_reallocate())
+		{
+			vector_element<T> elem;
+
+			/* value may live in the old buffer, copy it aside before resizing */
+			__alloc.construct(elem.get(), value);
+			try
+			{
+				__reallocate(new_cap);
+			}
+			catch	(...)
+			{
+				__alloc.destroy(elem.get());
+				throw  ;
+			}
+			std::memcpy(static_cast<void *>(__arr + __size), static_cast<const void *>(elem.get()),
+						sizeof(value_type));
+			__size += 1;
+			return ;
+		}
+		tmp = __allocate(new_cap);
+		/* value may live in the old buffer, construct it before moving */
 		try
 		{
-			for (i = 0; i < __size; ++i)
-				__alloc.construct(&tmp[i], __arr[i]);
-			__alloc.construct(&tmp[i], value);
+			__alloc.construct(&tmp[__size], value);
 		}
 		catch	(...)
 		{	
-			for (; i > 0; --i)
-				__alloc.destroy(&tmp[i - 1]);
 			__alloc.deallocate(tmp, new_cap);
 			throw  ;
 		}
-		for (i = 0; i < __size; ++i)
-			__alloc.destroy(&__arr[i]);
-		__alloc.deallocate(__arr, __capacity);
-		
+		__relocate_into(tmp, new_cap, __size, 1);
 		__size += 1;
-		__capacity = new_cap;
-		__arr = tmp;
 	}
 	else
 	{
+		__alloc.construct(&__arr[__size], value);
+		__size += 1;
+	}
+}
+
+# if FT_CXX11
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::push_back(typename vector<T, Alloc, G, N>::value_type && value)
+{
+	emplace_back(std::move(value));
+}
+
+template <class T, class Alloc, class G, size_t N>
+template <class... Args>
+typename vector<T, Alloc, G, N>::reference vector<T, Alloc, G, N>::emplace_back(Args &&... args)
+{
+	T 			*tmp;
+	size_type 	new_cap;
+
+	if (__capacity < __size + 1)
+	{
+		new_cap = __next_capacity(__size + 1);
+		if (__can_reallocate())
+		{
+			vector_element<T> elem;
+
+			::new (static_cast<void *>(elem.get())) value_type(std::forward<Args>(args)...);
+			try
+			{
+				__reallocate(new_cap);
+			}
+			catch	(...)
+			{
+				elem.get()->~value_type();
+				throw  ;
+			}
+			std::memcpy(static_cast<void *>(__arr + __size), static_cast<const void *>(elem.get()),
+						sizeof(value_type));
+			return __arr[__size++];
+		}
+		tmp = __allocate(new_cap);
+		/* the arguments may refer to the old buffer, construct before moving */
 		try
 		{
-			__alloc.construct(&__arr[__size], value);
+			::new (static_cast<void *>(tmp + __size)) value_type(std::forward<Args>(args)...);
 		}
 		catch	(...)
-		{
+		{	
+			__alloc.deallocate(tmp, new_cap);
 			throw  ;
 		}
-		__size += 1;
+		__relocate_into(tmp, new_cap, __size, 1);
 	}
+	else
+		::new (static_cast<void *>(__arr + __size)) value_type(std::forward<Args>(args)...);
+	return __arr[__size++];
 }
+# endif
 
-template <class T, class Alloc>
-void vector<T, Alloc>::pop_back()
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::pop_back()
 {
-	__alloc.destroy(&__arr[__size]);
+	__alloc.destroy(&__arr[__size - 1]);
 	__size -= 1; 
 }
 
-template <class T, class Alloc>
-void vector<T, Alloc>::swap(vector<T, allocator_type> & rhs)
+/* 
+	exchanges the buffers, each one stays with the allocator that owns it. When 
+	a side is inline or the allocators compare unequal, the elements are moved 
+	through a temporary instead, into memory of each vector's own allocator 
+*/
+template <class T, class Alloc, class G, size_t N>
+void vector<T, Alloc, G, N>::swap(vector & rhs)
 {
+	if (__is_inline() || rhs.__is_inline() || !(__alloc == rhs.__alloc))
+	{
+		vector tmp(FT_MOVE(*this));
+
+		*this = FT_MOVE(rhs);
+		rhs = FT_MOVE(tmp);
+		return ;
+	}
 	ft::swap(__size, rhs.__size);
 	ft::swap(__capacity, rhs.__capacity);
 	ft::swap(__arr, rhs.__arr);
@@ -930,53 +1254,59 @@ void vector<T, Alloc>::swap(vector<T, allocator_type> & rhs)
 
 /* --------------------------------------------------------------------------- */
 /* returns the allocator associated with the container */
-template <class T, class Alloc>
-typename vector<T, Alloc>::allocator_type vector<T, Alloc>::get_allocator() const
+template <class T, class Alloc, class G, size_t N>
+typename vector<T, Alloc, G, N>::allocator_type vector<T, Alloc, G, N>::get_allocator() const
 {
 	return __alloc;
 }
 
+template <class T, class Alloc, class G, size_t N>
+container_stats vector<T, Alloc, G, N>::stats() const
+{
+	return this->__stats();
+}
+
 /* non-member functions ------------------------------------------------------ */
-template <class value_type, class allocator_type>
-bool operator== (	const vector<value_type, allocator_type> & lhs, 
-					const vector<value_type, allocator_type> & rhs)
+template <class value_type, class allocator_type, class G, size_t N>
+bool operator== (	const vector<value_type, allocator_type, G, N> & lhs, 
+					const vector<value_type, allocator_type, G, N> & rhs)
 {
 	return (lhs.size() == rhs.size()) 
 			&& ft::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class value_type, class allocator_type>
-bool operator!= (	const vector<value_type, allocator_type> & lhs, 
-					const vector<value_type, allocator_type> & rhs)
+template <class value_type, class allocator_type, class G, size_t N>
+bool operator!= (	const vector<value_type, allocator_type, G, N> & lhs, 
+					const vector<value_type, allocator_type, G, N> & rhs)
 {
 	return !(lhs == rhs);
 }
 
-template <class value_type, class allocator_type>
-bool operator< (	const vector<value_type, allocator_type> & lhs, 
-					const vector<value_type, allocator_type> & rhs)
+template <class value_type, class allocator_type, class G, size_t N>
+bool operator< (	const vector<value_type, allocator_type, G, N> & lhs, 
+					const vector<value_type, allocator_type, G, N> & rhs)
 {
 	return ft::lexicographical_compare(	lhs.begin(), lhs.end(), 
 										rhs.begin(), rhs.end());
 }
 
-template <class value_type, class allocator_type>
-bool operator<= (	const vector<value_type, allocator_type> & lhs, 
-					const vector<value_type, allocator_type> & rhs)
+template <class value_type, class allocator_type, class G, size_t N>
+bool operator<= (	const vector<value_type, allocator_type, G, N> & lhs, 
+					const vector<value_type, allocator_type, G, N> & rhs)
 {
 	return !(lhs > rhs);
 }
 
-template <class value_type, class allocator_type>
-bool operator> (	const vector<value_type, allocator_type> & lhs, 
-					const vector<value_type, allocator_type> & rhs)
+template <class value_type, class allocator_type, class G, size_t N>
+bool operator> (	const vector<value_type, allocator_type, G, N> & lhs, 
+					const vector<value_type, allocator_type, G, N> & rhs)
 {
 	return rhs < lhs;
 }
 
-template <class value_type, class allocator_type>
-bool operator>= (	const vector<value_type, allocator_type> & lhs, 
-					const vector<value_type, allocator_type> & rhs)
+template <class value_type, class allocator_type, class G, size_t N>
+bool operator>= (	const vector<value_type, allocator_type, G, N> & lhs, 
+					const vector<value_type, allocator_type, G, N> & rhs)
 {
 	return !(lhs < rhs);
 }
@@ -986,9 +1316,9 @@ bool operator>= (	const vector<value_type, allocator_type> & lhs,
 namespace std
 {
 
-template <class value_type, class allocator_type>
-void swap(	ft::vector<value_type, allocator_type> & lhs, 
-			ft::vector<value_type, allocator_type> & rhs)
+template <class value_type, class allocator_type, class G, size_t N>
+void swap(	ft::vector<value_type, allocator_type, G, N> & lhs, 
+			ft::vector<value_type, allocator_type, G, N> & rhs)
 {
 	lhs.swap(rhs);
 }
@@ -19,52 +19,12 @@ namespace ft
 			typedef typename iterator_traits<T>::pointer				pointer;
 			typedef typename iterator_traits<T>::difference_type		difference_type;
 			typedef tree_iter<Iter, T>									self;
+			/* the node steps to its neighbours, in one load when threaded */
+			typedef typename iterator_traits<Iter>::value_type			node_type;
 
 		private :
 			iterator_type __it;
 
-			iterator_type findMin(iterator_type currElem)
-			{
-				while (currElem && currElem->__left)
-					currElem = currElem->__left;
-				return currElem;
-			}
-
-			iterator_type findMax(iterator_type currElem)
-			{
-				while (currElem && currElem->__right)
-					currElem = currElem->__right;
-				return currElem;
-			}
-
-			iterator_type findPredessor(iterator_type elem)
-			{
-				iterator_type tmp = elem->__parent;
-			
-				if (elem->__left)
-					return findMax(elem->__left);
-				while (tmp && elem == tmp->__left)
-				{
-					elem = tmp;
-					tmp = tmp->__parent;
-				}
-				return (tmp);
-			}
-
-			iterator_type findSuccessor(iterator_type elem)
-			{
-				iterator_type tmp = elem->__parent;
-			
-				if (elem->__right)
-					return findMin(elem->__right);
-				while (tmp && elem == tmp->__right)
-				{
-					elem = tmp;
-					tmp = tmp->__parent;
-				}
-				return (tmp);
-			}
-
 		public :
 
 			/* coplien ------------------------------------------------------- */
@@ -104,23 +64,23 @@ namespace ft
 			self operator++(int)
 			{
 				tree_iter tmp = *this;
-				__it = findSuccessor(__it);
+				__it = node_type::successor(__it);
 				return tmp;
 			}
 			self operator--(int)
 			{
 				tree_iter tmp = *this;
-				__it = findPredessor(__it);
+				__it = node_type::predecessor(__it);
 				return tmp;
 			}
 			self & operator++()
 			{
-				__it = findSuccessor(__it);
+				__it = node_type::successor(__it);
 				return *this;
 			}
 			self & operator--()
 			{
-				__it = findPredessor(__it);
+				__it = node_type::predecessor(__it);
 				return *this;
 			}
 			
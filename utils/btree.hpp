@@ -0,0 +1,1201 @@
+#ifndef 	BTREE_HPP
+# define 	BTREE_HPP
+
+# include <memory>
+# include <functional>
+# include <algorithm>
+# include <limits>
+# include <cstring>
+# include <new>
+# include "config.hpp"
+# include "utils.hpp"
+# include "pair.hpp"
+# include "enable_if.hpp"
+# include "functional.hpp"
+# include "flat_search.hpp"
+# include "is_trivially_destructible.hpp"
+# include "is_trivially_relocatable.hpp"
+# include "btree_iterator.hpp"
+# include "bidirectional_iterator.hpp"
+# include "stats.hpp"
+
+namespace ft
+{
+	/* tree policy of map and set selecting ft::btree, see tree_select.hpp */
+	template <size_t NodeBytes = 512>
+	struct btree_nodes
+	{
+		static const size_t node_bytes = NodeBytes;
+	};
+
+	/* B+ Tree class --------------------------------------------------------- */
+	/*
+		Drop-in alternative to rbtree with the same interface, for large sets
+		where lookups are bound by memory latency. Values live only in the
+		leaves, packed by the dozen into nodes of about NodeBytes bytes, and
+		the leaves are linked in key order. Inner nodes hold copies of
+		separator keys and their children: a lookup touches one node per
+		level, and there are log_B(n) levels for B in the tens instead of
+		log_2(n). Both kinds of nodes are searched with a branchless binary
+		search.
+
+		Differences with rbtree: values move between nodes, so every insert
+		and erase invalidates all iterators, and key_type must be copy
+		constructible and assignable. Splits and merges move values and keys
+		with copy (C++98) or move construction, which must not throw; a
+		value built by insert or emplace may throw, the tree is then left as
+		it was. There is no order statistics policy.
+
+		Node allocation comes from the two rebound allocators directly, a
+		node holds many values so there is little to gain from a pool
+	*/
+	template <	class T, class Compare = std::less<T>, class Allocator = std::allocator<T>,
+				class KeyOfValue = ft::identity<T>, size_t NodeBytes = 512 >
+	class btree : private stats_slot<stats_btree>
+	{
+		public :
+
+			typedef T												value_type;
+			typedef typename remove_const<typename KeyOfValue::result_type>::type key_type;
+			typedef KeyOfValue										key_of_value;
+			typedef Compare											compare;
+			typedef Allocator										allocator_type;
+			typedef typename allocator_type::reference				reference;
+			typedef typename allocator_type::const_reference		const_reference;
+			typedef typename allocator_type::pointer				pointer;
+			typedef typename allocator_type::const_pointer			const_pointer;
+			typedef size_t											size_type;
+			typedef std::ptrdiff_t									difference_type;
+
+		private :
+
+			/* a node header is 4 words at most, NodeBytes has to leave room for values */
+			typedef char __node_bytes_too_small[NodeBytes >= 64 ? 1 : -1];
+
+			static const size_type	__leaf_fit = (NodeBytes - 4 * sizeof(void *)) / sizeof(T);
+			static const size_type	__inner_fit = (NodeBytes - 3 * sizeof(void *))
+												/ (sizeof(key_type) + sizeof(void *));
+
+		public :
+
+			/* values per leaf and keys per inner node, at least 4 */
+			static const size_type	leaf_capacity = __leaf_fit < 4 ? 4 : __leaf_fit;
+			static const size_type	inner_capacity = __inner_fit < 4 ? 4 : __inner_fit;
+
+			/* raw storage for N objects of type U, aligned for any scalar type */
+			template <class U, size_t N>
+			union storage
+			{
+				char		__bytes[N * sizeof(U)];
+				long double	__align_ld;
+				long long	__align_ll;
+				void		*__align_p;
+			};
+
+			/* Nodes --------------------------------------------------------- */
+			struct inner;
+
+			struct node_base
+			{
+				inner		*__parent;
+				size_type	__count;	/* values of a leaf, keys of an inner node */
+				bool		__is_leaf;
+			};
+
+			struct leaf : public node_base
+			{
+				leaf								*__prev;
+				leaf								*__next;
+				storage<value_type, leaf_capacity>	__slots;
+
+				value_type *__values()
+				{
+					return reinterpret_cast<value_type *>(__slots.__bytes);
+				}
+				const value_type *__values() const
+				{
+					return reinterpret_cast<const value_type *>(__slots.__bytes);
+				}
+				value_type & __value(size_type i)
+				{
+					return __values()[i];
+				}
+			};
+
+			/*
+				keys[i] separates child[i] from child[i + 1]: every key of
+				child[i] is less than keys[i], which is less or equal to every
+				key of child[i + 1]. One spare slot: a full node takes the new
+				key first, then splits
+			*/
+			struct inner : public node_base
+			{
+				node_base							*__child[inner_capacity + 2];
+				storage<key_type, inner_capacity + 1>	__slots;
+
+				key_type *__keys()
+				{
+					return reinterpret_cast<key_type *>(__slots.__bytes);
+				}
+				const key_type *__keys() const
+				{
+					return reinterpret_cast<const key_type *>(__slots.__bytes);
+				}
+			};
+
+			typedef typename allocator_type::template rebind<leaf>::other	leaf_allocator;
+			typedef typename allocator_type::template rebind<inner>::other	inner_allocator;
+
+			/* Iterators ----------------------------------------------------- */
+			typedef btree_iter<leaf, pointer>			iterator;
+			typedef btree_iter<leaf, const_pointer>		const_iterator;
+			typedef reverse_iter<iterator>				reverse_iterator;
+			typedef reverse_iter<const_iterator>		const_reverse_iterator;
+
+			/* Coplien's form ------------------------------------------------ */
+			explicit btree(const compare & comp = compare(), const allocator_type & alloc = allocator_type())
+			:	__compare(comp),
+				__leaf_alloc(alloc),
+				__inner_alloc(alloc),
+				__root(NULL),
+				__leftmost(NULL),
+				__rightmost(NULL),
+				__size(0)
+			{}
+
+			btree(const btree & other)
+			:	stats_slot<stats_btree>(),
+				__compare(other.__compare),
+				__leaf_alloc(other.__leaf_alloc),
+				__inner_alloc(other.__inner_alloc),
+				__root(NULL),
+				__leftmost(NULL),
+				__rightmost(NULL),
+				__size(0)
+			{
+				try
+				{
+					__append_all(other);
+				}
+				catch (...)
+				{
+					clear();
+					throw;
+				}
+			}
+
+			/* basic guarantee: if a copy throws, the tree is left empty */
+			btree & operator=(const btree & other)
+			{
+				if (this != &other)
+				{
+					clear();
+					__compare = other.__compare;
+					try
+					{
+						__append_all(other);
+					}
+					catch (...)
+					{
+						clear();
+						throw;
+					}
+				}
+				return *this;
+			}
+
+# if FT_CXX11
+			btree(btree && other)
+			:	__compare(other.__compare),
+				__leaf_alloc(other.__leaf_alloc),
+				__inner_alloc(other.__inner_alloc),
+				__root(NULL),
+				__leftmost(NULL),
+				__rightmost(NULL),
+				__size(0)
+			{
+				this->swap(other);
+			}
+
+			btree & operator=(btree && other)
+			{
+				if (this != &other)
+				{
+					clear();
+					this->swap(other);
+				}
+				return *this;
+			}
+# endif
+
+			~btree()
+			{
+				clear();
+			}
+
+			void clear()
+			{
+				if (__root)
+					__destroy(__root);
+				__root = NULL;
+				__leftmost = NULL;
+				__rightmost = NULL;
+				__size = 0;
+			}
+
+			/* Iterators ----------------------------------------------------- */
+			iterator begin()
+			{
+				return iterator(__leftmost, 0);
+			}
+			const_iterator begin() const
+			{
+				return const_iterator(__leftmost, 0);
+			}
+			iterator end()
+			{
+				return iterator(__rightmost, __rightmost ? __rightmost->__count : 0);
+			}
+			const_iterator end() const
+			{
+				return const_iterator(__rightmost, __rightmost ? __rightmost->__count : 0);
+			}
+			reverse_iterator rbegin()
+			{
+				return reverse_iterator(end());
+			}
+			const_reverse_iterator rbegin() const
+			{
+				return const_reverse_iterator(end());
+			}
+			reverse_iterator rend()
+			{
+				return reverse_iterator(begin());
+			}
+			const_reverse_iterator rend() const
+			{
+				return const_reverse_iterator(begin());
+			}
+
+			/* Capacity ------------------------------------------------------ */
+			bool empty() const
+			{
+				return __size == 0;
+			}
+			size_type size() const
+			{
+				return __size;
+			}
+			size_type max_size() const
+			{
+				return std::numeric_limits<difference_type>::max() / sizeof(value_type);
+			}
+
+			/* Modifiers ----------------------------------------------------- */
+			void swap(btree & rhs)
+			{
+				std::swap(__compare, rhs.__compare);
+				std::swap(__leaf_alloc, rhs.__leaf_alloc);
+				std::swap(__inner_alloc, rhs.__inner_alloc);
+				std::swap(__root, rhs.__root);
+				std::swap(__leftmost, rhs.__leftmost);
+				std::swap(__rightmost, rhs.__rightmost);
+				std::swap(__size, rhs.__size);
+			}
+
+			/* Insertion ----------------------------------------------------- */
+			ft::pair<iterator, bool> insert(const value_type & x)
+			{
+				return __insert_unique(__key(x), __copy_ctor(x));
+			}
+
+			iterator insert(iterator hint, const value_type & x)
+			{
+				return __insert_unique_hint(hint, __key(x), __copy_ctor(x)).first;
+			}
+
+			/* a sorted range is appended through the end() hint in O(1) per value */
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				for (; first != last; ++first)
+					insert(end(), *first);
+			}
+
+			/*
+				the tree must be empty and [first, last) strictly increasing
+				by the comparator. Not checked: every value is appended to the
+				last leaf without a comparison
+			*/
+			template <class InputIterator>
+			void build_sorted(InputIterator first, InputIterator last)
+			{
+				__append_sorted(first, last);
+			}
+
+# if FT_CXX11
+			/* the key is only known once the value exists: built aside, then moved in */
+			template <class... Args>
+			ft::pair<iterator, bool> emplace(Args &&... args)
+			{
+				value_type tmp(std::forward<Args>(args)...);
+
+				return __insert_unique(__key(tmp), __move_ctor(tmp));
+			}
+
+			template <class... Args>
+			iterator emplace_hint(iterator hint, Args &&... args)
+			{
+				value_type tmp(std::forward<Args>(args)...);
+
+				return __insert_unique_hint(hint, __key(tmp), __move_ctor(tmp)).first;
+			}
+# endif
+
+			/* see rbtree::find_or_insert */
+			template <class K, class Maker>
+			ft::pair<iterator, bool> find_or_insert(const K & k, const Maker & make)
+			{
+				return __insert_unique(k, __make_ctor<Maker>(make));
+			}
+
+			template <class K, class Maker>
+			ft::pair<iterator, bool> find_or_insert_hint(iterator hint, const K & k, const Maker & make)
+			{
+				return __insert_unique_hint(hint, k, __make_ctor<Maker>(make));
+			}
+
+# if FT_CXX11
+			template <class K, class... Args>
+			ft::pair<iterator, bool> find_or_emplace(const K & k, Args &&... args)
+			{
+				return __insert_unique(k, [&](void *p) {
+					::new (p) value_type(std::forward<Args>(args)...);
+				});
+			}
+
+			template <class K, class... Args>
+			ft::pair<iterator, bool> find_or_emplace_hint(iterator hint, const K & k, Args &&... args)
+			{
+				return __insert_unique_hint(hint, k, [&](void *p) {
+					::new (p) value_type(std::forward<Args>(args)...);
+				});
+			}
+# endif
+
+			/* Erase --------------------------------------------------------- */
+			void erase(iterator position)
+			{
+				__erase_at(position.leaf(), position.index());
+			}
+
+			size_type erase(const key_type & key)
+			{
+				iterator it = find(key);
+
+				if (it == end())
+					return 0;
+				__erase_at(it.leaf(), it.index());
+				return 1;
+			}
+
+			/* erasing a value moves its neighbours, the walk goes on from the returned position */
+			void erase(iterator first, iterator last)
+			{
+				size_type n = 0;
+
+				if (first == begin() && last == end())
+				{
+					clear();
+					return;
+				}
+				for (iterator it = first; it != last; ++it)
+					++n;
+				while (n--)
+					first = __erase_at(first.leaf(), first.index());
+			}
+
+			/* Lookup -------------------------------------------------------- */
+			/* K is key_type, or anything Compare accepts next to a key_type */
+			template <class K>
+			ft::pair<iterator, iterator> equal_range(const K & key)
+			{
+				return ft::make_pair(__lower_bound(key), __upper_bound(key));
+			}
+			template <class K>
+			ft::pair<const_iterator, const_iterator> equal_range(const K & key) const
+			{
+				return ft::pair<const_iterator, const_iterator>(__lower_bound(key), __upper_bound(key));
+			}
+			template <class K>
+			iterator lower_bound(const K & key)
+			{
+				return __lower_bound(key);
+			}
+			template <class K>
+			const_iterator lower_bound(const K & key) const
+			{
+				return __lower_bound(key);
+			}
+			template <class K>
+			iterator upper_bound(const K & key)
+			{
+				return __upper_bound(key);
+			}
+			template <class K>
+			const_iterator upper_bound(const K & key) const
+			{
+				return __upper_bound(key);
+			}
+			template <class K>
+			iterator find(const K & key)
+			{
+				return __find(key);
+			}
+			template <class K>
+			const_iterator find(const K & key) const
+			{
+				return __find(key);
+			}
+			template <class K>
+			size_type count(const K & key) const
+			{
+				return __find(key) != end();
+			}
+
+			/* Stats --------------------------------------------------------- */
+			/* counters of this tree, zero unless built with FT_STATS (see stats.hpp) */
+			container_stats stats() const
+			{
+				return this->__stats();
+			}
+
+		private :
+
+			compare				__compare;
+			leaf_allocator		__leaf_alloc;
+			inner_allocator		__inner_alloc;
+			node_base			*__root;
+			leaf				*__leftmost;	/* first and last leaf, NULL when empty */
+			leaf				*__rightmost;
+			size_type			__size;
+
+			/* a leaf under half full borrows from a sibling or merges with it */
+			static const size_type	__leaf_min = leaf_capacity / 2;
+			static const size_type	__inner_min = inner_capacity / 2;
+
+			static const key_type & __key(const value_type & v)
+			{
+				return key_of_value()(v);
+			}
+
+			/* every key comparison goes through here, to be counted */
+			template <class K1, class K2>
+			bool __less(const K1 & a, const K2 & b) const
+			{
+				this->__stat_comparison();
+				return __compare(a, b);
+			}
+
+			/* __less as a function object, for the search algorithms */
+			struct __counted_compare
+			{
+				const btree	&t;
+
+				explicit __counted_compare(const btree & tree)
+				: t(tree)
+				{}
+				template <class K1, class K2>
+				bool operator()(const K1 & a, const K2 & b) const
+				{
+					return t.__less(a, b);
+				}
+			};
+
+			/*
+				builds the new value in the slot handed to operator(); the
+				insertion code is shared by copy, maker and emplace
+			*/
+			struct __copy_ctor
+			{
+				const value_type	&v;
+
+				explicit __copy_ctor(const value_type & value)
+				: v(value)
+				{}
+				void operator()(void *p) const
+				{
+					::new (p) value_type(v);
+				}
+			};
+
+			template <class Maker>
+			struct __make_ctor
+			{
+				const Maker			&m;
+
+				explicit __make_ctor(const Maker & make)
+				: m(make)
+				{}
+				void operator()(void *p) const
+				{
+					::new (p) value_type(m());
+				}
+			};
+
+# if FT_CXX11
+			struct __move_ctor
+			{
+				value_type			&v;
+
+				explicit __move_ctor(value_type & value)
+				: v(value)
+				{}
+				void operator()(void *p) const
+				{
+					::new (p) value_type(std::move(v));
+				}
+			};
+# endif
+
+			/*
+				moves n objects from src to dst, the ranges may overlap. src
+				is left as raw storage
+			*/
+			template <class U>
+			static void __relocate(U *dst, U *src, size_type n)
+			{
+				if (n == 0 || dst == src)
+					return;
+				if (is_trivially_relocatable<U>::value)
+				{
+					std::memmove(static_cast<void *>(dst), static_cast<void *>(src), n * sizeof(U));
+					return;
+				}
+				if (dst < src)
+				{
+					for (size_type i = 0; i < n; ++i)
+					{
+						::new (static_cast<void *>(dst + i)) U(FT_MOVE(src[i]));
+						src[i].~U();
+					}
+				}
+				else
+				{
+					for (size_type i = n; i-- > 0; )
+					{
+						::new (static_cast<void *>(dst + i)) U(FT_MOVE(src[i]));
+						src[i].~U();
+					}
+				}
+			}
+
+			/* Nodes --------------------------------------------------------- */
+			leaf *__new_leaf()
+			{
+				leaf *l = __leaf_alloc.allocate(1);
+
+				this->__stat_allocation(sizeof(leaf));
+				l->__parent = NULL;
+				l->__count = 0;
+				l->__is_leaf = true;
+				l->__prev = NULL;
+				l->__next = NULL;
+				return l;
+			}
+
+			inner *__new_inner()
+			{
+				inner *n = __inner_alloc.allocate(1);
+
+				this->__stat_allocation(sizeof(inner));
+				n->__parent = NULL;
+				n->__count = 0;
+				n->__is_leaf = false;
+				return n;
+			}
+
+			/* subtrees are log_B(n) deep, the recursion stays shallow */
+			void __destroy(node_base *n)
+			{
+				if (n->__is_leaf)
+				{
+					leaf *l = static_cast<leaf *>(n);
+
+					if (!is_trivially_destructible<value_type>::value)
+						for (size_type i = 0; i < l->__count; ++i)
+							l->__values()[i].~value_type();
+					__leaf_alloc.deallocate(l, 1);
+					return;
+				}
+				inner *in = static_cast<inner *>(n);
+
+				for (size_type i = 0; i <= in->__count; ++i)
+					__destroy(in->__child[i]);
+				for (size_type i = 0; i < in->__count; ++i)
+					in->__keys()[i].~key_type();
+				__inner_alloc.deallocate(in, 1);
+			}
+
+			/* levels of the tree, a lone leaf is 1 */
+			size_type __levels() const
+			{
+				const node_base	*n = __root;
+				size_type		levels = 1;
+
+				for (; !n->__is_leaf; n = static_cast<const inner *>(n)->__child[0])
+					++levels;
+				return levels;
+			}
+
+			static size_type __child_index(const inner *p, const node_base *child)
+			{
+				size_type i = 0;
+
+				while (p->__child[i] != child)
+					++i;
+				return i;
+			}
+
+			/* Search -------------------------------------------------------- */
+			/* first value of l whose key is not less than k */
+			template <class K>
+			size_type __leaf_lower(const leaf *l, const K & k) const
+			{
+				const value_type	*v = l->__values();
+				const value_type	*base = v;
+				size_type			n = l->__count;
+				size_type			half;
+
+				if (n == 0)
+					return 0;
+				while (n > 1)
+				{
+					half = n / 2;
+					base = __less(__key(base[half]), k) ? base + half : base;
+					n -= half;
+				}
+				return (base - v) + __less(__key(*base), k);
+			}
+
+			/* first value of l whose key is greater than k */
+			template <class K>
+			size_type __leaf_upper(const leaf *l, const K & k) const
+			{
+				const value_type	*v = l->__values();
+				const value_type	*base = v;
+				size_type			n = l->__count;
+				size_type			half;
+
+				if (n == 0)
+					return 0;
+				while (n > 1)
+				{
+					half = n / 2;
+					base = !__less(k, __key(base[half])) ? base + half : base;
+					n -= half;
+				}
+				return (base - v) + !__less(k, __key(*base));
+			}
+
+			/* the leaf whose key range holds k: at each level, skip the separators <= k */
+			template <class K>
+			leaf *__find_leaf(const K & k) const
+			{
+				node_base 	*n = __root;
+				inner		*in;
+
+				while (!n->__is_leaf)
+				{
+					in = static_cast<inner *>(n);
+					n = in->__child[branchless_upper_bound(in->__keys(), in->__count, k, __counted_compare(*this))
+									- in->__keys()];
+				}
+				return static_cast<leaf *>(n);
+			}
+
+			/* position i of l, or the first of the next leaf when i is past the end */
+			static iterator __normalize(leaf *l, size_type i)
+			{
+				if (i == l->__count && l->__next)
+					return iterator(l->__next, 0);
+				return iterator(l, i);
+			}
+
+			template <class K>
+			iterator __lower_bound(const K & k) const
+			{
+				leaf *l;
+
+				if (!__root)
+					return iterator();
+				l = __find_leaf(k);
+				return __normalize(l, __leaf_lower(l, k));
+			}
+
+			template <class K>
+			iterator __upper_bound(const K & k) const
+			{
+				leaf *l;
+
+				if (!__root)
+					return iterator();
+				l = __find_leaf(k);
+				return __normalize(l, __leaf_upper(l, k));
+			}
+
+			template <class K>
+			iterator __find(const K & k) const
+			{
+				leaf 		*l;
+				size_type	i;
+
+				if (!__root)
+					return iterator();
+				l = __find_leaf(k);
+				i = __leaf_lower(l, k);
+				if (i == l->__count || __less(k, __key(l->__value(i))))
+					return iterator(__rightmost, __rightmost->__count);
+				return iterator(l, i);
+			}
+
+			/* Insertion ----------------------------------------------------- */
+			/*
+				a value equal to k can only be in the leaf the descent ends in:
+				every value of the next leaves is at least the separator that
+				sent the search left, which is greater than k
+			*/
+			template <class K, class Ctor>
+			ft::pair<iterator, bool> __insert_unique(const K & k, const Ctor & ctor)
+			{
+				leaf		*l;
+				size_type	i;
+
+				if (!__root)
+				{
+					l = __new_leaf();
+					__root = l;
+					__leftmost = l;
+					__rightmost = l;
+					this->__stat_height(1);
+				}
+				l = __find_leaf(k);
+				i = __leaf_lower(l, k);
+				if (i != l->__count && !__less(k, __key(l->__value(i))))
+					return ft::make_pair(iterator(l, i), false);
+				return ft::make_pair(__insert_at(l, i, ctor), true);
+			}
+
+			/*
+				the hint is used when k fits right before it inside one leaf,
+				or at either end of the whole tree: sorted appends and prepends
+				take O(1) comparisons
+			*/
+			template <class K, class Ctor>
+			ft::pair<iterator, bool> __insert_unique_hint(iterator hint, const K & k, const Ctor & ctor)
+			{
+				leaf		*l = hint.leaf();
+				size_type	i = hint.index();
+
+				if (l && (i != 0 || !l->__prev) && (i != l->__count || !l->__next)
+					&& (i == 0 || __less(__key(l->__value(i - 1)), k))
+					&& (i == l->__count || __less(k, __key(l->__value(i)))))
+					return ft::make_pair(__insert_at(l, i, ctor), true);
+				return __insert_unique(k, ctor);
+			}
+
+			/* opens a slot at i, splitting l first when it is full */
+			template <class Ctor>
+			iterator __insert_at(leaf *l, size_type i, const Ctor & ctor)
+			{
+				value_type *v;
+
+				if (l->__count == leaf_capacity)
+					__split_leaf(l, i);
+				v = l->__values();
+				__relocate(v + i + 1, v + i, l->__count - i);
+				try
+				{
+					ctor(static_cast<void *>(v + i));
+				}
+				catch (...)
+				{
+					__relocate(v + i, v + i + 1, l->__count - i);
+					throw;
+				}
+				++l->__count;
+				++__size;
+				return iterator(l, i);
+			}
+
+			/* appends a copy of every value of other, which is sorted */
+			void __append_all(const btree & other)
+			{
+				__append_sorted(other.begin(), other.end());
+			}
+
+			/* appends [first, last), whose keys are all above the tree's, in order */
+			template <class InputIterator>
+			void __append_sorted(InputIterator first, InputIterator last)
+			{
+				for (; first != last; ++first)
+				{
+					if (!__root)
+					{
+						__root = __new_leaf();
+						__leftmost = static_cast<leaf *>(__root);
+						__rightmost = __leftmost;
+						this->__stat_height(1);
+					}
+					__insert_at(__rightmost, __rightmost->__count, __copy_ctor(*first));
+				}
+			}
+
+			/*
+				Splits the full leaf l before a value goes in at i; l and i are
+				updated to where it goes. Appending to the last leaf moves one
+				value out, prepending to the first one keeps one value: sorted
+				input fills its leaves. The separator is copied and every node
+				allocated before anything moves, so a failure changes nothing
+			*/
+			void __split_leaf(leaf *&l, size_type & i)
+			{
+				storage<key_type, 1>	sep;
+				key_type				*sep_key = reinterpret_cast<key_type *>(sep.__bytes);
+				leaf					*r;
+				inner					*spares;
+				size_type				s;
+
+				if (i == leaf_capacity && !l->__next)
+					s = leaf_capacity - 1;
+				else if (i == 0 && !l->__prev)
+					s = 1;
+				else
+					s = leaf_capacity / 2;
+				::new (static_cast<void *>(sep_key)) key_type(__key(l->__value(s)));
+				try
+				{
+					r = __new_leaf();
+					try
+					{
+						spares = __reserve_inner(l);
+					}
+					catch (...)
+					{
+						__leaf_alloc.deallocate(r, 1);
+						throw;
+					}
+				}
+				catch (...)
+				{
+					sep_key->~key_type();
+					throw;
+				}
+				__relocate(r->__values(), l->__values() + s, leaf_capacity - s);
+				r->__count = leaf_capacity - s;
+				l->__count = s;
+				r->__prev = l;
+				r->__next = l->__next;
+				if (l->__next)
+					l->__next->__prev = r;
+				else
+					__rightmost = r;
+				l->__next = r;
+				__insert_up(l, sep_key, r, spares);
+				if (i > s)
+				{
+					l = r;
+					i -= s;
+				}
+			}
+
+			/* one new inner node per full ancestor, plus a new root if they all are */
+			inner *__reserve_inner(node_base *n)
+			{
+				inner		*p = n->__parent;
+				inner		*spares = NULL;
+				inner		*tmp;
+				size_type	count = 0;
+
+				for (; p && p->__count == inner_capacity; p = p->__parent)
+					++count;
+				if (!p)
+					++count;
+				try
+				{
+					while (count--)
+					{
+						tmp = __new_inner();
+						tmp->__parent = spares;
+						spares = tmp;
+					}
+				}
+				catch (...)
+				{
+					__free_spares(spares);
+					throw;
+				}
+				return spares;
+			}
+
+			static inner *__pop(inner *& spares)
+			{
+				inner *n = spares;
+
+				spares = n->__parent;
+				n->__parent = NULL;
+				return n;
+			}
+
+			void __free_spares(inner *spares)
+			{
+				while (spares)
+					__inner_alloc.deallocate(__pop(spares), 1);
+			}
+
+			/*
+				links right, the new sibling of left, with the separator *sep
+				(relocated from) into the parent of left. A parent that
+				overflows splits in turn: its middle key goes up, or with
+				sorted input the key next to the new child, as for leaves.
+				Both halves keep a key, a sibling always exists for the
+				rebalancing
+			*/
+			void __insert_up(node_base *left, key_type *sep, node_base *right, inner *spares)
+			{
+				inner		*p;
+				inner		*q;
+				key_type	*k;
+				size_type	pos;
+				size_type	mid;
+
+				while (true)
+				{
+					p = left->__parent;
+					if (!p)
+					{
+						p = __pop(spares);
+						p->__child[0] = left;
+						p->__child[1] = right;
+						__relocate(p->__keys(), sep, 1);
+						p->__count = 1;
+						left->__parent = p;
+						right->__parent = p;
+						__root = p;
+						if (stats_enabled)
+							this->__stat_height(__levels());
+						break;
+					}
+					pos = __child_index(p, left);
+					k = p->__keys();
+					__relocate(k + pos + 1, k + pos, p->__count - pos);
+					__relocate(k + pos, sep, 1);
+					std::memmove(p->__child + pos + 2, p->__child + pos + 1,
+								(p->__count - pos) * sizeof(node_base *));
+					p->__child[pos + 1] = right;
+					right->__parent = p;
+					if (++p->__count <= inner_capacity)
+						break;
+					if (pos + 1 == p->__count && __on_right_edge(p))
+						mid = p->__count - 2;
+					else if (pos == 0 && __on_left_edge(p))
+						mid = 1;
+					else
+						mid = p->__count / 2;
+					q = __pop(spares);
+					__relocate(sep, k + mid, 1);
+					q->__count = p->__count - mid - 1;
+					__relocate(q->__keys(), k + mid + 1, q->__count);
+					std::memcpy(q->__child, p->__child + mid + 1, (q->__count + 1) * sizeof(node_base *));
+					for (size_type c = 0; c <= q->__count; ++c)
+						q->__child[c]->__parent = q;
+					p->__count = mid;
+					left = p;
+					right = q;
+				}
+				__free_spares(spares);
+			}
+
+			static bool __on_right_edge(const node_base *n)
+			{
+				for (; n->__parent; n = n->__parent)
+					if (n->__parent->__child[n->__parent->__count] != n)
+						return false;
+				return true;
+			}
+
+			static bool __on_left_edge(const node_base *n)
+			{
+				for (; n->__parent; n = n->__parent)
+					if (n->__parent->__child[0] != n)
+						return false;
+				return true;
+			}
+
+			/* Erase --------------------------------------------------------- */
+			/* returns the position of the value that followed the erased one */
+			iterator __erase_at(leaf *l, size_type i)
+			{
+				value_type *v = l->__values();
+
+				v[i].~value_type();
+				__relocate(v + i, v + i + 1, l->__count - i - 1);
+				--l->__count;
+				--__size;
+				if (l == __root)
+				{
+					if (l->__count == 0)
+					{
+						__leaf_alloc.deallocate(l, 1);
+						__root = NULL;
+						__leftmost = NULL;
+						__rightmost = NULL;
+						return iterator();
+					}
+					return iterator(l, i);
+				}
+				if (l->__count < __leaf_min)
+					__rebalance_leaf(l, i);
+				return __normalize(l, i);
+			}
+
+			/* l and i follow the value that was at position i of l */
+			void __rebalance_leaf(leaf *&l, size_type & i)
+			{
+				inner 		*p = l->__parent;
+				size_type	ci = __child_index(p, l);
+				leaf		*left = ci > 0 ? static_cast<leaf *>(p->__child[ci - 1]) : NULL;
+				leaf		*right = ci < p->__count ? static_cast<leaf *>(p->__child[ci + 1]) : NULL;
+
+				if (left && left->__count > __leaf_min)
+				{
+					__relocate(l->__values() + 1, l->__values(), l->__count);
+					__relocate(l->__values(), left->__values() + left->__count - 1, 1);
+					--left->__count;
+					++l->__count;
+					++i;
+					p->__keys()[ci - 1] = __key(l->__value(0));
+				}
+				else if (right && right->__count > __leaf_min)
+				{
+					__relocate(l->__values() + l->__count, right->__values(), 1);
+					__relocate(right->__values(), right->__values() + 1, right->__count - 1);
+					--right->__count;
+					++l->__count;
+					p->__keys()[ci] = __key(right->__value(0));
+				}
+				else if (left)
+				{
+					i += left->__count;
+					__merge_leaves(left, l);
+					l = left;
+					p->__keys()[ci - 1].~key_type();
+					__remove_slot(p, ci - 1);
+				}
+				else
+				{
+					__merge_leaves(l, right);
+					p->__keys()[ci].~key_type();
+					__remove_slot(p, ci);
+				}
+			}
+
+			/* b, the right neighbour of a, moves into a and is freed */
+			void __merge_leaves(leaf *a, leaf *b)
+			{
+				__relocate(a->__values() + a->__count, b->__values(), b->__count);
+				a->__count += b->__count;
+				a->__next = b->__next;
+				if (b->__next)
+					b->__next->__prev = a;
+				else
+					__rightmost = a;
+				__leaf_alloc.deallocate(b, 1);
+			}
+
+			/* drops key k, already destroyed or moved out, and child k + 1 of p */
+			void __remove_slot(inner *p, size_type k)
+			{
+				__relocate(p->__keys() + k, p->__keys() + k + 1, p->__count - k - 1);
+				std::memmove(p->__child + k + 1, p->__child + k + 2,
+							(p->__count - k - 1) * sizeof(node_base *));
+				--p->__count;
+				__rebalance_inner(p);
+			}
+
+			/* keys rotate through the parent separator, or two siblings merge around it */
+			void __rebalance_inner(inner *p)
+			{
+				inner		*g;
+				inner		*left;
+				inner		*right;
+				size_type	ci;
+				key_type	*gk;
+				key_type	*pk = p->__keys();
+
+				if (p == __root)
+				{
+					if (p->__count == 0)
+					{
+						__root = p->__child[0];
+						__root->__parent = NULL;
+						__inner_alloc.deallocate(p, 1);
+					}
+					return;
+				}
+				if (p->__count >= __inner_min)
+					return;
+				g = p->__parent;
+				gk = g->__keys();
+				ci = __child_index(g, p);
+				left = ci > 0 ? static_cast<inner *>(g->__child[ci - 1]) : NULL;
+				right = ci < g->__count ? static_cast<inner *>(g->__child[ci + 1]) : NULL;
+				if (left && left->__count > __inner_min)
+				{
+					__relocate(pk + 1, pk, p->__count);
+					std::memmove(p->__child + 1, p->__child, (p->__count + 1) * sizeof(node_base *));
+					__relocate(pk, gk + ci - 1, 1);
+					__relocate(gk + ci - 1, left->__keys() + left->__count - 1, 1);
+					p->__child[0] = left->__child[left->__count];
+					p->__child[0]->__parent = p;
+					--left->__count;
+					++p->__count;
+				}
+				else if (right && right->__count > __inner_min)
+				{
+					__relocate(pk + p->__count, gk + ci, 1);
+					__relocate(gk + ci, right->__keys(), 1);
+					p->__child[p->__count + 1] = right->__child[0];
+					p->__child[p->__count + 1]->__parent = p;
+					__relocate(right->__keys(), right->__keys() + 1, right->__count - 1);
+					std::memmove(right->__child, right->__child + 1, right->__count * sizeof(node_base *));
+					--right->__count;
+					++p->__count;
+				}
+				else if (left)
+				{
+					__merge_inner(left, p, gk + ci - 1);
+					__remove_slot(g, ci - 1);
+				}
+				else
+				{
+					__merge_inner(p, right, gk + ci);
+					__remove_slot(g, ci);
+				}
+			}
+
+			/* b, the right neighbour of a, moves into a after the separator sep */
+			void __merge_inner(inner *a, inner *b, key_type *sep)
+			{
+				__relocate(a->__keys() + a->__count, sep, 1);
+				__relocate(a->__keys() + a->__count + 1, b->__keys(), b->__count);
+				std::memcpy(a->__child + a->__count + 1, b->__child, (b->__count + 1) * sizeof(node_base *));
+				for (size_type c = 0; c <= b->__count; ++c)
+					b->__child[c]->__parent = a;
+				a->__count += b->__count + 1;
+				__inner_alloc.deallocate(b, 1);
+			}
+	};
+}
+
+#endif
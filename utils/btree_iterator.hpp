@@ -0,0 +1,121 @@
+#ifndef 	BTREE_ITERATOR_HPP
+# define 	BTREE_ITERATOR_HPP
+
+# include <cstddef>
+# include "utils.hpp"
+# include "enable_if.hpp"
+
+namespace ft
+{
+	/*
+		Iterator of ft::btree: a leaf and a position in it. Leaves are linked
+		in key order, so ++ and -- are O(1). end() is the position one past the
+		last value of the last leaf, which keeps --end() valid. T is the value
+		pointer type, as for tree_iter
+	*/
+	template <class Leaf, class T>
+	class btree_iter
+	{
+		public :
+			/* typedef ------------------------------------------------------- */
+			typedef std::bidirectional_iterator_tag										iterator_category;
+			typedef typename remove_const<typename iterator_traits<T>::value_type>::type	value_type;
+			typedef typename iterator_traits<T>::reference 								reference;
+			typedef typename iterator_traits<T>::pointer								pointer;
+			typedef std::ptrdiff_t														difference_type;
+			typedef btree_iter<Leaf, T>													self;
+
+		private :
+			Leaf 		*__leaf;
+			size_t		__idx;
+
+		public :
+
+			/* coplien ------------------------------------------------------- */
+			btree_iter()
+			:	__leaf(NULL),
+				__idx(0)
+			{}
+
+			btree_iter(Leaf *leaf, size_t idx)
+			:	__leaf(leaf),
+				__idx(idx)
+			{}
+
+			/* copy, and iterator to const_iterator */
+			btree_iter(const btree_iter<Leaf, value_type *> & rhs)
+			:	__leaf(rhs.leaf()),
+				__idx(rhs.index())
+			{}
+
+			btree_iter & operator=(const btree_iter<Leaf, value_type *> & rhs)
+			{
+				__leaf = rhs.leaf();
+				__idx = rhs.index();
+				return *this;
+			}
+
+			/* public functions ---------------------------------------------- */
+			Leaf *leaf() const
+			{
+				return __leaf;
+			}
+			size_t index() const
+			{
+				return __idx;
+			}
+
+			reference operator*() const
+			{
+				return __leaf->__value(__idx);
+			}
+			pointer operator->() const
+			{
+				return &(__leaf->__value(__idx));
+			}
+
+			self & operator++()
+			{
+				if (++__idx == __leaf->__count && __leaf->__next)
+				{
+					__leaf = __leaf->__next;
+					__idx = 0;
+				}
+				return *this;
+			}
+			self & operator--()
+			{
+				if (__idx == 0)
+				{
+					__leaf = __leaf->__prev;
+					__idx = __leaf->__count;
+				}
+				--__idx;
+				return *this;
+			}
+			self operator++(int)
+			{
+				self tmp = *this;
+				++*this;
+				return tmp;
+			}
+			self operator--(int)
+			{
+				self tmp = *this;
+				--*this;
+				return tmp;
+			}
+
+			friend bool operator==(const self & lhs, const self & rhs)
+			{
+				return lhs.__leaf == rhs.__leaf && lhs.__idx == rhs.__idx;
+			}
+
+			friend bool operator!=(const self & lhs, const self & rhs)
+			{
+				return !(lhs == rhs);
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef 	CONFIG_HPP
+# define 	CONFIG_HPP
+
+/*
+	The containers are written in C++98. Compiling with -std=c++11 or later
+	turns on the C++11 build mode: move constructors and assignments, rvalue
+	overloads and the emplace family, all guarded by FT_CXX11
+*/
+# if __cplusplus >= 201103L
+#  define FT_CXX11 1
+# else
+#  define FT_CXX11 0
+# endif
+
+/* 
+	FT_MOVE moves in C++11 and copies in C++98, FT_MOVE_IF_NOEXCEPT only moves 
+	when the move constructor cannot throw, so that copies keep the strong 
+	exception guarantee 
+*/
+# if FT_CXX11
+#  include <utility>
+#  define FT_MOVE(x) 					std::move(x)
+#  define FT_MOVE_IF_NOEXCEPT(x) 		std::move_if_noexcept(x)
+# else
+#  define FT_MOVE(x) 					(x)
+#  define FT_MOVE_IF_NOEXCEPT(x) 		(x)
+# endif
+
+/* read prefetch hint, a no-op where the compiler has no builtin for it */
+# if defined(__GNUC__) || defined(__clang__)
+#  define FT_PREFETCH(addr) 			__builtin_prefetch(addr)
+# else
+#  define FT_PREFETCH(addr) 			((void)0)
+# endif
+
+/*
+	-DFT_STATS=1 counts the allocations and the tree operations of every 
+	container (see stats.hpp). Off by default, the counters then compile 
+	to nothing
+*/
+# ifndef FT_STATS
+#  define FT_STATS 0
+# endif
+
+#endif
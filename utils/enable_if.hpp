@@ -14,6 +14,19 @@ struct enable_if<true, T>
 	typedef T type;
 };
 
+/* ------------------------------- remove const ------------------------------ */
+template <class T>
+struct remove_const
+{
+	typedef T type;
+};
+
+template <class T>
+struct remove_const<const T>
+{
+	typedef T type;
+};
+
 template <class T>
 struct is_iterator 
 {
@@ -37,6 +50,37 @@ struct is_iterator
 		static const bool value = sizeof(f<T>(1)) != sizeof(double);
 };
 
+/* 
+	true when Compare declares is_transparent, i.e. accepts keys of any type. 
+	K is not inspected, it only makes the condition depend on the template 
+	parameter of the member function being enabled 
+*/
+template <class Compare, class K>
+struct is_transparent 
+{
+	private:
+
+		template <class C>
+		static char f(typename C::is_transparent *);
+		
+		template <class C>
+		static double f(...);
+
+	public:
+		
+		static const bool value = sizeof(f<Compare>(0)) == sizeof(char);
+};
+
+/* 
+	true when both the hasher and the key_equal of an unordered container are 
+	transparent, which enables its heterogeneous lookup overloads 
+*/
+template <class Hash, class KeyEqual, class K>
+struct is_transparent_hash
+{
+	static const bool value = is_transparent<Hash, K>::value && is_transparent<KeyEqual, K>::value;
+};
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef 	EYTZINGER_ITERATOR_HPP
+# define 	EYTZINGER_ITERATOR_HPP
+
+# include <cstddef>
+# include "utils.hpp"
+# include "eytzinger_search.hpp"
+
+namespace ft
+{
+	/*
+		Read-only iterator of an array in eytzinger order (see
+		eytzinger_search.hpp), walking it in sorted order. ++ and -- follow
+		the implicit tree, O(1) amortized; end() is position 0
+	*/
+	template <class T>
+	class eytzinger_iter
+	{
+		public :
+			/* typedef ------------------------------------------------------- */
+			typedef std::bidirectional_iterator_tag		iterator_category;
+			typedef T									value_type;
+			typedef const T &							reference;
+			typedef const T *							pointer;
+			typedef std::ptrdiff_t						difference_type;
+			typedef eytzinger_iter<T>					self;
+
+		private :
+			const T		*__a;
+			size_t		__n;
+			size_t		__k;
+
+		public :
+
+			/* coplien ------------------------------------------------------- */
+			eytzinger_iter()
+			:	__a(NULL),
+				__n(0),
+				__k(0)
+			{}
+
+			eytzinger_iter(const T *a, size_t n, size_t k)
+			:	__a(a),
+				__n(n),
+				__k(k)
+			{}
+
+			~eytzinger_iter() {}
+
+			/* public functions ---------------------------------------------- */
+			/* the 1-based position in the array, 0 for end() */
+			size_t position() const
+			{
+				return __k;
+			}
+
+			reference operator*() const
+			{
+				return __a[__k - 1];
+			}
+			pointer operator->() const
+			{
+				return __a + __k - 1;
+			}
+
+			self & operator++()
+			{
+				__k = eytzinger_next(__k, __n);
+				return *this;
+			}
+			self & operator--()
+			{
+				__k = eytzinger_prev(__k, __n);
+				return *this;
+			}
+			self operator++(int)
+			{
+				self tmp = *this;
+				++*this;
+				return tmp;
+			}
+			self operator--(int)
+			{
+				self tmp = *this;
+				--*this;
+				return tmp;
+			}
+
+			friend bool operator==(const self & lhs, const self & rhs)
+			{
+				return lhs.__k == rhs.__k && lhs.__a == rhs.__a;
+			}
+
+			friend bool operator!=(const self & lhs, const self & rhs)
+			{
+				return !(lhs == rhs);
+			}
+	};
+}
+
+#endif
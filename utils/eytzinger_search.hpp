@@ -0,0 +1,122 @@
+#ifndef 	EYTZINGER_SEARCH_HPP
+# define 	EYTZINGER_SEARCH_HPP
+
+# include <cstddef>
+# include "config.hpp"
+
+namespace ft
+{
+
+/* ----------------------------- eytzinger layout ---------------------------- */
+/*
+	A sorted array of n keys stored as an implicit binary search tree in
+	breadth-first order: the root is at position 1, the children of k at 2k
+	and 2k + 1. Positions are 1-based, position k is stored at a[k - 1], and
+	0 stands for "past the end". The first levels of the tree share a few
+	cache lines, and the 16 great-great-grandchildren of k are contiguous,
+	so the search can fetch them while it walks the next 4 levels
+*/
+
+/* in-order first and last positions, 0 when n is 0 */
+inline size_t eytzinger_first(size_t n)
+{
+	size_t k = 1;
+
+	if (n == 0)
+		return 0;
+	while (2 * k <= n)
+		k = 2 * k;
+	return k;
+}
+
+inline size_t eytzinger_last(size_t n)
+{
+	size_t k = 1;
+
+	if (n == 0)
+		return 0;
+	while (2 * k + 1 <= n)
+		k = 2 * k + 1;
+	return k;
+}
+
+/* in-order successor of k, 0 after the last position */
+inline size_t eytzinger_next(size_t k, size_t n)
+{
+	if (2 * k + 1 <= n)
+	{
+		k = 2 * k + 1;
+		while (2 * k <= n)
+			k = 2 * k;
+		return k;
+	}
+	while (k & 1)
+		k >>= 1;
+	return k >> 1;
+}
+
+/* in-order predecessor of k, and of 0 the last position */
+inline size_t eytzinger_prev(size_t k, size_t n)
+{
+	if (k == 0)
+		return eytzinger_last(n);
+	if (2 * k <= n)
+	{
+		k = 2 * k;
+		while (2 * k + 1 <= n)
+			k = 2 * k + 1;
+		return k;
+	}
+	while (!(k & 1))
+		k >>= 1;
+	return k >> 1;
+}
+
+/* k without its trailing ones and the zero before them: the last left turn */
+inline size_t eytzinger_last_left(size_t k)
+{
+# if defined(__GNUC__) || defined(__clang__)
+	return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+# else
+	while (k & 1)
+		k >>= 1;
+	return k >> 1;
+# endif
+}
+
+/*
+	The descent goes right while the key is less than the searched one. It
+	ends below a leaf, the path taken is spelled by the bits of k: the answer
+	is the last node where it went left. The loop body is a select, as in
+	flat_search.hpp. The prefetch address is computed as an integer since it
+	may be past the array, which the hint tolerates
+*/
+template <class T, class K, class Compare>
+size_t eytzinger_lower_bound(const T * a, size_t n, const K & key, Compare comp)
+{
+	size_t k = 1;
+
+	while (k <= n)
+	{
+		FT_PREFETCH(reinterpret_cast<const void *>(reinterpret_cast<size_t>(a) + (16 * k - 1) * sizeof(T)));
+		k = 2 * k + comp(a[k - 1], key);
+	}
+	return eytzinger_last_left(k);
+}
+
+template <class T, class K, class Compare>
+size_t eytzinger_upper_bound(const T * a, size_t n, const K & key, Compare comp)
+{
+	size_t k = 1;
+
+	while (k <= n)
+	{
+		FT_PREFETCH(reinterpret_cast<const void *>(reinterpret_cast<size_t>(a) + (16 * k - 1) * sizeof(T)));
+		k = 2 * k + !comp(key, a[k - 1]);
+	}
+	return eytzinger_last_left(k);
+}
+
+}
+
+#endif
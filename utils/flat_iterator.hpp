@@ -0,0 +1,210 @@
+#ifndef 	FLAT_ITERATOR_HPP
+# define 	FLAT_ITERATOR_HPP
+
+# include "utils.hpp"
+# include "pair.hpp"
+
+namespace ft
+{
+
+/* ---------------------------- flat map reference --------------------------- */
+/*
+	flat_map keeps its keys and its mapped values in two parallel arrays, so
+	there is no pair in memory to refer to. Its iterators dereference to this
+	pair of references instead, which reads like a value_type (first, second)
+	and converts to one
+*/
+template <class Key, class MappedRef>
+struct flat_map_ref
+{
+	const Key	&first;
+	MappedRef	second;
+
+	flat_map_ref(const Key & k, MappedRef m)
+	:	first(k),
+		second(m)
+	{}
+
+	template <class K, class T>
+	operator ft::pair<K, T>() const
+	{
+		return ft::pair<K, T>(first, second);
+	}
+};
+
+template <class Key, class R1, class R2>
+bool operator==(const flat_map_ref<Key, R1> & lhs, const flat_map_ref<Key, R2> & rhs)
+{
+	return lhs.first == rhs.first && lhs.second == rhs.second;
+}
+
+template <class Key, class R1, class R2>
+bool operator!=(const flat_map_ref<Key, R1> & lhs, const flat_map_ref<Key, R2> & rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class Key, class R1, class R2>
+bool operator<(const flat_map_ref<Key, R1> & lhs, const flat_map_ref<Key, R2> & rhs)
+{
+	return lhs.first < rhs.first || (!(rhs.first < lhs.first) && lhs.second < rhs.second);
+}
+
+/* ---------------------------- flat map iterator ---------------------------- */
+/*
+	walks both arrays with one index; operator-> returns the flat_map_ref
+	wrapped in a small holder. MappedPtr is T * for iterator and const T * for
+	const_iterator
+*/
+template <class Key, class Mapped, class MappedPtr>
+class flat_map_iter
+{
+	public :
+
+		typedef std::random_access_iterator_tag								iterator_category;
+		typedef ft::pair<Key, Mapped>										value_type;
+		typedef std::ptrdiff_t												difference_type;
+		typedef typename ft::iterator_traits<MappedPtr>::reference			mapped_reference;
+		typedef flat_map_ref<Key, mapped_reference>							reference;
+		typedef flat_map_iter<Key, Mapped, MappedPtr>						self;
+
+		/* what operator-> returns: keeps the proxy alive for the member access */
+		class pointer
+		{
+			public :
+				explicit pointer(const reference & ref)
+				: __ref(ref)
+				{}
+				const reference * operator->() const
+				{
+					return &__ref;
+				}
+			private :
+				reference	__ref;
+		};
+
+		flat_map_iter()
+		:	__key(NULL),
+			__mapped(NULL)
+		{}
+
+		flat_map_iter(const Key * key, MappedPtr mapped)
+		:	__key(key),
+			__mapped(mapped)
+		{}
+
+		/* copy, and iterator to const_iterator */
+		flat_map_iter(const flat_map_iter<Key, Mapped, Mapped *> & rhs)
+		:	__key(rhs.key_base()),
+			__mapped(rhs.mapped_base())
+		{}
+
+		const Key * key_base() const
+		{
+			return __key;
+		}
+		MappedPtr mapped_base() const
+		{
+			return __mapped;
+		}
+
+		reference operator*() const
+		{
+			return reference(*__key, *__mapped);
+		}
+		pointer operator->() const
+		{
+			return pointer(operator*());
+		}
+		reference operator[](difference_type n) const
+		{
+			return reference(__key[n], __mapped[n]);
+		}
+
+		self & operator++()
+		{
+			++__key;
+			++__mapped;
+			return *this;
+		}
+		self & operator--()
+		{
+			--__key;
+			--__mapped;
+			return *this;
+		}
+		self operator++(int)
+		{
+			self tmp(*this);
+			++*this;
+			return tmp;
+		}
+		self operator--(int)
+		{
+			self tmp(*this);
+			--*this;
+			return tmp;
+		}
+
+		self & operator+=(difference_type n)
+		{
+			__key += n;
+			__mapped += n;
+			return *this;
+		}
+		self & operator-=(difference_type n)
+		{
+			__key -= n;
+			__mapped -= n;
+			return *this;
+		}
+		self operator+(difference_type n) const
+		{
+			return self(__key + n, __mapped + n);
+		}
+		self operator-(difference_type n) const
+		{
+			return self(__key - n, __mapped - n);
+		}
+
+		friend self operator+(difference_type n, const self & it)
+		{
+			return it + n;
+		}
+		friend difference_type operator-(const self & lhs, const self & rhs)
+		{
+			return lhs.__key - rhs.__key;
+		}
+		friend bool operator==(const self & lhs, const self & rhs)
+		{
+			return lhs.__key == rhs.__key;
+		}
+		friend bool operator!=(const self & lhs, const self & rhs)
+		{
+			return lhs.__key != rhs.__key;
+		}
+		friend bool operator<(const self & lhs, const self & rhs)
+		{
+			return lhs.__key < rhs.__key;
+		}
+		friend bool operator>(const self & lhs, const self & rhs)
+		{
+			return lhs.__key > rhs.__key;
+		}
+		friend bool operator<=(const self & lhs, const self & rhs)
+		{
+			return lhs.__key <= rhs.__key;
+		}
+		friend bool operator>=(const self & lhs, const self & rhs)
+		{
+			return lhs.__key >= rhs.__key;
+		}
+
+	private :
+		const Key	*__key;
+		MappedPtr	__mapped;
+};
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef 	FLAT_SEARCH_HPP
+# define 	FLAT_SEARCH_HPP
+
+# include <cstddef>
+
+namespace ft
+{
+
+/* ------------------------- branchless binary search ------------------------ */
+/*
+	lower_bound / upper_bound over the sorted array [first, first + n). The
+	window halves on every step whatever the outcome, so the loop runs
+	ceil(log2 n) times and its only data dependent step is a select, which
+	compilers emit as a conditional move: there is no branch to mispredict and
+	the next probe does not wait for the comparison
+*/
+template <class T, class K, class Compare>
+const T * branchless_lower_bound(const T * first, size_t n, const K & key, Compare comp)
+{
+	const T 	*base = first;
+	size_t		half;
+
+	if (n == 0)
+		return first;
+	while (n > 1)
+	{
+		half = n / 2;
+		base = comp(base[half], key) ? base + half : base;
+		n -= half;
+	}
+	return base + comp(*base, key);
+}
+
+template <class T, class K, class Compare>
+const T * branchless_upper_bound(const T * first, size_t n, const K & key, Compare comp)
+{
+	const T 	*base = first;
+	size_t		half;
+
+	if (n == 0)
+		return first;
+	while (n > 1)
+	{
+		half = n / 2;
+		base = !comp(key, base[half]) ? base + half : base;
+		n -= half;
+	}
+	return base + !comp(key, *base);
+}
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef 	FUNCTIONAL_HPP
+# define 	FUNCTIONAL_HPP
+
+namespace ft
+{
+
+/* -------------------------------- identity --------------------------------- */
+/* key extractor of containers whose whole value is the key (set) */
+template <class T>
+struct identity
+{
+	typedef T		argument_type;
+	typedef T		result_type;
+
+	template <class U>
+	const U & operator()(const U & x) const
+	{
+		return x;
+	}
+};
+
+/* -------------------------------- select1st -------------------------------- */
+/*
+	key extractor of containers storing key-value pairs (map). Templated on the
+	argument so that a pair<Key, T> coming from user input is not converted to
+	pair<const Key, T>, which would copy the mapped value
+*/
+template <class Pair>
+struct select1st
+{
+	typedef Pair						argument_type;
+	typedef typename Pair::first_type	result_type;
+
+	template <class P>
+	const typename P::first_type & operator()(const P & x) const
+	{
+		return x.first;
+	}
+};
+
+/* ----------------------------- transparent less ---------------------------- */
+/*
+	operator< on arguments of any types. Declares is_transparent, which enables
+	the heterogeneous lookup overloads of ordered containers: a map keyed by
+	std::string can be searched with a const char * without building a string
+*/
+struct transparent_less
+{
+	typedef void	is_transparent;
+
+	template <class T, class U>
+	bool operator()(const T & lhs, const U & rhs) const
+	{
+		return lhs < rhs;
+	}
+};
+
+/* -------------------------- transparent equal to --------------------------- */
+/*
+	operator== on arguments of any types, the key_equal counterpart of
+	transparent_less for unordered containers (see ft::string_hash)
+*/
+struct transparent_equal_to
+{
+	typedef void	is_transparent;
+
+	template <class T, class U>
+	bool operator()(const T & lhs, const U & rhs) const
+	{
+		return lhs == rhs;
+	}
+};
+
+}
+
+#endif
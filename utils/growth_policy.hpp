@@ -0,0 +1,136 @@
+#ifndef 	GROWTH_POLICY_HPP
+# define 	GROWTH_POLICY_HPP
+
+# include <cstddef>
+# include <cstdlib> 			/* __GLIBC__ */
+
+namespace ft
+{
+	/* Growth policies of ft::vector -------------------------------------------- */
+	/*
+		A policy decides the capacity of the next buffer of a vector:
+
+			grow(cap, needed, size)	when cap elements of size bytes are full
+									and needed must fit, at least needed
+			fit(n, size)			when exactly n elements are asked for
+									(reserve, assign, shrink_to_fit), n or more
+
+		A first buffer holds at least 64 bytes, so that small vectors skip the
+		1, 2, 4... reallocations. grow_page and grow_glibc_fit wrap another
+		policy and round its capacities up to the block the memory actually
+		comes in, the elements then fill the bytes that would be lost anyway
+	*/
+
+	/* smallest first capacity: one element, or a cache line of them */
+	inline size_t growth_first_capacity(size_t size)
+	{
+		return size >= 64 ? 1 : 64 / size;
+	}
+
+	/* doubles the capacity, the default */
+	struct grow_double
+	{
+		static size_t grow(size_t cap, size_t needed, size_t size)
+		{
+			size_t next = cap ? cap * 2 : growth_first_capacity(size);
+
+			return next < needed || next < cap ? needed : next;
+		}
+		static size_t fit(size_t n, size_t)
+		{
+			return n;
+		}
+	};
+
+	/*
+		grows by 1.5: at most a third of the buffer is unused instead of half,
+		for one more reallocation every ~2.4 doublings
+	*/
+	struct grow_golden
+	{
+		static size_t grow(size_t cap, size_t needed, size_t size)
+		{
+			size_t next = cap ? cap + (cap + 1) / 2 : growth_first_capacity(size);
+
+			return next < needed || next < cap ? needed : next;
+		}
+		static size_t fit(size_t n, size_t)
+		{
+			return n;
+		}
+	};
+
+	/* capacity of a block of at least n elements of size bytes, rounded to align bytes */
+	inline size_t growth_round(size_t n, size_t size, size_t align, size_t overhead)
+	{
+		size_t bytes = n * size + overhead;
+
+		if (!n || bytes / size < n)
+			return n;
+		bytes = (bytes + align - 1) / align * align - overhead;
+		return bytes / size;
+	}
+
+	/*
+		buffers of a page or more are whole pages, for allocators that map
+		pages (an mmap or huge page allocator) and would waste the rest of the
+		last one
+	*/
+	template <class Base = grow_double, size_t PageSize = 4096>
+	struct grow_page
+	{
+		static size_t grow(size_t cap, size_t needed, size_t size)
+		{
+			return __round(Base::grow(cap, needed, size), size);
+		}
+		static size_t fit(size_t n, size_t size)
+		{
+			return __round(Base::fit(n, size), size);
+		}
+		static size_t __round(size_t n, size_t size)
+		{
+			return n * size < PageSize ? n : growth_round(n, size, PageSize, 0);
+		}
+	};
+
+	/*
+		a heuristic for glibc malloc on 64 bit targets: rounds the capacity up 
+		to the usable size of the block glibc returns for it. Chunks are 
+		multiples of 16 bytes carrying an 8 byte header. Past the mmap 
+		threshold (128 KiB by default, raised by glibc as mapped blocks are 
+		freed) they are whole pages: a request maps k pages while it is at 
+		most 4096 k - 24 bytes, 16 bytes of header plus 8 of alignment, and 
+		its usable size is then 4096 k - 16. These are glibc internals, not 
+		asked to the allocator: the sizes only hold when the blocks come from 
+		glibc malloc (std::allocator, realloc_allocator under 1 MiB) with 
+		default tunables. jemalloc, tcmalloc, 
+		huge_page_allocator or a pmr resource have other size classes, where 
+		the rounding only wastes or over-asks a few bytes. Elsewhere than 
+		glibc on a 64 bit target the policy is Base unchanged
+	*/
+	template <class Base = grow_double>
+	struct grow_glibc_fit
+	{
+		static size_t grow(size_t cap, size_t needed, size_t size)
+		{
+			return __round(Base::grow(cap, needed, size), size);
+		}
+		static size_t fit(size_t n, size_t size)
+		{
+			return __round(Base::fit(n, size), size);
+		}
+		static size_t __round(size_t n, size_t size)
+		{
+# if defined(__GLIBC__) && defined(__LP64__)
+			if (n * size + 8 >= 128 * 1024)
+				return growth_round(n, size, 4096, 24);
+			return n && n * size < 24 ? 24 / size : growth_round(n, size, 16, 8);
+# else
+			(void)size;
+			return n;
+# endif
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef 	HASH_HPP
+# define 	HASH_HPP
+
+# include <cstddef>
+# include <cstring>
+# include <string>
+
+namespace ft
+{
+
+/* --------------------------------- mixing ---------------------------------- */
+/*
+	multiplies by an odd constant close to 2^bits / phi and folds the high half
+	of the product back into the low half, so that every bit of the result
+	depends on every bit of h. Unordered containers apply it to the value of
+	their hasher, a cheap hasher (the identity on integers) is then good enough
+*/
+template <size_t Bytes>
+struct hash_constants
+{
+	static const size_t	multiplier = 0x9E3779B9UL;
+};
+
+template <>
+struct hash_constants<8>
+{
+	static const size_t	multiplier = 0x9E3779B97F4A7C15UL;
+};
+
+inline size_t hash_mix(size_t h)
+{
+	h *= hash_constants<sizeof(size_t)>::multiplier;
+	return h ^ (h >> (sizeof(size_t) * 4));
+}
+
+/* hash of n bytes, a word at a time */
+inline size_t hash_bytes(const void *data, size_t n)
+{
+	const unsigned char	*p = static_cast<const unsigned char *>(data);
+	size_t				h = n;
+	size_t				word;
+
+	for (; n >= sizeof(size_t); n -= sizeof(size_t), p += sizeof(size_t))
+	{
+		std::memcpy(&word, p, sizeof(size_t));
+		h = hash_mix(h ^ word);
+	}
+	if (n)
+	{
+		word = 0;
+		std::memcpy(&word, p, n);
+		h = hash_mix(h ^ word);
+	}
+	return h;
+}
+
+/* ---------------------------------- hash ----------------------------------- */
+/*
+	C++98 has no std::hash: ft::hash covers the integral and pointer types,
+	float, double and std::string. Other keys need a specialization or a
+	hasher of their own
+*/
+template <class T>
+struct hash;
+
+# define FT_HASH_INTEGRAL(T)										\
+template <>															\
+struct hash<T>														\
+{																	\
+	typedef T		argument_type;									\
+	typedef size_t	result_type;									\
+																	\
+	size_t operator()(T x) const									\
+	{																\
+		return static_cast<size_t>(x);								\
+	}																\
+};
+
+FT_HASH_INTEGRAL(bool)
+FT_HASH_INTEGRAL(char)
+FT_HASH_INTEGRAL(signed char)
+FT_HASH_INTEGRAL(unsigned char)
+FT_HASH_INTEGRAL(wchar_t)
+FT_HASH_INTEGRAL(short)
+FT_HASH_INTEGRAL(unsigned short)
+FT_HASH_INTEGRAL(int)
+FT_HASH_INTEGRAL(unsigned int)
+FT_HASH_INTEGRAL(long)
+FT_HASH_INTEGRAL(unsigned long)
+FT_HASH_INTEGRAL(long long)
+FT_HASH_INTEGRAL(unsigned long long)
+
+# undef FT_HASH_INTEGRAL
+
+template <class T>
+struct hash<T *>
+{
+	typedef T *		argument_type;
+	typedef size_t	result_type;
+
+	size_t operator()(T *p) const
+	{
+		return reinterpret_cast<size_t>(p);
+	}
+};
+
+/* 0.0 and -0.0 compare equal, they must hash the same */
+template <>
+struct hash<float>
+{
+	typedef float	argument_type;
+	typedef size_t	result_type;
+
+	size_t operator()(float x) const
+	{
+		return x == 0.0f ? 0 : hash_bytes(&x, sizeof(x));
+	}
+};
+
+template <>
+struct hash<double>
+{
+	typedef double	argument_type;
+	typedef size_t	result_type;
+
+	size_t operator()(double x) const
+	{
+		return x == 0.0 ? 0 : hash_bytes(&x, sizeof(x));
+	}
+};
+
+template <>
+struct hash<std::string>
+{
+	typedef std::string	argument_type;
+	typedef size_t		result_type;
+
+	size_t operator()(const std::string & s) const
+	{
+		return hash_bytes(s.data(), s.size());
+	}
+};
+
+/* ----------------------------- transparent hash ---------------------------- */
+/*
+	hashes a std::string and a C string with the same characters to the same
+	value. Declares is_transparent: with a transparent key_equal too, an
+	unordered container keyed by std::string can be searched with a
+	const char * without building a string
+*/
+struct string_hash
+{
+	typedef void	is_transparent;
+
+	size_t operator()(const std::string & s) const
+	{
+		return hash_bytes(s.data(), s.size());
+	}
+	size_t operator()(const char *s) const
+	{
+		return hash_bytes(s, std::strlen(s));
+	}
+};
+
+}
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef 	HUGE_PAGE_ALLOCATOR_HPP
+# define 	HUGE_PAGE_ALLOCATOR_HPP
+
+# include <cstddef>
+# include <cstdio>
+# include <cstdlib>
+# include <cstring>
+# include <new>
+# include "slab_traits.hpp"
+
+# if defined(__linux__)
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  define FT_HAS_THP 	1
+# else
+#  define FT_HAS_THP 	0
+# endif
+
+/* mbind without libnuma, through the raw system call */
+# if FT_HAS_THP && defined(SYS_mbind)
+#  define FT_HAS_MBIND 	1
+# else
+#  define FT_HAS_MBIND 	0
+# endif
+
+namespace ft
+{
+	/* Huge page usage --------------------------------------------------------- */
+	/*
+		mapped: bytes currently mapped by every huge_page_allocator
+		advised: bytes of the mappings of the process advised MADV_HUGEPAGE
+		backed: the part of them the kernel actually backs with huge pages
+
+		advised and backed come from /proc/self/smaps ("hg" in VmFlags and
+		AnonHugePages), a scan of every mapping: a report, not a hot path
+	*/
+	struct huge_page_report
+	{
+		size_t	mapped;
+		size_t	advised;
+		size_t	backed;
+	};
+
+	inline size_t & huge_page_mapped_bytes()
+	{
+		static size_t	bytes = 0;
+
+		return bytes;
+	}
+
+	inline huge_page_report huge_page_usage()
+	{
+		huge_page_report	report;
+
+		report.mapped = huge_page_mapped_bytes();
+		report.advised = 0;
+		report.backed = 0;
+# if FT_HAS_THP
+		std::FILE			*smaps = std::fopen("/proc/self/smaps", "r");
+		char				line[512];
+		unsigned long		start, end, kb;
+		size_t				size = 0, huge = 0;
+
+		if (!smaps)
+			return report;
+		while (std::fgets(line, sizeof(line), smaps))
+		{
+			if (std::sscanf(line, "%lx-%lx ", &start, &end) == 2)
+			{
+				size = end - start;
+				huge = 0;
+			}
+			else if (std::sscanf(line, "AnonHugePages: %lu kB", &kb) == 1)
+				huge = kb * 1024;
+			/* VmFlags closes the entry of a mapping */
+			else if (!std::strncmp(line, "VmFlags:", 8) && std::strstr(line, " hg"))
+			{
+				report.advised += size;
+				report.backed += huge;
+			}
+		}
+		std::fclose(smaps);
+# endif
+		return report;
+	}
+
+	/* Huge page allocator ----------------------------------------------------- */
+	/*
+		Allocator for large arrays and node pools that miss the TLB on 4 KiB
+		pages. Blocks of Threshold bytes or more are anonymous mappings
+		aligned on and rounded up to HugePage bytes, advised MADV_HUGEPAGE
+		so that transparent huge pages back them; smaller ones come from
+		malloc. Tree node pools grow their slabs to 2 * HugePage bytes
+		over it (see slab_traits.hpp), so large trees get huge pages too
+
+		An allocator built with a NUMA node binds the pages of its mappings
+		to that node with mbind, before they are touched. Binding is best
+		effort: without mbind or with a node the kernel refuses, the pages
+		go wherever the first touch puts them. Any instance frees the
+		blocks of any other, the node only matters when allocating
+	*/
+	template <class T, size_t Threshold = (1 << 21), size_t HugePage = (1 << 21)>
+	class huge_page_allocator
+	{
+		public :
+
+			typedef T				value_type;
+			typedef T *				pointer;
+			typedef const T *		const_pointer;
+			typedef T &				reference;
+			typedef const T &		const_reference;
+			typedef size_t			size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			template <class U>
+			struct rebind
+			{
+				typedef huge_page_allocator<U, Threshold, HugePage>	other;
+			};
+
+			/* node -1 leaves the placement to the kernel */
+			explicit huge_page_allocator(int numa_node = -1)
+			:	__node(numa_node)
+			{}
+			huge_page_allocator(const huge_page_allocator & other)
+			:	__node(other.numa_node())
+			{}
+			template <class U>
+			huge_page_allocator(const huge_page_allocator<U, Threshold, HugePage> & other)
+			:	__node(other.numa_node())
+			{}
+			~huge_page_allocator() {}
+
+			int numa_node() const
+			{
+				return __node;
+			}
+
+			pointer address(reference x) const
+			{
+				return &x;
+			}
+			const_pointer address(const_reference x) const
+			{
+				return &x;
+			}
+
+			size_type max_size() const
+			{
+				return static_cast<size_type>(-1) / sizeof(T);
+			}
+
+			pointer allocate(size_type n, const void * = 0)
+			{
+				void *res;
+
+				if (n > max_size())
+					throw std::bad_alloc();
+# if FT_HAS_THP
+				if (__mapped(n * sizeof(T)))
+					return static_cast<pointer>(__map(n * sizeof(T)));
+# endif
+				if (!(res = std::malloc(n ? n * sizeof(T) : 1)))
+					throw std::bad_alloc();
+				return static_cast<pointer>(res);
+			}
+
+			void deallocate(pointer p, size_type n)
+			{
+# if FT_HAS_THP
+				if (__mapped(n * sizeof(T)))
+				{
+					munmap(static_cast<void *>(p), __length(n * sizeof(T)));
+					__sync_fetch_and_sub(&huge_page_mapped_bytes(), __length(n * sizeof(T)));
+					return ;
+				}
+# endif
+				std::free(static_cast<void *>(p));
+			}
+
+			void construct(pointer p, const_reference value)
+			{
+				::new (static_cast<void *>(p)) T(value);
+			}
+
+			void destroy(pointer p)
+			{
+				p->~T();
+			}
+
+		private :
+
+			int		__node;
+
+			static bool __mapped(size_t bytes)
+			{
+				return bytes >= Threshold;
+			}
+
+			static size_t __length(size_t bytes)
+			{
+				return (bytes + HugePage - 1) / HugePage * HugePage;
+			}
+
+# if FT_HAS_THP
+			/*
+				maps HugePage more bytes than needed and unmaps both ends, so
+				that the block starts on a huge page boundary
+			*/
+			void *__map(size_t bytes) const
+			{
+				size_t	len = __length(bytes);
+				char	*raw = static_cast<char *>(mmap(NULL, len + HugePage, PROT_READ | PROT_WRITE,
+														MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+				char	*res;
+				size_t	head;
+
+				if (raw == MAP_FAILED)
+					throw std::bad_alloc();
+				head = (HugePage - reinterpret_cast<size_t>(raw) % HugePage) % HugePage;
+				res = raw + head;
+				if (head)
+					munmap(raw, head);
+				munmap(res + len, HugePage - head);
+				madvise(res, len, MADV_HUGEPAGE);
+				__bind(res, len);
+				__sync_fetch_and_add(&huge_page_mapped_bytes(), len);
+				return res;
+			}
+
+			void __bind(void *addr, size_t len) const
+			{
+#  if FT_HAS_MBIND
+				const int		mpol_bind = 2;
+				unsigned long	mask;
+
+				if (__node < 0 || __node >= static_cast<int>(8 * sizeof(mask)))
+					return ;
+				mask = 1UL << __node;
+				syscall(SYS_mbind, addr, len, mpol_bind, &mask, 8 * sizeof(mask) + 1, 0);
+#  else
+				(void)addr;
+				(void)len;
+#  endif
+			}
+# endif
+	};
+
+	template <class T, class U, size_t Th, size_t H>
+	bool operator==(const huge_page_allocator<T, Th, H> &, const huge_page_allocator<U, Th, H> &)
+	{
+		return true;
+	}
+
+	template <class T, class U, size_t Th, size_t H>
+	bool operator!=(const huge_page_allocator<T, Th, H> &, const huge_page_allocator<U, Th, H> &)
+	{
+		return false;
+	}
+
+	template <class T, size_t Threshold, size_t HugePage>
+	struct slab_traits< huge_page_allocator<T, Threshold, HugePage> >
+	{
+		static const size_t max_bytes = 2 * HugePage;
+	};
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef 	IS_TRIVIALLY_DESTRUCTIBLE_HPP
+# define 	IS_TRIVIALLY_DESTRUCTIBLE_HPP
+
+# include "pair.hpp"
+
+namespace ft
+{
+
+/* ------------------------ is trivially destructible ------------------------ */
+/*
+	checks whether destroying a T runs no code at all, so that a container may
+	release its storage without calling the destructor of every element.
+	relies on the compiler intrinsic, which is also available in C++98 mode;
+	unknown compilers conservatively get false
+*/
+template <class T>
+struct is_trivially_destructible
+{
+# if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+	static const bool value = __has_trivial_destructor(T);
+# else
+	static const bool value = false;
+# endif
+};
+
+/* the destructor of ft::pair is user-provided but empty, only members matter */
+template <class T1, class T2>
+struct is_trivially_destructible< ft::pair<T1, T2> >
+{
+	static const bool value = 	is_trivially_destructible<T1>::value
+								&& is_trivially_destructible<T2>::value;
+};
+
+}
+
+#endif
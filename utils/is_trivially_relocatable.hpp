@@ -0,0 +1,36 @@
+#ifndef 	IS_TRIVIALLY_RELOCATABLE_HPP
+# define 	IS_TRIVIALLY_RELOCATABLE_HPP
+
+# include "pair.hpp"
+
+namespace ft
+{
+
+/* ------------------------ is trivially relocatable ------------------------- */
+/*
+	checks whether moving a T to another address may be done by copying its
+	bytes and forgetting the source, without running its copy constructor and
+	destructor. True for trivially copyable types; a type whose copy is expensive
+	but which holds no pointer into itself (ft::vector, for instance) opts in by
+	specializing this template
+*/
+template <class T>
+struct is_trivially_relocatable
+{
+# if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+	static const bool value = __is_trivially_copyable(T);
+# else
+	static const bool value = false;
+# endif
+};
+
+template <class T1, class T2>
+struct is_trivially_relocatable< ft::pair<T1, T2> >
+{
+	static const bool value = 	is_trivially_relocatable<T1>::value
+								&& is_trivially_relocatable<T2>::value;
+};
+
+}
+
+#endif
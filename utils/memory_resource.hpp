@@ -0,0 +1,791 @@
+#ifndef 	MEMORY_RESOURCE_HPP
+# define 	MEMORY_RESOURCE_HPP
+
+# include <cstddef>
+# include <new>
+# include "config.hpp"
+
+# if FT_CXX11
+#  include <mutex>
+# else
+#  include <pthread.h>
+# endif
+
+namespace ft
+{
+namespace pmr
+{
+	/* Alignment ------------------------------------------------------------- */
+	/* alignof(T) in C++98: the padding in front of a T that follows a char */
+	template <class T>
+	struct alignment_of
+	{
+		struct __probe
+		{
+			char	c;
+			T		t;
+		};
+		static const size_t	value = sizeof(__probe) - sizeof(T);
+	};
+
+	union __max_align_t
+	{
+		long double		ld;
+		long long		ll;
+		void			*p;
+		void			(*f)();
+	};
+
+	/* the alignment operator new and malloc guarantee, the default of every resource */
+	const size_t	max_align = alignment_of<__max_align_t>::value;
+
+	inline size_t __align_up(size_t n, size_t align)
+	{
+		return (n + align - 1) & ~(align - 1);
+	}
+
+	/* Memory resource ------------------------------------------------------- */
+	/*
+		Where a polymorphic_allocator takes its memory from, chosen at run
+		time: containers of one type may draw from different arenas. As
+		std::pmr::memory_resource, in C++98. Alignments are powers of two
+	*/
+	class memory_resource
+	{
+		public :
+
+			virtual ~memory_resource() {}
+
+			void *allocate(size_t bytes, size_t align = max_align)
+			{
+				return do_allocate(bytes, align);
+			}
+
+			void deallocate(void *p, size_t bytes, size_t align = max_align)
+			{
+				do_deallocate(p, bytes, align);
+			}
+
+			/* whether memory from one may be freed by the other */
+			bool is_equal(const memory_resource & other) const
+			{
+				return do_is_equal(other);
+			}
+
+		private :
+
+			virtual void *do_allocate(size_t bytes, size_t align) = 0;
+			virtual void do_deallocate(void *p, size_t bytes, size_t align) = 0;
+			virtual bool do_is_equal(const memory_resource & other) const = 0;
+	};
+
+	inline bool operator==(const memory_resource & lhs, const memory_resource & rhs)
+	{
+		return &lhs == &rhs || lhs.is_equal(rhs);
+	}
+
+	inline bool operator!=(const memory_resource & lhs, const memory_resource & rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	/* Global resources ------------------------------------------------------ */
+	/*
+		operator new and delete. An over-aligned block is cut from a larger
+		one, the start of which is stored just in front of it
+	*/
+	class __new_delete_resource : public memory_resource
+	{
+		private :
+
+			void *do_allocate(size_t bytes, size_t align)
+			{
+				char	*raw;
+				char	*res;
+
+				if (align <= max_align)
+					return ::operator new(bytes);
+				raw = static_cast<char *>(::operator new(bytes + align + sizeof(void *)));
+				res = raw + __align_up(reinterpret_cast<size_t>(raw) + sizeof(void *), align)
+						- reinterpret_cast<size_t>(raw);
+				reinterpret_cast<void **>(res)[-1] = raw;
+				return res;
+			}
+
+			void do_deallocate(void *p, size_t, size_t align)
+			{
+				if (align <= max_align)
+					::operator delete(p);
+				else
+					::operator delete(static_cast<void **>(p)[-1]);
+			}
+
+			bool do_is_equal(const memory_resource & other) const
+			{
+				return this == &other;
+			}
+	};
+
+	/* throws std::bad_alloc on every allocation, an upstream that forbids falling back */
+	class __null_memory_resource : public memory_resource
+	{
+		private :
+
+			void *do_allocate(size_t, size_t)
+			{
+				throw std::bad_alloc();
+			}
+
+			void do_deallocate(void *, size_t, size_t)
+			{}
+
+			bool do_is_equal(const memory_resource & other) const
+			{
+				return this == &other;
+			}
+	};
+
+	inline memory_resource *new_delete_resource()
+	{
+		static __new_delete_resource	res;
+
+		return &res;
+	}
+
+	inline memory_resource *null_memory_resource()
+	{
+		static __null_memory_resource	res;
+
+		return &res;
+	}
+
+	inline memory_resource *& __default_resource()
+	{
+		static memory_resource	*res = new_delete_resource();
+
+		return res;
+	}
+
+	/* the resource of default constructed allocators, new_delete_resource() at first */
+	inline memory_resource *get_default_resource()
+	{
+		return __default_resource();
+	}
+
+	/* returns the previous one, NULL restores new_delete_resource(). Not thread safe */
+	inline memory_resource *set_default_resource(memory_resource *res)
+	{
+		memory_resource	*prev = __default_resource();
+
+		__default_resource() = res ? res : new_delete_resource();
+		return prev;
+	}
+
+	/* Monotonic buffer resource --------------------------------------------- */
+	/*
+		Arena: allocation bumps a pointer through the current chunk, a new
+		chunk twice as large is taken from upstream when it is full, and
+		deallocate does nothing. release() gives every chunk back at once
+		and starts over from the initial buffer.
+
+		Built once per request, it makes the containers of the request cheap
+		to build and to drop: a tree over it releases its node slabs without
+		visiting the nodes when the values are trivially destructible, a
+		vector of them destroys nothing, and nothing is freed until the
+		arena is released or destroyed, after the containers
+	*/
+	class monotonic_buffer_resource : public memory_resource
+	{
+		public :
+
+			explicit monotonic_buffer_resource(memory_resource *upstream = get_default_resource())
+			:	__upstream(upstream),
+				__initial(NULL),
+				__initial_size(0),
+				__first_chunk(__min_chunk),
+				__chunks(NULL)
+			{
+				release();
+			}
+
+			explicit monotonic_buffer_resource(	size_t initial_size,
+												memory_resource *upstream = get_default_resource())
+			:	__upstream(upstream),
+				__initial(NULL),
+				__initial_size(0),
+				__first_chunk(initial_size > __min_chunk ? initial_size : __min_chunk),
+				__chunks(NULL)
+			{
+				release();
+			}
+
+			/* buffer is used first, it is never given to upstream */
+			monotonic_buffer_resource(	void *buffer, size_t buffer_size,
+										memory_resource *upstream = get_default_resource())
+			:	__upstream(upstream),
+				__initial(static_cast<char *>(buffer)),
+				__initial_size(buffer_size),
+				__first_chunk(buffer_size * 2 > __min_chunk ? buffer_size * 2 : __min_chunk),
+				__chunks(NULL)
+			{
+				release();
+			}
+
+			~monotonic_buffer_resource()
+			{
+				release();
+			}
+
+			void release()
+			{
+				__chunk	*next;
+
+				while (__chunks)
+				{
+					next = __chunks->__next;
+					__upstream->deallocate(__chunks, __chunks->__bytes);
+					__chunks = next;
+				}
+				__chunks = NULL;
+				__cursor = __initial;
+				__end = __initial + __initial_size;
+				__next_chunk = __first_chunk;
+			}
+
+			memory_resource *upstream_resource() const
+			{
+				return __upstream;
+			}
+
+		private :
+
+			struct __chunk
+			{
+				__chunk		*__next;
+				size_t		__bytes;
+			};
+
+			static const size_t	__min_chunk = 1024;
+
+			memory_resource	*__upstream;
+			char			*__initial;
+			size_t			__initial_size;
+			size_t			__first_chunk;
+			size_t			__next_chunk;
+			__chunk			*__chunks;
+			char			*__cursor;
+			char			*__end;
+
+			monotonic_buffer_resource(const monotonic_buffer_resource &);
+			monotonic_buffer_resource &operator=(const monotonic_buffer_resource &);
+
+			void *do_allocate(size_t bytes, size_t align)
+			{
+				char	*res;
+
+				if (__cursor)
+				{
+					res = __cursor + (__align_up(reinterpret_cast<size_t>(__cursor), align)
+										- reinterpret_cast<size_t>(__cursor));
+					if (res <= __end && bytes <= static_cast<size_t>(__end - res))
+					{
+						__cursor = res + bytes;
+						return res;
+					}
+				}
+				__grow(bytes, align);
+				res = __cursor + (__align_up(reinterpret_cast<size_t>(__cursor), align)
+									- reinterpret_cast<size_t>(__cursor));
+				__cursor = res + bytes;
+				return res;
+			}
+
+			void do_deallocate(void *, size_t, size_t)
+			{}
+
+			bool do_is_equal(const memory_resource & other) const
+			{
+				return this == &other;
+			}
+
+			/* a chunk with room for bytes at align, its header included */
+			void __grow(size_t bytes, size_t align)
+			{
+				size_t	header = __align_up(sizeof(__chunk), max_align);
+				size_t	need = header + bytes + (align > max_align ? align : 0);
+				size_t	size = __next_chunk > need ? __next_chunk : need;
+				__chunk	*c = static_cast<__chunk *>(__upstream->allocate(size));
+
+				c->__next = __chunks;
+				c->__bytes = size;
+				__chunks = c;
+				__cursor = reinterpret_cast<char *>(c) + header;
+				__end = reinterpret_cast<char *>(c) + size;
+				__next_chunk = size * 2;
+			}
+	};
+
+	/* Pool resources -------------------------------------------------------- */
+	/*
+		max_blocks_per_chunk: the most blocks a pool takes from upstream at
+		once, its chunks double up to it. largest_required_pool_block: larger
+		blocks skip the pools and go to upstream one by one. 0 picks the
+		defaults, 1024 blocks and 4 KiB
+	*/
+	struct pool_options
+	{
+		size_t	max_blocks_per_chunk;
+		size_t	largest_required_pool_block;
+
+		pool_options()
+		:	max_blocks_per_chunk(0),
+			largest_required_pool_block(0)
+		{}
+	};
+
+	/*
+		One pool per power of two from 8 bytes to the largest block: a free
+		list of blocks of that size, refilled from chunks of upstream. Blocks
+		are freed to their pool's list, chunks only go back on release() or
+		destruction. Larger or over-aligned blocks are allocated from
+		upstream and kept on a list so that release() finds them too. Not
+		thread safe, see synchronized_pool_resource
+	*/
+	class unsynchronized_pool_resource : public memory_resource
+	{
+		public :
+
+			explicit unsynchronized_pool_resource(memory_resource *upstream = get_default_resource())
+			:	__upstream(upstream)
+			{
+				__init(pool_options());
+			}
+
+			explicit unsynchronized_pool_resource(	const pool_options & opts,
+													memory_resource *upstream = get_default_resource())
+			:	__upstream(upstream)
+			{
+				__init(opts);
+			}
+
+			~unsynchronized_pool_resource()
+			{
+				release();
+			}
+
+			void release()
+			{
+				__chunk	*next;
+				__large	*large;
+
+				for (size_t i = 0; i < __npools; ++i)
+				{
+					while (__pools[i].__chunks)
+					{
+						next = __pools[i].__chunks->__next;
+						__upstream->deallocate(__pools[i].__chunks, __pools[i].__chunks->__bytes);
+						__pools[i].__chunks = next;
+					}
+					__pools[i].__free = NULL;
+					__pools[i].__next_blocks = __min_blocks;
+				}
+				while (__large_blocks)
+				{
+					large = __large_blocks;
+					__large_blocks = large->__next;
+					__upstream->deallocate(reinterpret_cast<char *>(large) + sizeof(__large) - large->__offset,
+											large->__offset + large->__bytes, large->__align);
+				}
+			}
+
+			memory_resource *upstream_resource() const
+			{
+				return __upstream;
+			}
+
+			pool_options options() const
+			{
+				return __opts;
+			}
+
+		private :
+
+			struct __block
+			{
+				__block		*__next;
+			};
+
+			struct __chunk
+			{
+				__chunk		*__next;
+				size_t		__bytes;
+			};
+
+			/* in front of a large block, doubly linked so that it leaves the list in O(1) */
+			struct __large
+			{
+				__large		*__prev;
+				__large		*__next;
+				size_t		__offset;	/* from the upstream block to the user block */
+				size_t		__bytes;
+				size_t		__align;
+			};
+
+			struct __pool
+			{
+				__block		*__free;
+				__chunk		*__chunks;
+				size_t		__next_blocks;
+			};
+
+			static const size_t	__min_block = 8;
+			static const size_t	__min_blocks = 8;
+			static const size_t	__max_pools = 20;		/* 8 B .. 4 MiB */
+
+			memory_resource	*__upstream;
+			pool_options	__opts;
+			__pool			__pools[__max_pools];
+			size_t			__npools;
+			__large			*__large_blocks;
+
+			unsynchronized_pool_resource(const unsynchronized_pool_resource &);
+			unsynchronized_pool_resource &operator=(const unsynchronized_pool_resource &);
+
+			void __init(const pool_options & opts)
+			{
+				__opts = opts;
+				if (!__opts.max_blocks_per_chunk)
+					__opts.max_blocks_per_chunk = 1024;
+				if (__opts.max_blocks_per_chunk < __min_blocks)
+					__opts.max_blocks_per_chunk = __min_blocks;
+				if (!__opts.largest_required_pool_block)
+					__opts.largest_required_pool_block = 4096;
+				__npools = 1;
+				while (__npools < __max_pools && __block_size(__npools - 1) < __opts.largest_required_pool_block)
+					++__npools;
+				__opts.largest_required_pool_block = __block_size(__npools - 1);
+				for (size_t i = 0; i < __npools; ++i)
+				{
+					__pools[i].__free = NULL;
+					__pools[i].__chunks = NULL;
+					__pools[i].__next_blocks = __min_blocks;
+				}
+				__large_blocks = NULL;
+			}
+
+			static size_t __block_size(size_t pool)
+			{
+				return __min_block << pool;
+			}
+
+			/* the pool of the smallest blocks holding bytes at align, __npools if none */
+			size_t __pool_index(size_t bytes, size_t align) const
+			{
+				size_t	need = bytes > align ? bytes : align;
+				size_t	i = 0;
+
+				if (align > max_align)
+					return __npools;
+				while (i < __npools && __block_size(i) < need)
+					++i;
+				return i;
+			}
+
+			void *do_allocate(size_t bytes, size_t align)
+			{
+				size_t	i = __pool_index(bytes, align);
+				__block	*b;
+
+				if (i == __npools)
+					return __allocate_large(bytes, align);
+				if (!__pools[i].__free)
+					__refill(i);
+				b = __pools[i].__free;
+				__pools[i].__free = b->__next;
+				return b;
+			}
+
+			void do_deallocate(void *p, size_t bytes, size_t align)
+			{
+				size_t	i = __pool_index(bytes, align);
+				__block	*b = static_cast<__block *>(p);
+
+				if (i == __npools)
+					return __deallocate_large(p);
+				b->__next = __pools[i].__free;
+				__pools[i].__free = b;
+			}
+
+			bool do_is_equal(const memory_resource & other) const
+			{
+				return this == &other;
+			}
+
+			/* carves a new chunk of the pool into blocks, chunks double up to max_blocks_per_chunk */
+			void __refill(size_t i)
+			{
+				size_t	block = __block_size(i);
+				size_t	header = __align_up(sizeof(__chunk), max_align);
+				size_t	count = __pools[i].__next_blocks;
+				__chunk	*c = static_cast<__chunk *>(__upstream->allocate(header + count * block));
+				char	*first = reinterpret_cast<char *>(c) + header;
+				__block	*b;
+
+				c->__next = __pools[i].__chunks;
+				c->__bytes = header + count * block;
+				__pools[i].__chunks = c;
+				for (size_t k = count; k > 0; --k)
+				{
+					b = reinterpret_cast<__block *>(first + (k - 1) * block);
+					b->__next = __pools[i].__free;
+					__pools[i].__free = b;
+				}
+				if (count < __opts.max_blocks_per_chunk)
+					__pools[i].__next_blocks = count * 2 < __opts.max_blocks_per_chunk
+												? count * 2 : __opts.max_blocks_per_chunk;
+			}
+
+			void *__allocate_large(size_t bytes, size_t align)
+			{
+				size_t	up_align = align > max_align ? align : max_align;
+				size_t	offset = __align_up(sizeof(__large), up_align);
+				char	*raw = static_cast<char *>(__upstream->allocate(offset + bytes, up_align));
+				__large	*large = reinterpret_cast<__large *>(raw + offset - sizeof(__large));
+
+				large->__prev = NULL;
+				large->__next = __large_blocks;
+				large->__offset = offset;
+				large->__bytes = bytes;
+				large->__align = up_align;
+				if (__large_blocks)
+					__large_blocks->__prev = large;
+				__large_blocks = large;
+				return raw + offset;
+			}
+
+			void __deallocate_large(void *p)
+			{
+				__large	*large = reinterpret_cast<__large *>(static_cast<char *>(p) - sizeof(__large));
+
+				if (large->__prev)
+					large->__prev->__next = large->__next;
+				else
+					__large_blocks = large->__next;
+				if (large->__next)
+					large->__next->__prev = large->__prev;
+				__upstream->deallocate(static_cast<char *>(p) - large->__offset,
+										large->__offset + large->__bytes, large->__align);
+			}
+	};
+
+	/* the same pools behind a mutex, for a resource shared between threads */
+	class synchronized_pool_resource : public memory_resource
+	{
+		public :
+
+			explicit synchronized_pool_resource(memory_resource *upstream = get_default_resource())
+			:	__pools(upstream)
+			{
+				__init_lock();
+			}
+
+			explicit synchronized_pool_resource(const pool_options & opts,
+												memory_resource *upstream = get_default_resource())
+			:	__pools(opts, upstream)
+			{
+				__init_lock();
+			}
+
+			~synchronized_pool_resource()
+			{
+# if !FT_CXX11
+				pthread_mutex_destroy(&__mutex);
+# endif
+			}
+
+			void release()
+			{
+				__lock();
+				__pools.release();
+				__unlock();
+			}
+
+			memory_resource *upstream_resource() const
+			{
+				return __pools.upstream_resource();
+			}
+
+			pool_options options() const
+			{
+				return __pools.options();
+			}
+
+		private :
+
+			unsynchronized_pool_resource	__pools;
+# if FT_CXX11
+			std::mutex						__mutex;
+# else
+			pthread_mutex_t					__mutex;
+# endif
+
+			synchronized_pool_resource(const synchronized_pool_resource &);
+			synchronized_pool_resource &operator=(const synchronized_pool_resource &);
+
+			void __init_lock()
+			{
+# if !FT_CXX11
+				pthread_mutex_init(&__mutex, NULL);
+# endif
+			}
+			void __lock()
+			{
+# if FT_CXX11
+				__mutex.lock();
+# else
+				pthread_mutex_lock(&__mutex);
+# endif
+			}
+			void __unlock()
+			{
+# if FT_CXX11
+				__mutex.unlock();
+# else
+				pthread_mutex_unlock(&__mutex);
+# endif
+			}
+
+			void *do_allocate(size_t bytes, size_t align)
+			{
+				void	*res;
+
+				__lock();
+				try
+				{
+					res = __pools.allocate(bytes, align);
+				}
+				catch (...)
+				{
+					__unlock();
+					throw ;
+				}
+				__unlock();
+				return res;
+			}
+
+			void do_deallocate(void *p, size_t bytes, size_t align)
+			{
+				__lock();
+				__pools.deallocate(p, bytes, align);
+				__unlock();
+			}
+
+			bool do_is_equal(const memory_resource & other) const
+			{
+				return this == &other;
+			}
+	};
+
+	/* Polymorphic allocator ------------------------------------------------- */
+	/*
+		The Allocator of any ft:: container, drawing from a memory_resource
+		chosen at construction (get_default_resource() by default). Rebound
+		copies, the tree nodes and pool slabs of a map for instance, share
+		the resource. Allocators compare equal when their resources do
+	*/
+	template <class T>
+	class polymorphic_allocator
+	{
+		public :
+
+			typedef T				value_type;
+			typedef T *				pointer;
+			typedef const T *		const_pointer;
+			typedef T &				reference;
+			typedef const T &		const_reference;
+			typedef size_t			size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			template <class U>
+			struct rebind
+			{
+				typedef polymorphic_allocator<U>	other;
+			};
+
+			polymorphic_allocator()
+			:	__res(get_default_resource())
+			{}
+			/* implicit, a resource pointer is passed where an allocator is expected */
+			polymorphic_allocator(memory_resource *res)
+			:	__res(res)
+			{}
+			polymorphic_allocator(const polymorphic_allocator & other)
+			:	__res(other.resource())
+			{}
+			template <class U>
+			polymorphic_allocator(const polymorphic_allocator<U> & other)
+			:	__res(other.resource())
+			{}
+			~polymorphic_allocator() {}
+
+			memory_resource *resource() const
+			{
+				return __res;
+			}
+
+			pointer address(reference x) const
+			{
+				return &x;
+			}
+			const_pointer address(const_reference x) const
+			{
+				return &x;
+			}
+
+			size_type max_size() const
+			{
+				return static_cast<size_type>(-1) / sizeof(T);
+			}
+
+			pointer allocate(size_type n, const void * = 0)
+			{
+				if (n > max_size())
+					throw std::bad_alloc();
+				return static_cast<pointer>(__res->allocate(n * sizeof(T), alignment_of<T>::value));
+			}
+
+			void deallocate(pointer p, size_type n)
+			{
+				__res->deallocate(p, n * sizeof(T), alignment_of<T>::value);
+			}
+
+			void construct(pointer p, const_reference value)
+			{
+				::new (static_cast<void *>(p)) T(value);
+			}
+
+			void destroy(pointer p)
+			{
+				p->~T();
+			}
+
+		private :
+
+			memory_resource	*__res;
+	};
+
+	template <class T, class U>
+	bool operator==(const polymorphic_allocator<T> & lhs, const polymorphic_allocator<U> & rhs)
+	{
+		return *lhs.resource() == *rhs.resource();
+	}
+
+	template <class T, class U>
+	bool operator!=(const polymorphic_allocator<T> & lhs, const polymorphic_allocator<U> & rhs)
+	{
+		return !(lhs == rhs);
+	}
+}
+}
+
+#endif
@@ -1,46 +1,307 @@
 #ifndef 	NODE_HPP
 # define 	NODE_HPP
 
+# include <cstddef>
+# include "config.hpp"
+
 namespace ft
 {
-	template <class T>
-	struct Node
+# if FT_CXX11
+	/* selects the Node constructor building the value in place from its arguments */
+	struct emplace_tag
+	{};
+# endif
+
+	/* Augmentation policies ------------------------------------------------ */
+	/*
+		A policy adds data to every node through node_base and keeps it right: 
+		update(n) recomputes n from its children, propagate(n, stop) does it for 
+		n and its ancestors up to stop. The tree calls update after rotations 
+		and propagate after linking or unlinking a node
+	*/
+	struct no_augment
+	{
+		static const bool	is_threaded = false;
+		static const bool	counts_nodes = false;
+
+		/* empty base, a plain node stays the same size */
+		struct node_base
+		{};
+
+		template <class N>
+		static void update(N *)
+		{}
+		template <class N>
+		static void propagate(N *, N *)
+		{}
+	};
+
+	/* every node counts the nodes of its subtree: rank and select in O(log n) */
+	struct order_statistics
+	{
+		static const bool	is_threaded = false;
+		static const bool	counts_nodes = true;
+
+		struct node_base
+		{
+			size_t	__count;
+
+			node_base()
+			: __count(1)
+			{}
+		};
+
+		template <class N>
+		static size_t count(const N *n)
+		{
+			return n ? n->__count : 0;
+		}
+		template <class N>
+		static void update(N *n)
+		{
+			n->__count = 1 + count(n->__left) + count(n->__right);
+		}
+		template <class N>
+		static void propagate(N *n, N *stop)
+		{
+			for (; n && n != stop; n = n->parent())
+				update(n);
+		}
+	};
+
+	/*
+		Threaded nodes also link to their neighbours in key order, through the 
+		tree's nil node at both ends, so ++ and -- follow a single pointer and 
+		--end() is the last element. Costs two pointers per node and a few 
+		more stores per insert and erase. Augment may be any other policy
+	*/
+	template <class Augment = no_augment>
+	struct threaded : public Augment
+	{
+		static const bool	is_threaded = true;
+	};
+
+	/* Neighbours in key order ---------------------------------------------- */
+	/* found through the tree's links, O(log n) worst case, O(1) amortized */
+	template <class N>
+	struct node_walk
+	{
+		static N *minimum(N *elem)
+		{
+			while (elem && elem->__left)
+				elem = elem->__left;
+			return elem;
+		}
+		static N *maximum(N *elem)
+		{
+			while (elem && elem->__right)
+				elem = elem->__right;
+			return elem;
+		}
+		/* NULL past the root of a detached tree */
+		static N *successor(N *elem)
+		{
+			N *tmp = elem->parent();
+
+			if (elem->__right)
+				return minimum(elem->__right);
+			while (tmp && elem == tmp->__right)
+			{
+				elem = tmp;
+				tmp = tmp->parent();
+			}
+			return tmp;
+		}
+		static N *predecessor(N *elem)
+		{
+			N *tmp = elem->parent();
+
+			if (elem->__left)
+				return maximum(elem->__left);
+			while (tmp && elem == tmp->__left)
+			{
+				elem = tmp;
+				tmp = tmp->parent();
+			}
+			return tmp;
+		}
+	};
+
+	/* unthreaded: the list updates do nothing */
+	template <class N, bool Threaded>
+	struct node_thread : public node_walk<N>
+	{
+		static void link(N *, N *)
+		{}
+		static void insert_before(N *, N *)
+		{}
+		static void insert_after(N *, N *)
+		{}
+		static void unthread(N *)
+		{}
+		/* drops the segment [first, stop) of the list */
+		static void unthread(N *, N *)
+		{}
+	};
+
+	template <class N>
+	struct node_thread<N, true>
+	{
+		N	*__next;
+		N	*__prev;
+
+		node_thread()
+		:	__next(NULL),
+			__prev(NULL)
+		{}
+
+		/* the node after next is fetched while next is being used */
+		static N *successor(N *elem)
+		{
+			N *next = elem->__next;
+
+			FT_PREFETCH(next->__next);
+			return next;
+		}
+		static N *predecessor(N *elem)
+		{
+			N *prev = elem->__prev;
+
+			FT_PREFETCH(prev->__prev);
+			return prev;
+		}
+		static void link(N *prev, N *next)
+		{
+			prev->__next = next;
+			next->__prev = prev;
+		}
+		static void insert_before(N *pos, N *elem)
+		{
+			link(pos->__prev, elem);
+			link(elem, pos);
+		}
+		static void insert_after(N *pos, N *elem)
+		{
+			link(elem, pos->__next);
+			link(pos, elem);
+		}
+		static void unthread(N *elem)
+		{
+			link(elem->__prev, elem->__next);
+		}
+		static void unthread(N *first, N *stop)
+		{
+			link(first->__prev, stop);
+		}
+	};
+
+	/* Subtree sizes: read at the root when the policy counts nodes ---------- */
+	template <class N, bool Counted>
+	struct node_count
+	{
+		static const bool	known = false;
+
+		static size_t of(const N *)
+		{
+			return 0;
+		}
+	};
+
+	template <class N>
+	struct node_count<N, true>
+	{
+		static const bool	known = true;
+
+		static size_t of(const N *n)
+		{
+			return n ? n->__count : 0;
+		}
+	};
+
+	/*
+		Links come first and the value last, so that a descent reads the key
+		and the child pointers from the start of the node. The color is the
+		low bit of the parent pointer: nodes are at least pointer aligned, the
+		bit is always free, and a node is one pointer smaller (Node<long> is
+		32 bytes instead of 40). Parent and color are only accessed through
+		parent() / set_parent() and is_red() / set_red()
+	*/
+	template <class T, class Augment = no_augment>
+	struct Node : public Augment::node_base, 
+				  public node_thread<Node<T, Augment>, Augment::is_threaded>
 	{
 		typedef T 			value_type;
 		typedef Node * 		node_pointer;
 
+		static const bool	is_threaded = Augment::is_threaded;
+
 		Node()
 		{}
 		explicit Node(	const value_type & value, bool is_red = true,
 						node_pointer parent = NULL, node_pointer right = NULL, node_pointer left = NULL)
-		:	_value(value), 		__is_red(is_red), 
-			__parent(parent), 	__right(right), 
-			__left(left)
+		:	__left(left),		__right(right),
+			__parent_color(__pack(parent, is_red)),
+			_value(value)
 		{}
+# if FT_CXX11
+		template <class... Args>
+		explicit Node(emplace_tag, Args &&... args)
+		:	__left(NULL),		__right(NULL),
+			__parent_color(__pack(NULL, true)),
+			_value(std::forward<Args>(args)...)
+		{}
+# endif
 		Node(const Node & rhs) 
-		: 	_value(rhs._value), 	__is_red(rhs.__is_red), 
-			__parent(rhs.__parent), __right(rhs.__right), 
-			__left(rhs.__left)
+		: 	Augment::node_base(rhs),
+			__left(rhs.__left),	__right(rhs.__right),
+			__parent_color(rhs.__parent_color),
+			_value(rhs._value)
 		{}
 		Node &operator=(const Node & rhs)
 		{
 			if (this != &rhs)
 			{
-				this->_value = rhs._value;
-				this->__is_red = rhs.__is_red;
-				this->parent = rhs.__parent;
-				this->__right = rhs.__right;
 				this->__left = rhs.__left;
+				this->__right = rhs.__right;
+				this->__parent_color = rhs.__parent_color;
+				this->_value = rhs._value;
 			}
 			return *this;
 		}
 		~Node() {}
+
+		node_pointer parent() const
+		{
+			return reinterpret_cast<node_pointer>(__parent_color & ~static_cast<size_t>(1));
+		}
+		bool is_red() const
+		{
+			return __parent_color & 1;
+		}
+		void set_parent(node_pointer parent)
+		{
+			__parent_color = __pack(parent, is_red());
+		}
+		void set_red(bool is_red)
+		{
+			__parent_color = (__parent_color & ~static_cast<size_t>(1)) | is_red;
+		}
+		/* both at once, for a node whose fields are not initialized yet */
+		void set_parent_and_color(node_pointer parent, bool is_red)
+		{
+			__parent_color = __pack(parent, is_red);
+		}
 	
-		value_type 			_value;
-		bool 				__is_red;
-		node_pointer 		__parent;
-		node_pointer 		__right;
 		node_pointer 		__left;
+		node_pointer 		__right;
+		size_t				__parent_color;
+		value_type 			_value;
+
+		private :
+			static size_t __pack(node_pointer parent, bool is_red)
+			{
+				return reinterpret_cast<size_t>(parent) | is_red;
+			}
 	};
 }
 
@@ -0,0 +1,224 @@
+#ifndef 	NODE_HANDLE_HPP
+# define 	NODE_HANDLE_HPP
+
+# include <cstddef>
+# include <algorithm>
+# include "config.hpp"
+# include "enable_if.hpp"
+
+namespace ft
+{
+	/* Node handle ----------------------------------------------------------- */
+	/*
+		Owns a node taken out of a tree by extract(): the value stays where it
+		was built and is linked again by insert(node_type), into the same
+		tree or another one with an equal allocator, without any allocation
+		or copy. The handle holds the pool group of the tree it comes from
+		(see node_pool::group_ref), so the node outlives that tree and a
+		dropped node goes back to the group's free list; extracting or
+		dropping never allocates. An empty handle owns nothing
+
+		In C++98 a copy takes the node away from its source, as std::auto_ptr
+		does; in C++11 the handle is move-only
+	*/
+	template <class Tree>
+	class node_handle
+	{
+		public :
+
+			typedef typename Tree::value_type		value_type;
+			typedef typename Tree::allocator_type	allocator_type;
+			typedef typename Tree::node				node;
+			typedef typename Tree::node__allocator	node_allocator;
+			typedef typename Tree::pool_type		pool_type;
+			typedef typename pool_type::group_ref	group_type;
+
+			node_handle()
+			:	__alloc(),
+				__group(node_allocator(__alloc)),
+				__node(NULL)
+			{}
+
+			/* takes elem, just unlinked from the tree from */
+			node_handle(node *elem, Tree & from, const allocator_type & alloc)
+			:	__alloc(alloc),
+				__group(node_allocator(alloc)),
+				__node(elem)
+			{
+				from.share_pool(__group);
+			}
+
+# if FT_CXX11
+			node_handle(node_handle && other)
+			:	__alloc(other.__alloc),
+				__group(node_allocator(other.__alloc)),
+				__node(NULL)
+			{
+				__take(other);
+			}
+
+			node_handle & operator=(node_handle && other)
+			{
+				if (this != &other)
+				{
+					__destroy();
+					__take(other);
+				}
+				return *this;
+			}
+
+			node_handle(const node_handle &) = delete;
+			node_handle & operator=(const node_handle &) = delete;
+
+			explicit operator bool() const
+			{
+				return __node != NULL;
+			}
+# else
+			node_handle(const node_handle & other)
+			:	__alloc(other.__alloc),
+				__group(node_allocator(other.__alloc)),
+				__node(NULL)
+			{
+				__take(const_cast<node_handle &>(other));
+			}
+
+			node_handle & operator=(const node_handle & other)
+			{
+				if (this != &other)
+				{
+					__destroy();
+					__take(const_cast<node_handle &>(other));
+				}
+				return *this;
+			}
+# endif
+
+			~node_handle()
+			{
+				__destroy();
+			}
+
+			bool empty() const
+			{
+				return __node == NULL;
+			}
+
+			allocator_type get_allocator() const
+			{
+				return __alloc;
+			}
+
+			/* the handle must not be empty */
+			value_type & value() const
+			{
+				return __node->_value;
+			}
+
+			void swap(node_handle & other)
+			{
+				std::swap(__alloc, other.__alloc);
+				__group.swap(other.__group);
+				std::swap(__node, other.__node);
+			}
+
+			/* for the containers: the node, its group, and giving it up ----- */
+			node *base() const
+			{
+				return __node;
+			}
+			group_type & group()
+			{
+				return __group;
+			}
+			/* once linked in a tree sharing the group */
+			node *release()
+			{
+				node *elem = __node;
+
+				__node = NULL;
+				__group.release();
+				return elem;
+			}
+
+		private :
+
+			allocator_type	__alloc;
+			group_type		__group;
+			node			*__node;
+
+			void __take(node_handle & other)
+			{
+				__alloc = other.__alloc;
+				__group.swap(other.__group);
+				__node = other.__node;
+				other.__node = NULL;
+			}
+
+			void __destroy()
+			{
+				node_allocator	alloc(__alloc);
+
+				if (__node)
+				{
+					alloc.destroy(__node);
+					__group.give_back(__node);
+					__node = NULL;
+				}
+				__group.release();
+			}
+	};
+
+	/* the node handle of map, whose key can be changed before it is inserted */
+	template <class Tree>
+	class map_node_handle : public node_handle<Tree>
+	{
+		public :
+
+			typedef node_handle<Tree>							base_type;
+			typedef typename base_type::value_type				value_type;
+			typedef typename remove_const<typename value_type::first_type>::type	key_type;
+			typedef typename value_type::second_type			mapped_type;
+			typedef typename base_type::allocator_type			allocator_type;
+			typedef typename base_type::node					node;
+
+			map_node_handle()
+			:	base_type()
+			{}
+
+			map_node_handle(node *elem, Tree & from, const allocator_type & alloc)
+			:	base_type(elem, from, alloc)
+			{}
+
+			/* the handle must not be empty */
+			key_type & key() const
+			{
+				return const_cast<key_type &>(this->base()->_value.first);
+			}
+			mapped_type & mapped() const
+			{
+				return this->base()->_value.second;
+			}
+	};
+
+	/* node_type of the containers whose tree cannot hand out its nodes */
+	struct no_node_handle
+	{};
+
+	/* what insert(node_type) returns: the node comes back when the key was taken */
+	template <class Iterator, class NodeType>
+	struct node_insert_return
+	{
+		Iterator	position;
+		bool		inserted;
+		NodeType	node;
+	};
+
+	template <class Tree>
+	void swap(node_handle<Tree> & lhs, node_handle<Tree> & rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -0,0 +1,620 @@
+#ifndef 	NODE_POOL_HPP
+# define 	NODE_POOL_HPP
+
+# include <memory>
+# include <cstddef>
+# include <algorithm>
+# include <functional>
+# include "slab_traits.hpp"
+
+namespace ft
+{
+	/* Node pool ------------------------------------------------------------- */
+	/*
+		Hands out uninitialized blocks of sizeof(T) carved from slabs that are
+		obtained from Allocator. Freed blocks are kept on a free list and reused
+		by the next allocate(); memory goes back to Allocator only in release(),
+		which drops every slab at once. Slabs double in size up to __max_slab
+		blocks, or up to slab_traits<Allocator>::max_bytes, so a pool of n
+		nodes costs O(log n) allocator calls
+
+		The slabs, the free list and the unused end of the last slab belong to 
+		an arena, stored at the head of the first slab. Trees that hand nodes 
+		to each other (join, merge, node handles) share their arenas first: 
+		after a.share(b) both pools allocate from and free to one arena, so a 
+		block freed by either is reused by either. A pool leaving the group 
+		leaves its slabs to the others; when the free blocks of a group have 
+		doubled since it last looked, sharing or leaving sweeps it and gives 
+		back the slabs no block is used in. The last pool of the group 
+		releases every slab. The allocators of a group must compare equal
+
+		A group is not locked: its free list and reference count are updated 
+		by every pool in it, so trees that ever exchanged nodes must not be 
+		used from different threads at once until all but one of them have 
+		been cleared or destroyed
+	*/
+	template <class T, class Allocator = std::allocator<T>, bool Pooled = true>
+	class node_pool
+	{
+		public :
+
+			typedef T				value_type;
+			typedef T *				pointer;
+			typedef Allocator		allocator_type;
+			typedef size_t			size_type;
+
+			static const bool		pooled = true;
+
+			explicit node_pool(const allocator_type & alloc = allocator_type())
+			:	__alloc(alloc),
+				__group(NULL)
+			{}
+
+			~node_pool()
+			{
+				release();
+			}
+
+			/* returns storage for one T, nothing is constructed */
+			pointer allocate()
+			{
+				__arena *a = __live();
+				__block *b;
+
+				if (a && a->__free)
+				{
+					b = a->__free;
+					if (b->__count == 1)
+						a->__free = b->__next;
+					else
+						__split_run(a, b);
+					--a->__free_count;
+					return reinterpret_cast<pointer>(b);
+				}
+				if (!a || a->__cursor == a->__cursor_end)
+					a = __grow(a);
+				return a->__cursor++;
+			}
+
+			/* p must come from this pool's group and must already be destroyed */
+			void deallocate(pointer p)
+			{
+				__push(__live(), p, 1);
+			}
+
+			/* 
+				returns every slab to the allocator, all blocks become invalid. 
+				In a group, the pool only leaves it: the slabs stay while 
+				another pool of the group is alive, and the blocks the pool 
+				still used are lost to the group unless deallocated first
+			*/
+			void release()
+			{
+				__arena *a = __live();
+
+				if (a && a->__refs > 1)
+					__maybe_sweep(a);
+				__unref(__group, __alloc);
+				__group = NULL;
+			}
+
+			/* whether another pool shares the slabs, see release() */
+			bool shared()
+			{
+				__arena *a = __live();
+
+				return a && a->__refs > 1;
+			}
+
+			/* puts this pool and other in one group, see above */
+			void share(node_pool & other)
+			{
+				if (this != &other)
+					__share(other.__group);
+			}
+
+			void swap(node_pool & rhs)
+			{
+				std::swap(__alloc, rhs.__alloc);
+				std::swap(__group, rhs.__group);
+			}
+
+			class group_ref;
+
+			/* an empty reference takes this pool's group, see group_ref */
+			void share(group_ref & other)
+			{
+				__share(other.__group);
+			}
+
+		private :
+
+			/* 
+				a free block and a slab header are stored inside the T storage. 
+				A free block starts a run of __count blocks: what was left of 
+				a slab after a merge, or neighbours joined by a sweep 
+			*/
+			struct __block
+			{
+				__block		*__next;
+				size_type	__count;
+			};
+			/* 
+				__count blocks, the first __header of them hold this header, 
+				and an arena right after it when __holds_arena is set 
+			*/
+			struct __slab
+			{
+				__slab		*__next;
+				size_type	__count;
+				size_type	__header;
+				bool		__holds_arena;
+			};
+			/* 
+				the state of a group, right after the header of its first slab. 
+				__free_tail is valid while __free is not NULL, __free_count 
+				counts blocks, runs included. Merging two groups empties one 
+				arena and forwards it to the other, which it holds a reference 
+				on; its slab can go once its own references are gone
+			*/
+			struct __arena
+			{
+				__block		*__free;
+				__block		*__free_tail;
+				size_type	__free_count;
+				size_type	__sweep_at;
+				pointer		__cursor;
+				pointer		__cursor_end;
+				__slab		*__slabs;
+				__slab		*__tail;
+				size_type	__next_slab;
+				size_type	__refs;
+				__arena		*__forward;
+			};
+
+			static const size_type	__min_slab = 16;
+			static const size_type	__max_slab = 2048;
+			static const size_type	__header = (sizeof(__slab) + sizeof(T) - 1) / sizeof(T);
+			static const size_type	__first_header = (sizeof(__slab) + sizeof(__arena) + sizeof(T) - 1) / sizeof(T);
+
+			allocator_type	__alloc;
+			__arena			*__group;	/* NULL until the first allocation */
+
+			node_pool(const node_pool &);
+			node_pool &operator=(const node_pool &);
+
+			/* the arena of the group, followed to where it was merged into */
+			__arena *__live()
+			{
+				return __live(__group, __alloc);
+			}
+
+			static __arena *__live(__arena *& group, allocator_type & alloc)
+			{
+				if (group && group->__forward)
+					return __find_group(group, alloc);
+				return group;
+			}
+
+			/* both pools, or this pool and a reference, end up in one group */
+			void __share(__arena *& group)
+			{
+				__arena *a = __live();
+				__arena *b = __live(group, __alloc);
+
+				if (a == b)
+					return;
+				/* what never allocated has no arena, it joins the other one */
+				if (!b)
+				{
+					++a->__refs;
+					group = a;
+				}
+				else if (!a)
+					__adopt(b);
+				else
+				{
+					__merge(a, b);
+					__maybe_sweep(a);
+				}
+			}
+
+			/* a new slab, the first one also holds the arena */
+			__arena *__grow(__arena *a)
+			{
+				size_type	header = a ? __header : __first_header;
+				size_type	count = header + (a ? a->__next_slab : __min_slab);
+				pointer		mem = __alloc.allocate(count);
+				__slab		*s = reinterpret_cast<__slab *>(mem);
+
+				s->__count = count;
+				s->__header = header;
+				s->__holds_arena = !a;
+				s->__next = NULL;
+				if (!a)
+				{
+					a = reinterpret_cast<__arena *>(s + 1);
+					a->__free = NULL;
+					a->__free_tail = NULL;
+					a->__free_count = 0;
+					a->__sweep_at = __max_slab;
+					a->__tail = s;
+					a->__next_slab = __min_slab;
+					a->__refs = 1;
+					a->__forward = NULL;
+					__group = a;
+				}
+				else
+					s->__next = a->__slabs;
+				a->__slabs = s;
+				a->__cursor = mem + header;
+				a->__cursor_end = mem + count;
+				if (a->__next_slab < __slab_limit())
+					a->__next_slab = a->__next_slab * 2 < __slab_limit() ? a->__next_slab * 2 : __slab_limit();
+				return a;
+			}
+
+			/* blocks of the largest slab, which fits in max_bytes header included */
+			static size_type __slab_limit()
+			{
+				size_type max_blocks = slab_traits<allocator_type>::max_bytes / sizeof(T);
+
+				return max_blocks > __max_slab + __header ? max_blocks - __header : __max_slab;
+			}
+
+			/* the first block of the run b is taken, the rest stays at the head */
+			static void __split_run(__arena *a, __block *b)
+			{
+				__block *rest = reinterpret_cast<__block *>(reinterpret_cast<pointer>(b) + 1);
+
+				rest->__next = b->__next;
+				rest->__count = b->__count - 1;
+				if (a->__free_tail == b)
+					a->__free_tail = rest;
+				a->__free = rest;
+			}
+
+			static void __push(__arena *a, pointer p, size_type count)
+			{
+				__block *b = reinterpret_cast<__block *>(p);
+
+				b->__next = a->__free;
+				b->__count = count;
+				if (!a->__free)
+					a->__free_tail = b;
+				a->__free = b;
+				a->__free_count += count;
+			}
+
+			/* 
+				b gives its slabs, its free list and the end of its last slab 
+				to a, in O(1), and forwards to it. b itself lives in a slab a 
+				now owns
+			*/
+			static void __merge(__arena *a, __arena *b)
+			{
+				b->__tail->__next = a->__slabs;
+				a->__slabs = b->__slabs;
+				if (b->__free)
+				{
+					b->__free_tail->__next = a->__free;
+					if (!a->__free)
+						a->__free_tail = b->__free_tail;
+					a->__free = b->__free;
+					a->__free_count += b->__free_count;
+				}
+				if (b->__cursor != b->__cursor_end)
+					__push(a, b->__cursor, static_cast<size_type>(b->__cursor_end - b->__cursor));
+				if (b->__next_slab > a->__next_slab)
+					a->__next_slab = b->__next_slab;
+				b->__free = NULL;
+				b->__free_count = 0;
+				b->__slabs = NULL;
+				b->__tail = NULL;
+				b->__cursor = NULL;
+				b->__cursor_end = NULL;
+				b->__forward = a;
+				++a->__refs;
+			}
+
+			void __maybe_sweep(__arena *a)
+			{
+				if (a->__free_count < a->__sweep_at)
+					return ;
+				__sweep(a);
+				a->__sweep_at = 2 * a->__free_count > __max_slab ? 2 * a->__free_count : __max_slab;
+			}
+
+			/* 
+				O(f log f) for f free blocks: the free list and the slabs are 
+				sorted by address and walked together. A slab whose blocks are 
+				all free goes back to Allocator, unless it holds an arena still 
+				referenced. The blocks left are linked again in address order, 
+				neighbours joined in runs
+			*/
+			void __sweep(__arena *a)
+			{
+				__slab		*s = __sort(a->__slabs);
+				__slab		*next;
+				__block		*b;
+				__block		*first;
+				__block		*tail = NULL;
+				size_type	count;
+				pointer		end;
+
+				if (a->__cursor != a->__cursor_end)
+					__push(a, a->__cursor, static_cast<size_type>(a->__cursor_end - a->__cursor));
+				a->__cursor = NULL;
+				a->__cursor_end = NULL;
+				b = __sort(a->__free);
+				a->__free = NULL;
+				a->__free_count = 0;
+				a->__slabs = NULL;
+				a->__tail = NULL;
+				for (; s; s = next)
+				{
+					next = s->__next;
+					end = reinterpret_cast<pointer>(s) + s->__count;
+					first = b;
+					count = 0;
+					for (; b && __below(b, end); b = b->__next)
+						count += b->__count;
+					if (count == s->__count - s->__header 
+						&& (!s->__holds_arena || reinterpret_cast<__arena *>(s + 1)->__refs == 0))
+					{
+						__alloc.deallocate(reinterpret_cast<pointer>(s), s->__count);
+						continue ;
+					}
+					s->__next = a->__slabs;
+					a->__slabs = s;
+					if (!a->__tail)
+						a->__tail = s;
+					for (; first != b; first = first->__next)
+					{
+						if (tail && reinterpret_cast<pointer>(tail) + tail->__count == reinterpret_cast<pointer>(first))
+							tail->__count += first->__count;
+						else if (tail)
+							tail = tail->__next = first;
+						else
+							tail = a->__free = first;
+						a->__free_count += first->__count;
+					}
+				}
+				if (tail)
+					tail->__next = NULL;
+				a->__free_tail = tail;
+			}
+
+			static bool __below(const void *x, const void *y)
+			{
+				return std::less<const void *>()(x, y);
+			}
+
+			/* merge sort of a list linked through __next, by address */
+			template <class Link>
+			static Link *__sort(Link *head)
+			{
+				Link	*slow = head;
+				Link	*fast;
+				Link	*right;
+
+				if (!head || !head->__next)
+					return head;
+				for (fast = head->__next; fast && fast->__next; fast = fast->__next->__next)
+					slow = slow->__next;
+				right = slow->__next;
+				slow->__next = NULL;
+				return __merge_lists(__sort(head), __sort(right));
+			}
+
+			template <class Link>
+			static Link *__merge_lists(Link *l, Link *r)
+			{
+				Link	head;
+				Link	*tail = &head;
+
+				while (l && r)
+				{
+					if (__below(l, r))
+					{
+						tail->__next = l;
+						l = l->__next;
+					}
+					else
+					{
+						tail->__next = r;
+						r = r->__next;
+					}
+					tail = tail->__next;
+				}
+				tail->__next = l ? l : r;
+				return head.__next;
+			}
+
+			static void __free_slabs(__slab *curr, allocator_type & alloc)
+			{
+				__slab *next;
+
+				while (curr)
+				{
+					next = curr->__next;
+					alloc.deallocate(reinterpret_cast<pointer>(curr), curr->__count);
+					curr = next;
+				}
+			}
+
+			/* the live arena of the group, the reference moves to it */
+			static __arena *__find_group(__arena *& group, allocator_type & alloc)
+			{
+				__arena *a = group;
+
+				while (a->__forward)
+					a = a->__forward;
+				++a->__refs;
+				__unref(group, alloc);
+				group = a;
+				return a;
+			}
+
+			void __adopt(__arena *a)
+			{
+				++a->__refs;
+				__group = a;
+			}
+
+			/* 
+				the last reference frees the slabs of the arena, itself 
+				included, then drops its forward reference 
+			*/
+			static void __unref(__arena *a, allocator_type & alloc)
+			{
+				__arena *next;
+
+				while (a && --a->__refs == 0)
+				{
+					next = a->__forward;
+					__free_slabs(a->__slabs, alloc);
+					a = next;
+				}
+			}
+	};
+
+	/* 
+		A reference on the group of a pool, which is no pool itself and never 
+		allocates: a node handle holds the group of its node with it, so the 
+		node outlives its tree, and gives a dropped node back to the group's 
+		free list. pool.share(ref) fills an empty reference with the group 
+		of pool, or puts pool in the group of ref
+	*/
+	template <class T, class Allocator, bool Pooled>
+	class node_pool<T, Allocator, Pooled>::group_ref
+	{
+		public :
+
+			explicit group_ref(const allocator_type & alloc = allocator_type())
+			:	__alloc(alloc),
+				__group(NULL)
+			{}
+
+			~group_ref()
+			{
+				release();
+			}
+
+			/* p must come from the group and must already be destroyed */
+			void give_back(pointer p)
+			{
+				__push(__live(__group, __alloc), p, 1);
+			}
+
+			void release()
+			{
+				__unref(__group, __alloc);
+				__group = NULL;
+			}
+
+			void swap(group_ref & rhs)
+			{
+				std::swap(__alloc, rhs.__alloc);
+				std::swap(__group, rhs.__group);
+			}
+
+		private :
+
+			friend class node_pool;
+
+			allocator_type	__alloc;
+			__arena			*__group;
+
+			group_ref(const group_ref &);
+			group_ref &operator=(const group_ref &);
+	};
+
+	/* Opt-out: every block is a separate allocator call --------------------- */
+	template <class T, class Allocator>
+	class node_pool<T, Allocator, false>
+	{
+		public :
+
+			typedef T				value_type;
+			typedef T *				pointer;
+			typedef Allocator		allocator_type;
+			typedef size_t			size_type;
+
+			static const bool		pooled = false;
+
+			explicit node_pool(const allocator_type & alloc = allocator_type())
+			:	__alloc(alloc)
+			{}
+
+			pointer allocate()
+			{
+				return __alloc.allocate(1);
+			}
+
+			void deallocate(pointer p)
+			{
+				__alloc.deallocate(p, 1);
+			}
+
+			/* blocks are owned individually, the caller deallocates them */
+			void release()
+			{}
+
+			bool shared()
+			{
+				return false;
+			}
+
+			/* nothing to share, blocks can move between trees as they are */
+			void share(node_pool &)
+			{}
+
+			void swap(node_pool & rhs)
+			{
+				std::swap(__alloc, rhs.__alloc);
+			}
+
+			/* a node handle frees its node alone */
+			class group_ref
+			{
+				public :
+
+					explicit group_ref(const allocator_type & alloc = allocator_type())
+					:	__alloc(alloc)
+					{}
+
+					void give_back(pointer p)
+					{
+						__alloc.deallocate(p, 1);
+					}
+
+					void release()
+					{}
+
+					void swap(group_ref & rhs)
+					{
+						std::swap(__alloc, rhs.__alloc);
+					}
+
+				private :
+
+					allocator_type	__alloc;
+
+					group_ref(const group_ref &);
+					group_ref &operator=(const group_ref &);
+			};
+
+			void share(group_ref &)
+			{}
+
+		private :
+
+			allocator_type	__alloc;
+
+			node_pool(const node_pool &);
+			node_pool &operator=(const node_pool &);
+	};
+}
+
+#endif
@@ -1,8 +1,22 @@
 #ifndef		PAIR_HPP
 # define 	PAIR_HPP
 
+# include "config.hpp"
+
 namespace ft
 {
+# if FT_CXX11
+	/* 
+		tag for the constructor building first from one argument and second in 
+		place from all the remaining ones (std::pair takes two tuples instead, 
+		which cannot be unpacked in C++11 without index sequences) 
+	*/
+	struct piecewise_construct_t
+	{};
+
+	const piecewise_construct_t piecewise_construct = piecewise_construct_t();
+# endif
+
 	template <class T1, class T2>
 	struct pair
 	{
@@ -28,8 +42,30 @@ namespace ft
 		: 	first(p.first),
 			second(p.second)
 		{}
+# if FT_CXX11
+		pair(const pair & p) = default;
+		pair(pair && p) = default;
+		template <class U1, class U2>
+		pair(U1 && x, U2 && y)
+		:	first(std::forward<U1>(x)),
+			second(std::forward<U2>(y))
+		{}
+		template <class U1, class U2>
+		pair(pair<U1, U2> && p)
+		: 	first(std::forward<U1>(p.first)),
+			second(std::forward<U2>(p.second))
+		{}
+		template <class U1, class... Args>
+		pair(piecewise_construct_t, U1 && x, Args &&... args)
+		:	first(std::forward<U1>(x)),
+			second(std::forward<Args>(args)...)
+		{}
+# endif
 		/* assignment -------------------------------------------------------- */
 		pair & operator=(const pair& other);
+# if FT_CXX11
+		pair & operator=(pair && other);
+# endif
 		
 		/* destructor -------------------------------------------------------- */
 		~pair() 
@@ -46,6 +82,20 @@ namespace ft
 		}
 		return *this;
 	}
+
+# if FT_CXX11
+	template <class T1, class T2>
+	pair<T1, T2> & pair<T1, T2>::operator=(pair<T1, T2> && other)
+	{
+		if (this != & other)
+		{
+			first = std::move(other.first);
+			second = std::move(other.second);
+		}
+		return *this;
+	}
+# endif
+
 	/* non-member functions -------------------------------------------------- */
 	template <class T1, class T2>
 	pair<T1, T2> make_pair(T1 key, T2 val)
@@ -200,9 +200,11 @@ class v_reverse_iter :	public ft::iterator<typename ft::iterator_traits<Iter>::i
 			return *(--tmp);
 		}
 
+		/* forwarded to the base iterator, whose pointer may be a proxy */
 		pointer operator->() const
 		{
-			return &(operator*());
+			Iter tmp = __iter;
+			return (--tmp).operator->();
 		}
 
 		self & operator++()
@@ -0,0 +1,198 @@
+#ifndef 	REALLOC_ALLOCATOR_HPP
+# define 	REALLOC_ALLOCATOR_HPP
+
+# include <cstddef>
+# include <cstdlib>
+# include <cstring>
+# include <new>
+# include "reallocate_traits.hpp"
+
+# if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+#  include <sys/mman.h>
+#  define FT_HAS_MMAP 	1
+# else
+#  define FT_HAS_MMAP 	0
+# endif
+
+/* mremap is Linux only, elsewhere a mapping grows by map, copy and unmap */
+# if defined(__linux__)
+#  define FT_HAS_MREMAP 	1
+# else
+#  define FT_HAS_MREMAP 	0
+# endif
+
+namespace ft
+{
+	/* Realloc allocator ------------------------------------------------------ */
+	/*
+		Allocator whose blocks can grow without copying: blocks under
+		map_threshold bytes come from malloc and grow through realloc, which
+		extends them in place when the next chunk is free; larger ones are
+		anonymous mappings, which mremap grows or shrinks by editing page
+		tables, moving them in the address space if it has to. ft::vector
+		uses reallocate for trivially relocatable elements (see
+		reallocate_traits.hpp), any other container sees a plain allocator.
+		Every instance is interchangeable, blocks are bound to their size
+	*/
+	template <class T>
+	class realloc_allocator
+	{
+		public :
+
+			typedef T				value_type;
+			typedef T *				pointer;
+			typedef const T *		const_pointer;
+			typedef T &				reference;
+			typedef const T &		const_reference;
+			typedef size_t			size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			template <class U>
+			struct rebind
+			{
+				typedef realloc_allocator<U>	other;
+			};
+
+			/* 1 MiB, below it a mapping would waste most of its last page */
+			static const size_t		map_threshold = 1 << 20;
+
+			realloc_allocator() {}
+			realloc_allocator(const realloc_allocator &) {}
+			template <class U>
+			realloc_allocator(const realloc_allocator<U> &) {}
+			~realloc_allocator() {}
+
+			pointer address(reference x) const
+			{
+				return &x;
+			}
+			const_pointer address(const_reference x) const
+			{
+				return &x;
+			}
+
+			size_type max_size() const
+			{
+				return static_cast<size_type>(-1) / sizeof(T);
+			}
+
+			pointer allocate(size_type n, const void * = 0)
+			{
+				if (n > max_size())
+					throw std::bad_alloc();
+				return static_cast<pointer>(__allocate(n * sizeof(T)));
+			}
+
+			void deallocate(pointer p, size_type n)
+			{
+				__deallocate(p, n * sizeof(T));
+			}
+
+			/*
+				resizes the block p of old_n elements to new_n, its first
+				min(old_n, new_n) elements are kept by their bytes and it may
+				move. Throws std::bad_alloc on failure, p is then untouched
+			*/
+			pointer reallocate(pointer p, size_type old_n, size_type new_n)
+			{
+				size_t	old_bytes = old_n * sizeof(T);
+				size_t	new_bytes;
+				void	*res;
+
+				if (new_n > max_size())
+					throw std::bad_alloc();
+				new_bytes = new_n * sizeof(T);
+				if (!__mapped(old_bytes) && !__mapped(new_bytes))
+				{
+					if (!(res = std::realloc(static_cast<void *>(p), new_bytes ? new_bytes : 1)))
+						throw std::bad_alloc();
+					return static_cast<pointer>(res);
+				}
+# if FT_HAS_MREMAP
+				if (__mapped(old_bytes) && __mapped(new_bytes))
+				{
+					if ((res = mremap(static_cast<void *>(p), old_bytes, new_bytes, MREMAP_MAYMOVE)) == MAP_FAILED)
+						throw std::bad_alloc();
+					return static_cast<pointer>(res);
+				}
+# endif
+				res = __allocate(new_bytes);
+				std::memcpy(res, static_cast<const void *>(p), old_bytes < new_bytes ? old_bytes : new_bytes);
+				__deallocate(p, old_bytes);
+				return static_cast<pointer>(res);
+			}
+
+			void construct(pointer p, const_reference value)
+			{
+				::new (static_cast<void *>(p)) T(value);
+			}
+
+			void destroy(pointer p)
+			{
+				p->~T();
+			}
+
+		private :
+
+			static bool __mapped(size_t bytes)
+			{
+				return FT_HAS_MMAP && bytes >= map_threshold;
+			}
+
+			/* the kernel rounds mapping lengths up to whole pages */
+			static void *__allocate(size_t bytes)
+			{
+				void *res;
+
+# if FT_HAS_MMAP
+				if (__mapped(bytes))
+				{
+					res = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+					if (res == MAP_FAILED)
+						throw std::bad_alloc();
+					return res;
+				}
+# endif
+				if (!(res = std::malloc(bytes ? bytes : 1)))
+					throw std::bad_alloc();
+				return res;
+			}
+
+			static void __deallocate(void *p, size_t bytes)
+			{
+# if FT_HAS_MMAP
+				if (__mapped(bytes))
+				{
+					munmap(p, bytes);
+					return ;
+				}
+# endif
+				std::free(p);
+			}
+	};
+
+	template <class T, class U>
+	bool operator==(const realloc_allocator<T> &, const realloc_allocator<U> &)
+	{
+		return true;
+	}
+
+	template <class T, class U>
+	bool operator!=(const realloc_allocator<T> &, const realloc_allocator<U> &)
+	{
+		return false;
+	}
+
+	template <class T>
+	struct reallocate_traits< realloc_allocator<T> >
+	{
+		static const bool value = true;
+
+		static T *reallocate(realloc_allocator<T> & alloc, T *p, size_t old_n, size_t new_n)
+		{
+			return alloc.reallocate(p, old_n, new_n);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef 	REALLOCATE_TRAITS_HPP
+# define 	REALLOCATE_TRAITS_HPP
+
+# include <cstddef>
+
+namespace ft
+{
+
+/* ---------------------------- reallocate traits ---------------------------- */
+/*
+	checks whether Alloc can resize a block it handed out, keeping its bytes:
+	in place, or by moving it the way realloc does. An allocator with a
+	member reallocate(p, old_n, new_n) opts in by specializing this template
+	(see realloc_allocator.hpp). ft::vector then grows a buffer of trivially
+	relocatable elements without copying it
+*/
+template <class Alloc>
+struct reallocate_traits
+{
+	static const bool value = false;
+
+	/* never called when value is false */
+	static typename Alloc::pointer reallocate(	Alloc &, typename Alloc::pointer p,
+												size_t, size_t)
+	{
+		return p;
+	}
+};
+
+}
+
+#endif
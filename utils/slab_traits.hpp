@@ -0,0 +1,24 @@
+#ifndef 	SLAB_TRAITS_HPP
+# define 	SLAB_TRAITS_HPP
+
+# include <cstddef>
+
+namespace ft
+{
+
+/* ------------------------------- slab traits ------------------------------- */
+/*
+	the largest slab, in bytes, a node_pool asks Alloc for. 0 keeps the 
+	pool's own limit (2048 nodes). An allocator that serves large blocks 
+	better, with huge pages for instance, raises it by specializing this 
+	template (see huge_page_allocator.hpp)
+*/
+template <class Alloc>
+struct slab_traits
+{
+	static const size_t max_bytes = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,387 @@
+#ifndef 	STATS_HPP
+# define 	STATS_HPP
+
+# include <cstddef>
+# include <ostream>
+# include "config.hpp"
+
+# if FT_STATS
+#  if FT_CXX11
+#   include <mutex>
+#  else
+#   include <pthread.h>
+#  endif
+# endif
+
+namespace ft
+{
+	/* Container statistics ---------------------------------------------------- */
+	/*
+		allocations, bytes	allocator calls of the container and the bytes
+							asked for. A pooled tree counts the nodes it
+							takes from its pool, the nil node included
+		reallocations		buffers a vector outgrew or shrank, moved to a
+							new block or resized through reallocate, and
+							rehashes of a swiss table into new arrays
+		comparisons			calls to the comparator of a tree, or to the
+							key equality of a swiss table
+		rotations			rotations of the red-black tree, fixup_steps the
+							iterations of its insert and erase fixup loops
+		max_height			deepest level a node was linked at (red-black
+							tree, the root is 1), or the most levels a B+
+							tree had
+
+		Join, split and the set operations rebalance detached subtrees
+		(see rbtree), their rotations are not counted
+	*/
+	struct container_stats
+	{
+		size_t	allocations;
+		size_t	bytes;
+		size_t	reallocations;
+		size_t	comparisons;
+		size_t	rotations;
+		size_t	fixup_steps;
+		size_t	max_height;
+
+		container_stats()
+		:	allocations(0),
+			bytes(0),
+			reallocations(0),
+			comparisons(0),
+			rotations(0),
+			fixup_steps(0),
+			max_height(0)
+		{}
+
+		container_stats & operator+=(const container_stats & rhs)
+		{
+			allocations += rhs.allocations;
+			bytes += rhs.bytes;
+			reallocations += rhs.reallocations;
+			comparisons += rhs.comparisons;
+			rotations += rhs.rotations;
+			fixup_steps += rhs.fixup_steps;
+			if (rhs.max_height > max_height)
+				max_height = rhs.max_height;
+			return *this;
+		}
+	};
+
+	/* the registry adds up the containers of a kind, whatever their types */
+	enum stats_kind
+	{
+		stats_vector,
+		stats_rbtree,
+		stats_btree,
+		stats_swiss_table,
+		stats_kind_count
+	};
+
+	inline const char *stats_kind_name(stats_kind kind)
+	{
+		static const char	*names[stats_kind_count] = {
+			"vector", "rbtree", "btree", "swiss_table"
+		};
+
+		return names[kind];
+	}
+
+	/*
+		Counters are written by the container alone, with relaxed atomic
+		loads and stores: the registry reads them from any thread, but a
+		count can be lost when const calls run at once on one container
+	*/
+	inline size_t stats_load(const size_t & counter)
+	{
+# if defined(__GNUC__) || defined(__clang__)
+		return __atomic_load_n(&counter, __ATOMIC_RELAXED);
+# else
+		return counter;
+# endif
+	}
+
+	inline void stats_store(size_t & counter, size_t value)
+	{
+# if defined(__GNUC__) || defined(__clang__)
+		__atomic_store_n(&counter, value, __ATOMIC_RELAXED);
+# else
+		counter = value;
+# endif
+	}
+
+	inline void stats_add(size_t & counter, size_t n)
+	{
+		stats_store(counter, stats_load(counter) + n);
+	}
+
+	inline void stats_max(size_t & counter, size_t value)
+	{
+		if (value > stats_load(counter))
+			stats_store(counter, value);
+	}
+
+	inline container_stats stats_load(const container_stats & s)
+	{
+		container_stats res;
+
+		res.allocations = stats_load(s.allocations);
+		res.bytes = stats_load(s.bytes);
+		res.reallocations = stats_load(s.reallocations);
+		res.comparisons = stats_load(s.comparisons);
+		res.rotations = stats_load(s.rotations);
+		res.fixup_steps = stats_load(s.fixup_steps);
+		res.max_height = stats_load(s.max_height);
+		return res;
+	}
+
+	/* a container in the registry, a node of its list of live containers */
+	struct stats_entry
+	{
+		mutable container_stats	__counters;
+		stats_kind				__kind;
+		stats_entry				*__prev;
+		stats_entry				*__next;
+	};
+
+	/* Registry ---------------------------------------------------------------- */
+	/*
+		Process-wide view of every container: the live ones are linked in a
+		list, a container leaving it adds its counters to the totals of its
+		kind. Entering and leaving take a lock, counting does not. Without
+		FT_STATS the registry stays empty and reports zeros
+	*/
+	class stats_registry
+	{
+		public :
+
+			/* the counters of every container of kind, live or destroyed */
+			static container_stats total(stats_kind kind)
+			{
+				__state			&st = __get();
+				container_stats	res;
+
+				__lock(st);
+				res = st.__retired[kind];
+				for (stats_entry *e = st.__live; e; e = e->__next)
+					if (e->__kind == kind)
+						res += stats_load(e->__counters);
+				__unlock(st);
+				return res;
+			}
+
+			/* containers of kind alive now */
+			static size_t live(stats_kind kind)
+			{
+				__state	&st = __get();
+				size_t	res = 0;
+
+				__lock(st);
+				for (stats_entry *e = st.__live; e; e = e->__next)
+					res += e->__kind == kind;
+				__unlock(st);
+				return res;
+			}
+
+			/*
+				one object per kind:
+				{"vector": {"live": 2, "allocations": 14, ...}, "rbtree": ...}
+			*/
+			static void dump_json(std::ostream & os)
+			{
+				container_stats	s;
+
+				os << "{";
+				for (int k = 0; k < stats_kind_count; ++k)
+				{
+					s = total(static_cast<stats_kind>(k));
+					os << (k ? ", " : "") << "\"" << stats_kind_name(static_cast<stats_kind>(k)) << "\": {"
+						<< "\"live\": " << live(static_cast<stats_kind>(k))
+						<< ", \"allocations\": " << s.allocations
+						<< ", \"bytes\": " << s.bytes
+						<< ", \"reallocations\": " << s.reallocations
+						<< ", \"comparisons\": " << s.comparisons
+						<< ", \"rotations\": " << s.rotations
+						<< ", \"fixup_steps\": " << s.fixup_steps
+						<< ", \"max_height\": " << s.max_height << "}";
+				}
+				os << "}";
+			}
+
+			static void __enter(stats_entry *e)
+			{
+				__state &st = __get();
+
+				__lock(st);
+				e->__prev = NULL;
+				e->__next = st.__live;
+				if (st.__live)
+					st.__live->__prev = e;
+				st.__live = e;
+				__unlock(st);
+			}
+
+			static void __leave(stats_entry *e)
+			{
+				__state &st = __get();
+
+				__lock(st);
+				if (e->__prev)
+					e->__prev->__next = e->__next;
+				else
+					st.__live = e->__next;
+				if (e->__next)
+					e->__next->__prev = e->__prev;
+				st.__retired[e->__kind] += e->__counters;
+				__unlock(st);
+			}
+
+		private :
+
+			struct __state
+			{
+				stats_entry		*__live;
+				container_stats	__retired[stats_kind_count];
+# if FT_STATS && FT_CXX11
+				std::mutex		__mutex;
+# elif FT_STATS
+				pthread_mutex_t	__mutex;
+# endif
+
+				__state()
+				:	__live(NULL)
+				{
+# if FT_STATS && !FT_CXX11
+					pthread_mutex_init(&__mutex, NULL);
+# endif
+				}
+			};
+
+			/* built by the first container, so it outlives every container */
+			static __state & __get()
+			{
+				static __state	st;
+
+				return st;
+			}
+
+			static void __lock(__state & st)
+			{
+# if FT_STATS && FT_CXX11
+				st.__mutex.lock();
+# elif FT_STATS
+				pthread_mutex_lock(&st.__mutex);
+# else
+				(void)st;
+# endif
+			}
+
+			static void __unlock(__state & st)
+			{
+# if FT_STATS && FT_CXX11
+				st.__mutex.unlock();
+# elif FT_STATS
+				pthread_mutex_unlock(&st.__mutex);
+# else
+				(void)st;
+# endif
+			}
+	};
+
+	/* Stats slot -------------------------------------------------------------- */
+	/*
+		Private base of the containers that count. A copy starts from zero
+		in the registry, assigning or swapping containers leaves their
+		counters where they are. Without FT_STATS the slot is an empty base
+		and its counting members are empty inline functions
+	*/
+# if FT_STATS
+	template <stats_kind Kind>
+	class stats_slot
+	{
+		protected :
+
+			static const bool	stats_enabled = true;
+
+			stats_slot()
+			{
+				__enter();
+			}
+			stats_slot(const stats_slot &)
+			{
+				__enter();
+			}
+			stats_slot & operator=(const stats_slot &)
+			{
+				return *this;
+			}
+			~stats_slot()
+			{
+				stats_registry::__leave(&__entry);
+			}
+
+			container_stats __stats() const
+			{
+				return stats_load(__entry.__counters);
+			}
+
+			void __stat_allocation(size_t bytes) const
+			{
+				stats_add(__entry.__counters.allocations, 1);
+				stats_add(__entry.__counters.bytes, bytes);
+			}
+			void __stat_reallocation() const
+			{
+				stats_add(__entry.__counters.reallocations, 1);
+			}
+			void __stat_comparison() const
+			{
+				stats_add(__entry.__counters.comparisons, 1);
+			}
+			void __stat_rotation() const
+			{
+				stats_add(__entry.__counters.rotations, 1);
+			}
+			void __stat_fixup_step() const
+			{
+				stats_add(__entry.__counters.fixup_steps, 1);
+			}
+			void __stat_height(size_t height) const
+			{
+				stats_max(__entry.__counters.max_height, height);
+			}
+
+		private :
+
+			stats_entry	__entry;
+
+			void __enter()
+			{
+				__entry.__kind = Kind;
+				stats_registry::__enter(&__entry);
+			}
+	};
+# else
+	template <stats_kind Kind>
+	class stats_slot
+	{
+		protected :
+
+			static const bool	stats_enabled = false;
+
+			container_stats __stats() const
+			{
+				return container_stats();
+			}
+
+			void __stat_allocation(size_t) const {}
+			void __stat_reallocation() const {}
+			void __stat_comparison() const {}
+			void __stat_rotation() const {}
+			void __stat_fixup_step() const {}
+			void __stat_height(size_t) const {}
+	};
+# endif
+}
+
+#endif
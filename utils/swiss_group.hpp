@@ -0,0 +1,205 @@
+#ifndef 	SWISS_GROUP_HPP
+# define 	SWISS_GROUP_HPP
+
+# include <cstddef>
+# if defined(__AVX2__) || defined(__SSE2__)
+#  include <immintrin.h>
+# endif
+
+namespace ft
+{
+
+/* ------------------------------ control bytes ------------------------------ */
+/*
+	swiss_table keeps one control byte per slot, next to the slots: a full
+	slot stores the low 7 bits of the hash of its key (0 .. 127), the other
+	states are negative. The sentinel follows the last slot and stops the
+	iterators
+*/
+typedef signed char		ctrl_t;
+
+const ctrl_t	ctrl_empty = -128;		/* 0b10000000 */
+const ctrl_t	ctrl_deleted = -2;		/* 0b11111110, a tombstone */
+const ctrl_t	ctrl_sentinel = -1;		/* 0b11111111 */
+
+/* --------------------------------- bitmask --------------------------------- */
+/*
+	the slots of a group that matched, one bit per slot (Shift 0, SIMD
+	groups) or the top bit of one byte per slot (Shift 3, portable group)
+*/
+template <class Mask, int Shift>
+class swiss_bitmask
+{
+	public :
+
+		explicit swiss_bitmask(Mask mask)
+		:	__mask(mask)
+		{}
+
+		bool any() const
+		{
+			return __mask != 0;
+		}
+
+		/* index of the first and of the last slot that matched, any() must be true */
+		size_t lowest() const
+		{
+			return static_cast<size_t>(__builtin_ctzll(__mask)) >> Shift;
+		}
+		size_t highest() const
+		{
+			return static_cast<size_t>(63 - __builtin_clzll(__mask)) >> Shift;
+		}
+
+		void drop_lowest()
+		{
+			__mask &= __mask - 1;
+		}
+
+	private :
+
+		Mask	__mask;
+};
+
+/* ---------------------------------- groups --------------------------------- */
+/*
+	a window of width consecutive control bytes, matched all at once. The
+	table probes a group at a time: one compare finds the slots whose 7 bit
+	hash is h2, another the empty slots that end the probe. AVX2 compares 32
+	bytes, SSE2 16, and the portable fallback 8 bytes held in a 64 bit word
+*/
+# if defined(__AVX2__)
+
+struct swiss_group
+{
+	typedef swiss_bitmask<unsigned long long, 0>	bitmask;
+
+	static const size_t	width = 32;
+
+	__m256i		ctrl;
+
+	explicit swiss_group(const ctrl_t *pos)
+	:	ctrl(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos)))
+	{}
+
+	bitmask match(ctrl_t h2) const
+	{
+		return bitmask(__movemask(_mm256_cmpeq_epi8(_mm256_set1_epi8(h2), ctrl)));
+	}
+	bitmask match_empty() const
+	{
+		return bitmask(__movemask(_mm256_cmpeq_epi8(_mm256_set1_epi8(ctrl_empty), ctrl)));
+	}
+	bitmask match_empty_or_deleted() const
+	{
+		return bitmask(__movemask(_mm256_cmpgt_epi8(_mm256_set1_epi8(ctrl_sentinel), ctrl)));
+	}
+	/* slots before the first full one or the sentinel */
+	size_t count_leading_empty_or_deleted() const
+	{
+		/* the 32 high bits of ~mask stop the count when the whole group is free */
+		return __builtin_ctzll(~__movemask(_mm256_cmpgt_epi8(_mm256_set1_epi8(ctrl_sentinel), ctrl)));
+	}
+
+	static unsigned long long __movemask(__m256i v)
+	{
+		return static_cast<unsigned int>(_mm256_movemask_epi8(v));
+	}
+};
+
+# elif defined(__SSE2__)
+
+struct swiss_group
+{
+	typedef swiss_bitmask<unsigned long long, 0>	bitmask;
+
+	static const size_t	width = 16;
+
+	__m128i		ctrl;
+
+	explicit swiss_group(const ctrl_t *pos)
+	:	ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos)))
+	{}
+
+	bitmask match(ctrl_t h2) const
+	{
+		return bitmask(__movemask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+	}
+	bitmask match_empty() const
+	{
+		return bitmask(__movemask(_mm_cmpeq_epi8(_mm_set1_epi8(ctrl_empty), ctrl)));
+	}
+	bitmask match_empty_or_deleted() const
+	{
+		return bitmask(__movemask(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl)));
+	}
+	/* bit 16 stops the count when the whole group is free */
+	size_t count_leading_empty_or_deleted() const
+	{
+		return __builtin_ctzll(__movemask(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl)) ^ 0x1FFFFULL);
+	}
+
+	static unsigned long long __movemask(__m128i v)
+	{
+		return static_cast<unsigned int>(_mm_movemask_epi8(v));
+	}
+};
+
+# else
+
+/*
+	SWAR over a 64 bit word, byte i of the group in bits 8i .. 8i + 7. The
+	h2 match may report a false positive next to a true one, the key
+	comparison that follows rejects it
+*/
+struct swiss_group
+{
+	typedef swiss_bitmask<unsigned long long, 3>	bitmask;
+
+	static const size_t	width = 8;
+
+	unsigned long long	ctrl;
+
+	explicit swiss_group(const ctrl_t *pos)
+	:	ctrl(0)
+	{
+		for (size_t i = 0; i < width; ++i)
+			ctrl |= static_cast<unsigned long long>(static_cast<unsigned char>(pos[i])) << (8 * i);
+	}
+
+	bitmask match(ctrl_t h2) const
+	{
+		unsigned long long	x = ctrl ^ (__lsbs() * static_cast<unsigned char>(h2));
+
+		return bitmask((x - __lsbs()) & ~x & __msbs());
+	}
+	bitmask match_empty() const
+	{
+		return bitmask(ctrl & ~(ctrl << 6) & __msbs());
+	}
+	bitmask match_empty_or_deleted() const
+	{
+		return bitmask(ctrl & ~(ctrl << 7) & __msbs());
+	}
+	size_t count_leading_empty_or_deleted() const
+	{
+		unsigned long long	stop = ~(ctrl & ~(ctrl << 7)) & __msbs();
+
+		return stop ? __builtin_ctzll(stop) >> 3 : width;
+	}
+
+	static unsigned long long __lsbs()
+	{
+		return 0x0101010101010101ULL;
+	}
+	static unsigned long long __msbs()
+	{
+		return 0x8080808080808080ULL;
+	}
+};
+
+# endif
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef 	SWISS_ITERATOR_HPP
+# define 	SWISS_ITERATOR_HPP
+
+# include <cstddef>
+# include <iterator>
+# include "utils.hpp"
+# include "enable_if.hpp"
+# include "swiss_group.hpp"
+
+namespace ft
+{
+	/*
+		Iterator of ft::swiss_table: a control byte and the slot it describes.
+		++ skips the empty and deleted slots a group at a time and stops on
+		the sentinel, which is end(). T is the value pointer type, as for
+		btree_iter
+	*/
+	template <class T>
+	class swiss_iter
+	{
+		public :
+			/* typedef ------------------------------------------------------- */
+			typedef std::forward_iterator_tag											iterator_category;
+			typedef typename remove_const<typename iterator_traits<T>::value_type>::type	value_type;
+			typedef typename iterator_traits<T>::reference 								reference;
+			typedef typename iterator_traits<T>::pointer								pointer;
+			typedef std::ptrdiff_t														difference_type;
+			typedef swiss_iter<T>														self;
+
+		private :
+			const ctrl_t	*__ctrl;
+			value_type		*__slot;
+
+		public :
+
+			/* coplien ------------------------------------------------------- */
+			swiss_iter()
+			:	__ctrl(NULL),
+				__slot(NULL)
+			{}
+
+			swiss_iter(const ctrl_t *ctrl, value_type *slot)
+			:	__ctrl(ctrl),
+				__slot(slot)
+			{}
+
+			/* copy, and iterator to const_iterator */
+			swiss_iter(const swiss_iter<value_type *> & rhs)
+			:	__ctrl(rhs.ctrl()),
+				__slot(rhs.slot())
+			{}
+
+			swiss_iter & operator=(const swiss_iter<value_type *> & rhs)
+			{
+				__ctrl = rhs.ctrl();
+				__slot = rhs.slot();
+				return *this;
+			}
+
+			/* public functions ---------------------------------------------- */
+			const ctrl_t *ctrl() const
+			{
+				return __ctrl;
+			}
+			value_type *slot() const
+			{
+				return __slot;
+			}
+
+			reference operator*() const
+			{
+				return *__slot;
+			}
+			pointer operator->() const
+			{
+				return __slot;
+			}
+
+			self & operator++()
+			{
+				++__ctrl;
+				++__slot;
+				skip_free();
+				return *this;
+			}
+			self operator++(int)
+			{
+				self tmp = *this;
+				++*this;
+				return tmp;
+			}
+
+			/* moves forward to the first full slot or the sentinel */
+			void skip_free()
+			{
+				while (*__ctrl < ctrl_sentinel)
+				{
+					size_t shift = swiss_group(__ctrl).count_leading_empty_or_deleted();
+
+					__ctrl += shift;
+					__slot += shift;
+				}
+			}
+
+			friend bool operator==(const self & lhs, const self & rhs)
+			{
+				return lhs.__ctrl == rhs.__ctrl;
+			}
+
+			friend bool operator!=(const self & lhs, const self & rhs)
+			{
+				return !(lhs == rhs);
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,770 @@
+#ifndef 	SWISS_TABLE_HPP
+# define 	SWISS_TABLE_HPP
+
+# include <memory>
+# include <cstring>
+# include <new>
+# include "config.hpp"
+# include "utils.hpp"
+# include "pair.hpp"
+# include "enable_if.hpp"
+# include "hash.hpp"
+# include "is_trivially_destructible.hpp"
+# include "is_trivially_relocatable.hpp"
+# include "swiss_group.hpp"
+# include "swiss_iterator.hpp"
+# include "stats.hpp"
+
+namespace ft
+{
+	/* Swiss table class ----------------------------------------------------- */
+	/*
+		Open addressing hash table behind unordered_map and unordered_set.
+		Values live in one array of capacity slots, capacity being 2^k - 1,
+		and each slot has a control byte in a second array (see
+		swiss_group.hpp). The mixed hash of a key is split in two: h1, the
+		high bits, picks the group where the probe starts, h2, the low 7 bits,
+		is stored in the control byte. A lookup compares h2 with a whole
+		group of control bytes at once and only reads the slots that matched;
+		it ends on a group with an empty slot. Groups follow each other in
+		triangular steps, which visit every group of the table.
+
+		The control array holds capacity + width bytes: the sentinel, then a
+		copy of the first width - 1 bytes, so that a group starting near the
+		end reads the start of the table instead of running off the array.
+
+		Erasing leaves a tombstone unless no probe can have gone past the
+		slot. The table grows once the full slots and the tombstones reach
+		7/8 of the capacity (or max_load_factor, if lower); if enough
+		tombstones are there, it is rehashed at the same capacity instead.
+		h1 is salted with the address of the control array, so that copying
+		a table into a smaller one does not cluster its keys.
+
+		Every insertion may rehash and invalidate all iterators; erasing
+		only invalidates the erased one. Values are moved on rehash (copied
+		when the move may throw); if a copy throws, the table is left as it
+		was. The hasher must not throw during a rehash
+	*/
+	template <	class T, class Hash, class KeyEqual, class Allocator, class KeyOfValue >
+	class swiss_table : private stats_slot<stats_swiss_table>
+	{
+		public :
+
+			typedef T												value_type;
+			typedef typename remove_const<typename KeyOfValue::result_type>::type key_type;
+			typedef KeyOfValue										key_of_value;
+			typedef Hash											hasher;
+			typedef KeyEqual										key_equal;
+			typedef Allocator										allocator_type;
+			typedef typename allocator_type::reference				reference;
+			typedef typename allocator_type::const_reference		const_reference;
+			typedef typename allocator_type::pointer				pointer;
+			typedef typename allocator_type::const_pointer			const_pointer;
+			typedef size_t											size_type;
+			typedef std::ptrdiff_t									difference_type;
+
+			typedef typename allocator_type::template rebind<ctrl_t>::other	ctrl_allocator;
+
+			/* Iterators ----------------------------------------------------- */
+			typedef swiss_iter<pointer>				iterator;
+			typedef swiss_iter<const_pointer>		const_iterator;
+
+			/* Coplien's form ------------------------------------------------ */
+			explicit swiss_table(	size_type bucket_count = 0,
+									const hasher & hash = hasher(),
+									const key_equal & eq = key_equal(),
+									const allocator_type & alloc = allocator_type())
+			:	__hash(hash),
+				__eq(eq),
+				__alloc(alloc),
+				__ctrl_alloc(alloc),
+				__ctrl(NULL),
+				__slots(NULL),
+				__capacity(0),
+				__size(0),
+				__growth_left(0),
+				__max_load(__default_max_load())
+			{
+				if (bucket_count)
+					rehash(bucket_count);
+			}
+
+			swiss_table(const swiss_table & other)
+			:	stats_slot<stats_swiss_table>(),
+				__hash(other.__hash),
+				__eq(other.__eq),
+				__alloc(other.__alloc),
+				__ctrl_alloc(other.__ctrl_alloc),
+				__ctrl(NULL),
+				__slots(NULL),
+				__capacity(0),
+				__size(0),
+				__growth_left(0),
+				__max_load(other.__max_load)
+			{
+				try
+				{
+					__copy_all(other);
+				}
+				catch (...)
+				{
+					__release();
+					throw;
+				}
+			}
+
+			/* strong guarantee, the copy is built aside */
+			swiss_table & operator=(const swiss_table & other)
+			{
+				if (this != &other)
+				{
+					swiss_table	tmp(other);
+
+					swap(tmp);
+				}
+				return *this;
+			}
+
+# if FT_CXX11
+			swiss_table(swiss_table && other)
+			:	__hash(other.__hash),
+				__eq(other.__eq),
+				__alloc(other.__alloc),
+				__ctrl_alloc(other.__ctrl_alloc),
+				__ctrl(NULL),
+				__slots(NULL),
+				__capacity(0),
+				__size(0),
+				__growth_left(0),
+				__max_load(other.__max_load)
+			{
+				swap(other);
+			}
+
+			swiss_table & operator=(swiss_table && other)
+			{
+				if (this != &other)
+				{
+					__release();
+					swap(other);
+				}
+				return *this;
+			}
+# endif
+
+			~swiss_table()
+			{
+				__release();
+			}
+
+			allocator_type get_allocator() const
+			{
+				return __alloc;
+			}
+			hasher hash_function() const
+			{
+				return __hash;
+			}
+			key_equal key_eq() const
+			{
+				return __eq;
+			}
+
+			/* Iterators ----------------------------------------------------- */
+			iterator begin()
+			{
+				iterator it(__ctrl, __slots);
+
+				if (__size)
+					it.skip_free();
+				return __size ? it : end();
+			}
+			const_iterator begin() const
+			{
+				return const_cast<swiss_table *>(this)->begin();
+			}
+			iterator end()
+			{
+				return iterator(__ctrl + __capacity, __slots + __capacity);
+			}
+			const_iterator end() const
+			{
+				return const_cast<swiss_table *>(this)->end();
+			}
+
+			/* Capacity ------------------------------------------------------ */
+			bool empty() const
+			{
+				return __size == 0;
+			}
+			size_type size() const
+			{
+				return __size;
+			}
+			size_type max_size() const
+			{
+				return __alloc.max_size();
+			}
+
+			/* Buckets and load factor --------------------------------------- */
+			/* a bucket is a slot */
+			size_type bucket_count() const
+			{
+				return __capacity;
+			}
+			float load_factor() const
+			{
+				return __capacity ? static_cast<float>(__size) / __capacity : 0.0f;
+			}
+			float max_load_factor() const
+			{
+				return __max_load;
+			}
+			/* takes effect at once, values above 7/8 are clamped to it */
+			void max_load_factor(float ml)
+			{
+				size_type	used = __growth_for(__capacity) - __growth_left;
+
+				if (ml > 0.0f)
+					__max_load = ml;
+				if (__growth_for(__capacity) < used)
+					__growth_left = 0;
+				else
+					__growth_left = __growth_for(__capacity) - used;
+			}
+			/* at least n buckets and enough for size(), tombstones are dropped */
+			void rehash(size_type n)
+			{
+				size_type	cap = __capacity_for(__size);
+
+				if (n > cap)
+					cap = __normalize(n);
+				if (cap == 0)
+					__release();
+				else if (cap != __capacity || __size + __growth_left < __growth_for(cap))
+					__resize(cap);
+			}
+			/* room for n values without a rehash */
+			void reserve(size_type n)
+			{
+				size_type	cap = __capacity_for(n);
+
+				if (n <= __size + __growth_left)
+					return;
+				__resize(cap > __capacity ? cap : __capacity);
+			}
+
+			/* Insertion ----------------------------------------------------- */
+			ft::pair<iterator, bool> insert(const value_type & x)
+			{
+				return __insert_unique(__key(x), __copy_ctor(x));
+			}
+
+			template <class InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				for (; first != last; ++first)
+					insert(*first);
+			}
+
+# if FT_CXX11
+			ft::pair<iterator, bool> insert(value_type && x)
+			{
+				return __insert_unique(__key(x), __move_ctor(x));
+			}
+
+			/* the key is only known once the value exists: built aside, then moved in */
+			template <class... Args>
+			ft::pair<iterator, bool> emplace(Args &&... args)
+			{
+				value_type tmp(std::forward<Args>(args)...);
+
+				return __insert_unique(__key(tmp), __move_ctor(tmp));
+			}
+# endif
+
+			/* see rbtree::find_or_insert */
+			template <class K, class Maker>
+			ft::pair<iterator, bool> find_or_insert(const K & k, const Maker & make)
+			{
+				return __insert_unique(k, __make_ctor<Maker>(make));
+			}
+
+# if FT_CXX11
+			template <class K, class... Args>
+			ft::pair<iterator, bool> find_or_emplace(const K & k, Args &&... args)
+			{
+				return __insert_unique(k, [&](void *p) {
+					::new (p) value_type(std::forward<Args>(args)...);
+				});
+			}
+# endif
+
+			/* Erase --------------------------------------------------------- */
+			void erase(const_iterator position)
+			{
+				__erase_at(position.ctrl() - __ctrl);
+			}
+
+			size_type erase(const key_type & key)
+			{
+				size_type	i = __find_index(key, __hash_of(key));
+
+				if (i == __capacity)
+					return 0;
+				__erase_at(i);
+				return 1;
+			}
+
+			/* nothing moves on erase, the walk goes on from the next slot */
+			void erase(const_iterator first, const_iterator last)
+			{
+				if (first == begin() && last == end())
+				{
+					clear();
+					return;
+				}
+				while (first != last)
+				{
+					size_type	i = first.ctrl() - __ctrl;
+
+					++first;
+					__erase_at(i);
+				}
+			}
+
+			/* keeps the buckets */
+			void clear()
+			{
+				__destroy_all();
+				__size = 0;
+				if (__capacity)
+					__reset_ctrl(__ctrl, __capacity);
+				__growth_left = __growth_for(__capacity);
+			}
+
+			void swap(swiss_table & other)
+			{
+				std::swap(__hash, other.__hash);
+				std::swap(__eq, other.__eq);
+				std::swap(__alloc, other.__alloc);
+				std::swap(__ctrl_alloc, other.__ctrl_alloc);
+				std::swap(__ctrl, other.__ctrl);
+				std::swap(__slots, other.__slots);
+				std::swap(__capacity, other.__capacity);
+				std::swap(__size, other.__size);
+				std::swap(__growth_left, other.__growth_left);
+				std::swap(__max_load, other.__max_load);
+			}
+
+			/* Lookup -------------------------------------------------------- */
+			/* K is key_type, or anything Hash and KeyEqual accept next to a key_type */
+			template <class K>
+			iterator find(const K & key)
+			{
+				return __iterator_at(__find_index(key, __hash_of(key)));
+			}
+			template <class K>
+			const_iterator find(const K & key) const
+			{
+				return const_cast<swiss_table *>(this)->find(key);
+			}
+			template <class K>
+			size_type count(const K & key) const
+			{
+				return __find_index(key, __hash_of(key)) != __capacity;
+			}
+			template <class K>
+			ft::pair<iterator, iterator> equal_range(const K & key)
+			{
+				iterator	first = find(key);
+				iterator	last = first;
+
+				if (first != end())
+					++last;
+				return ft::make_pair(first, last);
+			}
+			template <class K>
+			ft::pair<const_iterator, const_iterator> equal_range(const K & key) const
+			{
+				ft::pair<iterator, iterator> res = const_cast<swiss_table *>(this)->equal_range(key);
+
+				return ft::pair<const_iterator, const_iterator>(res.first, res.second);
+			}
+
+			/* Stats --------------------------------------------------------- */
+			/* counters of this table, zero unless built with FT_STATS (see stats.hpp) */
+			container_stats stats() const
+			{
+				return this->__stats();
+			}
+
+		private :
+
+			hasher				__hash;
+			key_equal			__eq;
+			allocator_type		__alloc;
+			ctrl_allocator		__ctrl_alloc;
+			ctrl_t				*__ctrl;		/* NULL while capacity is 0 */
+			value_type			*__slots;
+			size_type			__capacity;
+			size_type			__size;
+			size_type			__growth_left;	/* empty slots that may still be filled */
+			float				__max_load;
+
+			static const size_type	__width = swiss_group::width;
+
+			static float __default_max_load()
+			{
+				return 0.875f;
+			}
+
+			static const key_type & __key(const value_type & v)
+			{
+				return key_of_value()(v);
+			}
+
+			template <class K>
+			size_t __hash_of(const K & key) const
+			{
+				return hash_mix(__hash(key));
+			}
+
+			static size_t __h1(size_t hash, const ctrl_t *ctrl)
+			{
+				return (hash >> 7) ^ (reinterpret_cast<size_t>(ctrl) >> 12);
+			}
+			static ctrl_t __h2(size_t hash)
+			{
+				return static_cast<ctrl_t>(hash & 0x7F);
+			}
+
+			iterator __iterator_at(size_type i)
+			{
+				return iterator(__ctrl + i, __slots + i);
+			}
+
+			/* Sizes --------------------------------------------------------- */
+			/* the smallest 2^k - 1 not below n, n > 0 */
+			static size_type __normalize(size_type n)
+			{
+				size_type	cap = 1;
+
+				while (cap < n)
+					cap = cap * 2 + 1;
+				return cap;
+			}
+
+			/*
+				how many slots may be filled: all of them while the clones
+				leave empty bytes after the sentinel, 7/8 beyond, so that a
+				probe always meets an empty slot
+			*/
+			size_type __growth_for(size_type cap) const
+			{
+				size_type	growth = cap < __width - 1 ? cap : cap - (cap + 7) / 8;
+				size_type	limit = static_cast<size_type>(cap * __max_load);
+
+				return limit < growth ? limit : growth;
+			}
+
+			/* the smallest capacity holding n values, 0 for none */
+			size_type __capacity_for(size_type n) const
+			{
+				size_type	cap;
+
+				if (n == 0)
+					return 0;
+				cap = __normalize(n);
+				while (__growth_for(cap) < n)
+					cap = cap * 2 + 1;
+				return cap;
+			}
+
+			/* Control bytes ------------------------------------------------- */
+			static void __reset_ctrl(ctrl_t *ctrl, size_type cap)
+			{
+				std::memset(ctrl, static_cast<unsigned char>(ctrl_empty), cap + __width);
+				ctrl[cap] = ctrl_sentinel;
+			}
+
+			/* writes the byte of slot i and its clone after the sentinel */
+			static void __set_ctrl(ctrl_t *ctrl, size_type cap, size_type i, ctrl_t h)
+			{
+				ctrl[i] = h;
+				ctrl[((i - (__width - 1)) & cap) + ((__width - 1) & cap)] = h;
+			}
+
+			/* Probing ------------------------------------------------------- */
+			/* slot of key, or capacity */
+			template <class K>
+			size_type __find_index(const K & key, size_t hash) const
+			{
+				size_type	offset;
+				size_type	step = 0;
+				ctrl_t		h2 = __h2(hash);
+
+				if (__capacity == 0)
+					return 0;
+				offset = __h1(hash, __ctrl) & __capacity;
+				FT_PREFETCH(__slots + offset);
+				while (true)
+				{
+					swiss_group	g(__ctrl + offset);
+
+					for (typename swiss_group::bitmask m = g.match(h2); m.any(); m.drop_lowest())
+					{
+						size_type	i = (offset + m.lowest()) & __capacity;
+
+						this->__stat_comparison();
+						if (__eq(__key(__slots[i]), key))
+							return i;
+					}
+					if (g.match_empty().any())
+						return __capacity;
+					step += __width;
+					offset = (offset + step) & __capacity;
+				}
+			}
+
+			/* first empty or deleted slot on the probe of hash */
+			static size_type __first_non_full(const ctrl_t *ctrl, size_type cap, size_t hash)
+			{
+				size_type	offset = __h1(hash, ctrl) & cap;
+				size_type	step = 0;
+
+				while (true)
+				{
+					typename swiss_group::bitmask m = swiss_group(ctrl + offset).match_empty_or_deleted();
+
+					if (m.any())
+						return (offset + m.lowest()) & cap;
+					step += __width;
+					offset = (offset + step) & cap;
+				}
+			}
+
+			/* Insertion ----------------------------------------------------- */
+			/*
+				builds the new value in the slot handed to operator(); the
+				insertion code is shared by copy, maker and emplace
+			*/
+			struct __copy_ctor
+			{
+				const value_type	&v;
+
+				explicit __copy_ctor(const value_type & value)
+				: v(value)
+				{}
+				void operator()(void *p) const
+				{
+					::new (p) value_type(v);
+				}
+			};
+
+			template <class Maker>
+			struct __make_ctor
+			{
+				const Maker			&m;
+
+				explicit __make_ctor(const Maker & make)
+				: m(make)
+				{}
+				void operator()(void *p) const
+				{
+					::new (p) value_type(m());
+				}
+			};
+
+# if FT_CXX11
+			struct __move_ctor
+			{
+				value_type			&v;
+
+				explicit __move_ctor(value_type & value)
+				: v(value)
+				{}
+				void operator()(void *p) const
+				{
+					::new (p) value_type(std::move(v));
+				}
+			};
+# endif
+
+			/* one probe when the key is there, a second one for a free slot otherwise */
+			template <class K, class Ctor>
+			ft::pair<iterator, bool> __insert_unique(const K & key, const Ctor & ctor)
+			{
+				size_t		hash = __hash_of(key);
+				size_type	i = __find_index(key, hash);
+
+				if (i != __capacity)
+					return ft::make_pair(__iterator_at(i), false);
+				if (__growth_left == 0)
+					__grow();
+				i = __first_non_full(__ctrl, __capacity, hash);
+				ctor(static_cast<void *>(__slots + i));
+				__occupy(i, hash);
+				return ft::make_pair(__iterator_at(i), true);
+			}
+
+			void __occupy(size_type i, size_t hash)
+			{
+				__growth_left -= (__ctrl[i] == ctrl_empty);
+				__set_ctrl(__ctrl, __capacity, i, __h2(hash));
+				++__size;
+			}
+
+			/*
+				no free slot left: rehashing at the same capacity is enough
+				when an eighth of the slots that may be used are tombstones,
+				otherwise the capacity doubles
+			*/
+			void __grow()
+			{
+				size_type	growth = __growth_for(__capacity);
+				size_type	cap = __capacity_for(__size + 1);
+
+				if (__capacity && growth > __size && growth - __size >= growth / 8)
+					__resize(__capacity);
+				else
+					__resize(cap > __capacity * 2 + 1 ? cap : __capacity * 2 + 1);
+			}
+
+			/* Erase --------------------------------------------------------- */
+			/*
+				the slot becomes empty again when the full slots around it
+				never filled a whole group: no probe can have gone past it
+			*/
+			void __erase_at(size_type i)
+			{
+				size_type						before = (i - __width) & __capacity;
+				typename swiss_group::bitmask	empty_after = swiss_group(__ctrl + i).match_empty();
+				typename swiss_group::bitmask	empty_before = swiss_group(__ctrl + before).match_empty();
+				bool							never_full;
+
+				never_full = empty_before.any() && empty_after.any()
+							&& empty_after.lowest() + (__width - 1 - empty_before.highest()) < __width;
+				__slots[i].~value_type();
+				--__size;
+				__set_ctrl(__ctrl, __capacity, i, never_full ? ctrl_empty : ctrl_deleted);
+				__growth_left += never_full;
+			}
+
+			/* Storage ------------------------------------------------------- */
+			/* moves every value to new arrays of cap slots, cap > 0 */
+			void __resize(size_type cap)
+			{
+				ctrl_t		*ctrl = __ctrl_alloc.allocate(cap + __width);
+				value_type	*slots;
+
+				try
+				{
+					slots = __alloc.allocate(cap);
+				}
+				catch (...)
+				{
+					__ctrl_alloc.deallocate(ctrl, cap + __width);
+					throw;
+				}
+				this->__stat_allocation((cap + __width) * sizeof(ctrl_t));
+				this->__stat_allocation(cap * sizeof(value_type));
+				__reset_ctrl(ctrl, cap);
+				try
+				{
+					__transfer(ctrl, slots, cap);
+				}
+				catch (...)
+				{
+					if (!is_trivially_relocatable<value_type>::value)
+						__destroy_slots(ctrl, slots, cap);
+					__alloc.deallocate(slots, cap);
+					__ctrl_alloc.deallocate(ctrl, cap + __width);
+					throw;
+				}
+				if (!is_trivially_relocatable<value_type>::value)
+					__destroy_all();
+				if (__ctrl)
+					this->__stat_reallocation();
+				__deallocate();
+				__ctrl = ctrl;
+				__slots = slots;
+				__capacity = cap;
+				__growth_left = __growth_for(cap) - __size;
+			}
+
+			/* trivially relocatable values are copied byte by byte and not destroyed */
+			void __transfer(ctrl_t *ctrl, value_type *slots, size_type cap)
+			{
+				for (size_type i = 0; i < __capacity; ++i)
+				{
+					if (__ctrl[i] < 0)
+						continue;
+
+					size_t		hash = __hash_of(__key(__slots[i]));
+					size_type	j = __first_non_full(ctrl, cap, hash);
+
+					if (is_trivially_relocatable<value_type>::value)
+						std::memcpy(static_cast<void *>(slots + j), static_cast<void *>(__slots + i), sizeof(value_type));
+					else
+						::new (static_cast<void *>(slots + j)) value_type(FT_MOVE_IF_NOEXCEPT(__slots[i]));
+					__set_ctrl(ctrl, cap, j, __h2(hash));
+				}
+			}
+
+			/* other has no duplicates, its values only need a free slot */
+			void __copy_all(const swiss_table & other)
+			{
+				if (other.__size == 0)
+					return;
+				__resize(__capacity_for(other.__size));
+				for (size_type i = 0; i < other.__capacity; ++i)
+				{
+					if (other.__ctrl[i] < 0)
+						continue;
+
+					size_t		hash = __hash_of(__key(other.__slots[i]));
+					size_type	j = __first_non_full(__ctrl, __capacity, hash);
+
+					::new (static_cast<void *>(__slots + j)) value_type(other.__slots[i]);
+					__occupy(j, hash);
+				}
+			}
+
+			static void __destroy_slots(const ctrl_t *ctrl, value_type *slots, size_type cap)
+			{
+				if (is_trivially_destructible<value_type>::value)
+					return;
+				for (size_type i = 0; i < cap; ++i)
+					if (ctrl[i] >= 0)
+						slots[i].~value_type();
+			}
+
+			void __destroy_all()
+			{
+				__destroy_slots(__ctrl, __slots, __capacity);
+			}
+
+			void __deallocate()
+			{
+				if (__capacity == 0)
+					return;
+				__alloc.deallocate(__slots, __capacity);
+				__ctrl_alloc.deallocate(__ctrl, __capacity + __width);
+			}
+
+			/* back to the empty table without buckets */
+			void __release()
+			{
+				__destroy_all();
+				__deallocate();
+				__ctrl = NULL;
+				__slots = NULL;
+				__capacity = 0;
+				__size = 0;
+				__growth_left = 0;
+			}
+	};
+}
+
+#endif
@@ -4,21 +4,47 @@
 # include <memory>
 # include <functional>
 # include <algorithm>
+# include <iostream>
+# include "config.hpp"
 # include "utils.hpp"
 # include "pair.hpp"
 # include "node.hpp"
+# include "node_pool.hpp"
+# include "functional.hpp"
+# include "is_trivially_destructible.hpp"
 # include "bidirectional_iterator.hpp"
+# include "stats.hpp"
+# if FT_CXX11
+#  include <future>
+#  include <thread>
+# endif
 
 namespace ft
 {	
 	/* RB Tree class --------------------------------------------------------- */
-	template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
-	class rbtree
+	/*
+		Pooled selects where nodes come from: by default they are recycled 
+		through a node_pool owned by the tree, which also lets clear() drop 
+		whole slabs at once; false allocates every node separately
+
+		KeyOfValue extracts the key a value is ordered by, Compare orders keys. 
+		Lookups take a key only, so map never builds a value_type to search
+
+		Augment is a node policy (see node.hpp); order_statistics enables nth, 
+		rank and O(log n) distance
+	*/
+	template <	class T, class Compare = std::less<T>, class Allocator = std::allocator<T>,
+				bool Pooled = true, class KeyOfValue = ft::identity<T>, 
+				class Augment = ft::no_augment >
+	class rbtree : private stats_slot<stats_rbtree>
 	{
 		public :
 
 			typedef T											value_type;
-			typedef Node<value_type>							node;
+			typedef typename KeyOfValue::result_type			key_type;
+			typedef KeyOfValue									key_of_value;
+			typedef Augment										augment_type;
+			typedef Node<value_type, Augment>					node;
 			typedef Compare										compare;
 			typedef Allocator									allocator_type;
 			typedef typename allocator_type::reference			reference;
@@ -26,6 +52,7 @@ namespace ft
 			typedef typename allocator_type::pointer			pointer;
 			typedef typename allocator_type::const_pointer		const_pointer;
 			typedef typename allocator_type::template rebind<node>::other node__allocator;
+			typedef node_pool<node, node__allocator, Pooled>	pool_type;
 			typedef size_t										size_type;
 			typedef std::ptrdiff_t								difference_type;
 
@@ -39,15 +66,22 @@ namespace ft
 			explicit rbtree(const compare & comp = compare(), const allocator_type & alloc = allocator_type());
 			rbtree(const rbtree &other);
 			rbtree &operator=(const rbtree &other);
+# if FT_CXX11
+			rbtree(rbtree &&other);
+			rbtree &operator=(rbtree &&other);
+# endif
 			~rbtree();
 
 		protected :
 
 			compare				__compare;
 			node__allocator 	__alloc;
+			pool_type			__pool;
 			size_type 			__size;
 			node				*__root;
 			node 				*__nil;
+			node				*__leftmost; 	/* first and last element, NULL when empty */
+			node				*__rightmost;
 		
 		public : 
 
@@ -75,52 +109,223 @@ namespace ft
 			iterator insert(iterator hint, const value_type & value);
 			template <class InputIterator>
           	void insert(InputIterator first, InputIterator last);
+			/* 
+				the tree must be empty and [first, last) strictly increasing by 
+				the comparator. Not checked: the tree is built in linear time 
+				without a single comparison 
+			*/
+			template <class InputIterator>
+			void build_sorted(InputIterator first, InputIterator last);
+# if FT_CXX11
+			/* the value is built once, inside its node */
+			template <class... Args>
+			ft::pair<iterator, bool> emplace(Args &&... args);
+			template <class... Args>
+			iterator emplace_hint(iterator hint, Args &&... args);
+# endif
+			/* 
+				single descent: returns the element whose key is k, or inserts 
+				the value returned by make() where the search ended. make is only 
+				called, and a node only allocated, when k is missing 
+			*/
+			template <class K, class Maker>
+			ft::pair<iterator, bool> find_or_insert(const K & k, const Maker & make);
+			template <class K, class Maker>
+			ft::pair<iterator, bool> find_or_insert_hint(iterator hint, const K & k, const Maker & make);
+# if FT_CXX11
+			/* same, the new value is constructed in place from args */
+			template <class K, class... Args>
+			ft::pair<iterator, bool> find_or_emplace(const K & k, Args &&... args);
+			template <class K, class... Args>
+			ft::pair<iterator, bool> find_or_emplace_hint(iterator hint, const K & k, Args &&... args);
+# endif
 			
 			/* Erase --------------------------------------------------------- */
 			void erase(iterator position);
-			size_type erase(const T& x);
+			size_type erase(const key_type & key);
 			void erase(iterator first, iterator last);
 
-			ft::pair<iterator, iterator> equal_range(const T & key);
-			ft::pair<const_iterator, const_iterator> equal_range(const T & key) const;
-			iterator       lower_bound(const T& key);
-			const_iterator lower_bound(const T& key) const;
-			iterator       upper_bound(const T& key);
-			const_iterator upper_bound(const T& key) const;
-
-			iterator find(const value_type & key);
-			const_iterator find(const value_type & key) const;
+			/* Lookup -------------------------------------------------------- */
+			/* K is key_type, or anything Compare accepts next to a key_type */
+			template <class K>
+			ft::pair<iterator, iterator> equal_range(const K & key);
+			template <class K>
+			ft::pair<const_iterator, const_iterator> equal_range(const K & key) const;
+			template <class K>
+			iterator       lower_bound(const K & key);
+			template <class K>
+			const_iterator lower_bound(const K & key) const;
+			template <class K>
+			iterator       upper_bound(const K & key);
+			template <class K>
+			const_iterator upper_bound(const K & key) const;
+			template <class K>
+			iterator find(const K & key);
+			template <class K>
+			const_iterator find(const K & key) const;
+			template <class K>
+			size_type count(const K & key) const;
+
+			/* Order statistics, only with the order_statistics policy ------- */
+			iterator nth(size_type n);
+			const_iterator nth(size_type n) const;
+			template <class K>
+			size_type rank(const K & key) const;
+			size_type index_of(const_iterator pos) const;
+			difference_type distance(const_iterator first, const_iterator last) const;
+
+			/* Node handles -------------------------------------------------- */
+			/* 
+				extract unlinks the node of pos and hands it out as it is; 
+				insert_node links such a node again, unless its key is taken. 
+				The node's group must be shared with this tree's pool first, 
+				see node_pool::group_ref 
+			*/
+			node *extract(iterator pos);
+			ft::pair<iterator, bool> insert_node(node *elem);
+			iterator insert_node(iterator hint, node *elem);
+			void share_pool(typename pool_type::group_ref & group);
+
+			/* Join & split -------------------------------------------------- */
+			/* 
+				join: every key of greater is above every key of this tree, 
+				greater ends up empty. split: the elements not below key move 
+				to greater, which is cleared first. Nodes are relinked, not 
+				copied; both trees must have equal allocators, and share a 
+				pool group afterwards (see node_pool.hpp)
+			*/
+			void join(rbtree & greater);
+			template <class K>
+			void split(const K & key, rbtree & greater);
+
+			/* 
+				Set algebra: this tree becomes the union, intersection or 
+				difference with other. merge moves the nodes of other whose key 
+				is missing here, the others stay in other, as std::set::merge. 
+				forks > 0 runs up to 2^forks branches at once (C++11 only), 
+				see parallel_forks() 
+			*/
+			void merge(rbtree & other, size_type forks = 0);
+			void unite(const rbtree & other, size_type forks = 0);
+			void intersect(const rbtree & other, size_type forks = 0);
+			void subtract(const rbtree & other, size_type forks = 0);
+			static size_type parallel_forks();
+
+			/* Stats --------------------------------------------------------- */
+			/* counters of this tree, zero unless built with FT_STATS (see stats.hpp) */
+			container_stats stats() const;
 
 		protected :
 
-			void __clear(node *curr);
+			void __clear(node *curr, bool give_back);
 			void __cleanNilNode(void);
 			void __createNilNode(void);
-			void __clone(node *&curr, node *parent, node *other);
-			node *__findNode(const value_type & value) const;
-			node *__createNode(const value_type & value = value_type());
+			node *__clone(const node *other, node *&reuse);
+			node *__reuseNode(node *&reuse, const value_type & value);
+			static node *__to_vine(node *curr);
+			size_type __free_vine(node *head);
+			template <class InputIterator>
+			void __build_sorted(InputIterator & first, InputIterator last, bool checked = true);
+			node *__build_balanced(node *&chain, size_type n, size_type depth, size_type red_depth);
+			void __attach_vine(node *head, size_type n);
+			void __thread_vine(node *head);
+			void __thread_all();
+			template <class K>
+			node *__findNode(const K & key) const;
+			template <class K>
+			node *__lower_bound(const K & key) const;
+			template <class K>
+			node *__upper_bound(const K & key) const;
+
+			static const key_type & __key(const node *elem)
+			{
+				return key_of_value()(elem->_value);
+			}
+			/* every key comparison goes through here, to be counted */
+			template <class K1, class K2>
+			bool __less(const K1 & a, const K2 & b) const
+			{
+				this->__stat_comparison();
+				return __compare(a, b);
+			}
+# if FT_CXX11
+			template <class... Args>
+			node *__createNode(Args &&... args);
+# else
+			node *__createNode(const value_type & value);
+# endif
+			void __destroyNode(node *elem);
 
 			/* Insertion ----------------------------------------------------- */
-			ft::pair<node *, bool> __insert_system(const value_type & x, node * subtreeRoot);
+			template <class K>
+			node *__find_slot(const K & key, node *&parent, bool &left) const;
+			template <class K>
+			node *__find_hint_slot(iterator hint, const K & key, node *&parent, bool &left) const;
+			node *__link(node *newNode, node *parent, bool left);
+			ft::pair<node *, bool> __insert_node(node *newNode);
+			node *__insert_hint(iterator hint, node *newNode);
 			void __tree_insert_fixup(node *elem);
+			static void __insert_fixup(node *elem, node *&root, const rbtree *counted = NULL);
 
 			/* Erase --------------------------------------------------------- */
 			void __erase(node *elem);
+			void __unlink(node *elem);
 			void __transplant(node *u, node *v);
-			void __remove_node(node *elem);
-			void __tree_erase_fixup(node *elem);
+			void __tree_erase_fixup(node *elem, node *parent);
 
 			/* Rotation ------------------------------------------------------ */
 			void ___leftRotate(node *elem);
 			void ___rightRotate(node *elem);
+			static void __rotate_left(node *elem, node *&root, const rbtree *counted = NULL);
+			static void __rotate_right(node *elem, node *&root, const rbtree *counted = NULL);
+
+			/* Join & split ------------------------------------------------- */
+			/* 
+				these work on detached trees: the root has a NULL parent, may 
+				be red, and the tree's own members are not touched. Nodes 
+				dropped by the set operations are collected in a vine, a list 
+				linked through __right
+			*/
+			struct __vine
+			{
+				node		*__head;
+				node		*__tail;
+				size_type	__count;
+			};
+			enum __set_op
+			{
+				__op_union,
+				__op_intersect,
+				__op_subtract
+			};
+			/* below this black height a branch is not worth a thread */
+			static const size_type	__parallel_grain = 10;
+
+			node *__detach();
+			void __attach(node *root, size_type n);
+			static size_type __black_height(const node *t);
+			static node *__join(node *l, node *k, node *r);
+			static node *__join_right(node *l, node *k, node *r, size_type height);
+			static node *__join_left(node *l, node *k, node *r, size_type height);
+			static node *__join2(node *l, node *r);
+			static node *__split_last(node *t, node *&last);
+			static void __split_at(node *elem, node *&l, node *&r);
+			template <class K>
+			node *__split(node *t, const K & key, node *&l, node *&r) const;
+			node *__combine(node *t1, node *t2, __set_op op, __vine & out, size_type forks) const;
+			static void __vine_push(__vine & v, node *elem);
+			static void __vine_append(__vine & v, const __vine & w);
+			static void __vine_push_tree(__vine & v, node *t);
+			static void __thread_seams(node *l, node *k, node *r);
 
 			/* Min & Max ----------------------------------------------------- */
 			node *__findMin(node *elem) const;
 			node *__findMax(node *elem) const;
+			size_type __depth(const node *elem) const;
 
 			void __visualize(int tabs, node *root)
 			{
-				std::string color = root->__is_red == false ? "\x1b[30;4m" : "\x1b[31;1m" ;
+				std::string color = root->is_red() == false ? "\x1b[30;4m" : "\x1b[31;1m" ;
 				for (int i = 0; i < tabs; i++)
 					std::cout << '\t';
 				std::cout << color << root->_value << "\x1b[30m" << std::endl;
@@ -134,233 +339,504 @@ namespace ft
 
 	/* Coplien's form -------------------------------------------------------- */
 
-	template <class T, class Compare, class Allocator>
-	rbtree<T, Compare, Allocator>::rbtree()
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::rbtree()
 	: 	__compare(),
 		__alloc(),
+		__pool(__alloc),
 		__size(0),
-		__root(NULL)
+		__root(NULL),
+		__nil(NULL),
+		__leftmost(NULL),
+		__rightmost(NULL)
 	{
 		__createNilNode();
 	}
 
-	template <class T, class Compare, class Allocator>
-	rbtree<T, Compare, Allocator>::rbtree(const typename rbtree<T, Compare, Allocator>::compare & comp, 
-		const typename rbtree<T, Compare, Allocator>::allocator_type & alloc)
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::rbtree(const typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::compare & comp, 
+		const typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::allocator_type & alloc)
 	: 	__compare(comp),
 		__alloc(alloc),
+		__pool(__alloc),
 		__size(0),
-		__root(NULL)
+		__root(NULL),
+		__nil(NULL),
+		__leftmost(NULL),
+		__rightmost(NULL)
 	{
 		__createNilNode();
 	}
 
-	template <class T, class Compare, class Allocator>
-	rbtree<T, Compare, Allocator>::rbtree(const rbtree &other)
-	: 	__compare(other.__compare),
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::rbtree(const rbtree &other)
+	: 	stats_slot<stats_rbtree>(),
+		__compare(other.__compare),
 		__alloc(other.__alloc),
+		__pool(__alloc),
 		__size(other.__size),
 		__root(NULL),
-		__nil(NULL)
+		__nil(NULL),
+		__leftmost(NULL),
+		__rightmost(NULL)
 	{
+		node *reuse = NULL;
+
 		__createNilNode();
-		__clone(this->__root, NULL, other.__root);
+		try
+		{
+			this->__root = __clone(other.__root, reuse);
+		}
+		catch (...)
+		{
+			__cleanNilNode();
+			throw ;
+		}
+		if (__root)
+		{
+			this->__nil->__left = this->__root;
+			this->__root->set_parent(this->__nil);
+			this->__leftmost = __findMin(__root);
+			this->__rightmost = __findMax(__root);
+			__thread_all();
+		}
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment> & rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::operator=(const rbtree &other)
+	{
+		if (this == &other)
+			return *this;
+
+		/* 
+			the current nodes are recycled for the copy, their values are 
+			replaced one by one. Basic guarantee: if a copy throws, the tree 
+			is left empty 
+		*/
+		node *reuse = __to_vine(this->__root);
+
+		this->__root = NULL;
+		this->__leftmost = NULL;
+		this->__rightmost = NULL;
+		this->__size = 0;
+		this->__nil->__left = NULL;
+		this->__compare = other.__compare;
+		try
+		{
+			this->__root = __clone(other.__root, reuse);
+		}
+		catch (...)
+		{
+			__free_vine(reuse);
+			throw ;
+		}
+		__free_vine(reuse);
 		if (__root)
 		{
 			this->__nil->__left = this->__root;
-			this->__root->__parent = this->__nil;
+			this->__root->set_parent(this->__nil);
+			this->__leftmost = __findMin(__root);
+			this->__rightmost = __findMax(__root);
+			__thread_all();
 		}
+		this->__size = other.__size;
+		return *this;
 	}
 
-	template <class T, class Compare, class Allocator>
-	rbtree<T, Compare, Allocator> & rbtree<T, Compare, Allocator>::operator=(const rbtree &other)
+# if FT_CXX11
+	/* the source keeps a fresh nil node, everything else changes hands */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::rbtree(rbtree &&other)
+	: 	__compare(other.__compare),
+		__alloc(other.__alloc),
+		__pool(__alloc),
+		__size(0),
+		__root(NULL),
+		__nil(NULL),
+		__leftmost(NULL),
+		__rightmost(NULL)
 	{
-		node *tmp = NULL;
+		__createNilNode();
+		this->swap(other);
+	}
 
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment> & rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::operator=(rbtree &&other)
+	{
 		if (this != &other)
 		{
-			__clone(tmp, NULL, other.__root);
 			clear();
-			__root = tmp;
-			if (__root)
-			{
-				this->__nil->__left = this->__root;
-				this->__root->__parent = this->__nil;
-			}
-			__size = other.__size;
-			__alloc = other.__alloc;
-			__compare = other.__compare;
+			this->swap(other);
 		}
 		return *this;
 	}
+# endif
 
-	template <class T, class Compare, class Allocator>
-	rbtree<T, Compare, Allocator>::~rbtree()
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::~rbtree()
 	{
 		clear();
 		__cleanNilNode();
 	}
 
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::clear()
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::clear()
 	{
-		__clear(this->__root);
+		/* 
+			pooled trivially destructible values need no walk at all, unless 
+			the pool shares its slabs: the blocks then go back to the group 
+		*/
+		bool give_back = !pool_type::pooled || __pool.shared();
+
+		if (give_back || !is_trivially_destructible<value_type>::value)
+			__clear(this->__root, give_back);
+		__pool.release();
 		__root = NULL;
+		__leftmost = NULL;
+		__rightmost = NULL;
+		__size = 0;
+		this->__nil->__left = NULL;
+		node::link(this->__nil, this->__nil);
 	}
 
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::__cleanNilNode(void)
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__cleanNilNode(void)
 	{
+		/* the nil node only carries links, its value was never constructed */
 		if (this->__nil)
-		{
-			__alloc.destroy(this->__nil);
 			__alloc.deallocate(this->__nil, 1);
+	}
+
+	/* 
+		O(n) time, O(1) space: a node with a left child is rotated right until 
+		the leftmost remaining node is on top, which is then destroyed and the 
+		walk goes on with its right subtree. No recursion, however deep the tree
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__clear(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *curr, bool give_back)
+	{
+		node *next;
+
+		while (curr)
+		{
+			if (curr->__left)
+			{
+				next = curr->__left;
+				curr->__left = next->__right;
+				next->__right = curr;
+			}
+			else
+			{
+				next = curr->__right;
+				__alloc.destroy(curr);
+				if (give_back)
+					__pool.deallocate(curr);
+			}
+			curr = next;
 		}
 	}
 
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::__clear(typename rbtree<T, Compare, Allocator>::node *curr)
+	/* 
+		same rotations, without destroying: the tree becomes a list linked 
+		through __right, in key order. Returns its head
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__to_vine(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *curr)
 	{
-		if (curr == NULL)
-			return ;
-		__clear(curr->__left);
-		__clear(curr->__right);
-		__remove_node(curr);
+		node *head = NULL;
+		node *tail = NULL;
+		node *next;
+
+		while (curr)
+		{
+			if (curr->__left)
+			{
+				next = curr->__left;
+				curr->__left = next->__right;
+				next->__right = curr;
+				curr = next;
+			}
+			else
+			{
+				if (tail)
+					tail->__right = curr;
+				else
+					head = curr;
+				tail = curr;
+				curr = curr->__right;
+			}
+		}
+		return head;
+	}
+
+	/* returns the number of nodes freed */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size_type 
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__free_vine(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *head)
+	{
+		size_type	count = 0;
+		node		*next;
+
+		while (head)
+		{
+			next = head->__right;
+			__destroyNode(head);
+			head = next;
+			count++;
+		}
+		return count;
+	}
+
+	/* takes a node from the reuse list if there is one, otherwise allocates */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__reuseNode(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&reuse, 
+											const typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::value_type & value)
+	{
+		node *curr = reuse;
+
+		if (!curr)
+			return __createNode(value);
+		reuse = curr->__right;
+		__alloc.destroy(curr);
+		try
+		{
+			::new (static_cast<void *>(curr)) node(value);
+		}
+		catch (...)
+		{
+			__pool.deallocate(curr);
+			throw ;
+		}
+		return curr;
 	}
 
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::__clone(typename rbtree<T, Compare, Allocator>::node *&curr, 
-	typename rbtree<T, Compare, Allocator>::node *parent, typename rbtree<T, Compare, Allocator>::node *other)
+	/* 
+		copies the tree rooted at other in preorder, walking both trees 
+		through parent pointers instead of recursing. Nodes come from reuse 
+		first. If a copy throws, what was built so far is freed. The root of 
+		the copy has a NULL parent
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__clone(	const typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *other, 
+										typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&reuse)
 	{
+		node 		*root;
+		node 		*dst;
+		const node 	*src = other;
+
 		if (!other)
-			return ;
-		curr = __createNode(other->_value);
-		curr->__parent = parent;
-		curr->__is_red = other->__is_red;
-		__clone(curr->__right, curr, other->__right);
-		__clone(curr->__left, curr, other->__left);
+			return NULL;
+		root = __reuseNode(reuse, other->_value);
+		root->set_parent_and_color(NULL, other->is_red());
+		dst = root;
+		try
+		{
+			while (true)
+			{
+				if (src->__left && !dst->__left)
+				{
+					dst->__left = __reuseNode(reuse, src->__left->_value);
+					dst->__left->set_parent(dst);
+					src = src->__left;
+					dst = dst->__left;
+				}
+				else if (src->__right && !dst->__right)
+				{
+					dst->__right = __reuseNode(reuse, src->__right->_value);
+					dst->__right->set_parent(dst);
+					src = src->__right;
+					dst = dst->__right;
+				}
+				else 				/* both subtrees are copied, go back up */
+				{
+					Augment::update(dst);
+					if (src == other)
+						break ;
+					src = src->parent();
+					dst = dst->parent();
+					continue ;
+				}
+				dst->set_red(src->is_red());
+			}
+		}
+		catch (...)
+		{
+			__free_vine(__to_vine(root));
+			throw ;
+		}
+		return root;
 	}
 
 	/* Equal Range ----------------------------------------------------------- */
-	template <class T, class Compare, class Allocator>
-	ft::pair<typename rbtree<T, Compare, Allocator>::iterator, typename rbtree<T, Compare, Allocator>::iterator> 
-			rbtree<T, Compare, Allocator>::equal_range(const T & key)
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	ft::pair<typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator, typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator> 
+			rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::equal_range(const K & key)
 	{
 		return ft::make_pair(lower_bound(key), upper_bound(key));
 	}
 
-	template <class T, class Compare, class Allocator>
-	ft::pair<typename rbtree<T, Compare, Allocator>::const_iterator, typename rbtree<T, Compare, Allocator>::const_iterator> 
-			rbtree<T, Compare, Allocator>::equal_range(const T & key) const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	ft::pair<typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator, typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator> 
+			rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::equal_range(const K & key) const
 	{
 		return ft::make_pair(lower_bound(key), upper_bound(key));
 	}
 
 	/* Capacity -------------------------------------------------------------- */
 
-	template <class T, class Compare, class Allocator>
-	bool rbtree<T, Compare, Allocator>::empty() const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	bool rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::empty() const
 	{
 		return __size == 0;
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::size_type rbtree<T, Compare, Allocator>::size() const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size_type rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size() const
 	{
 		return __size;
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::size_type rbtree<T, Compare, Allocator>::max_size() const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size_type rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::max_size() const
 	{
 		return __alloc.max_size();
 	}
 
 	/* Iterators ------------------------------------------------------------- */
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::iterator rbtree<T, Compare, Allocator>::begin()
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::begin()
 	{
-		rbtree<T, Compare, Allocator>::iterator it;
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator it;
 
 		if (!__root)
 			it = this->__nil;
 		else
-			it = this->__findMin(__root);
+			it = this->__leftmost;
 		return it;
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::const_iterator rbtree<T, Compare, Allocator>::begin() const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::begin() const
 	{
-		rbtree<T, Compare, Allocator>::const_iterator it;
-		
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator it;
+
 		if (!__root)
 			it = this->__nil;
 		else
-			it = this->__findMin(__root);
+			it = this->__leftmost;
 		return it;
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::iterator rbtree<T, Compare, Allocator>::end()
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::end()
 	{
-		rbtree<T, Compare, Allocator>::iterator it(__nil);
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator it(__nil);
 
 		return it;
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::const_iterator rbtree<T, Compare, Allocator>::end() const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::end() const
 	{
-		rbtree<T, Compare, Allocator>::const_iterator it(__nil);
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator it(__nil);
 
 		return it;
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::reverse_iterator rbtree<T, Compare, Allocator>::rbegin()
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::reverse_iterator rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::rbegin()
 	{
 		return reverse_iterator(this->end());
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::const_reverse_iterator rbtree<T, Compare, Allocator>::rbegin() const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_reverse_iterator rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::rbegin() const
 	{
 		return const_reverse_iterator(this->end());
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::reverse_iterator rbtree<T, Compare, Allocator>::rend()
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::reverse_iterator rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::rend()
 	{
 		return reverse_iterator(this->begin());
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::const_reverse_iterator rbtree<T, Compare, Allocator>::rend() const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_reverse_iterator rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::rend() const
 	{
 		return const_reverse_iterator(this->begin());
 	}
 
 	/* Private --------------------------------------------------------------- */
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::node *rbtree<T, Compare, Allocator>::__createNode(
-					const typename rbtree<T, Compare, Allocator>::value_type & value)
+# if FT_CXX11
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class... Args>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__createNode(Args &&... args)
+	{
+		node *newNode = __pool.allocate(); 	/* size of one node */
+
+		this->__stat_allocation(sizeof(node));
+
+		try
+		{
+			::new (static_cast<void *>(newNode)) node(emplace_tag(), std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			__pool.deallocate(newNode);
+			throw ;
+		}
+		return (newNode);
+	}
+# else
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__createNode(
+					const typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::value_type & value)
 	{
-		node *newNode = __alloc.allocate(1); 	/* size of one node */
-		__alloc.construct(newNode, value);
+		node *newNode = __pool.allocate(); 	/* size of one node */
+
+		this->__stat_allocation(sizeof(node));
+
+		try
+		{
+			::new (static_cast<void *>(newNode)) node(value);
+		}
+		catch (...)
+		{
+			__pool.deallocate(newNode);
+			throw ;
+		}
 		return (newNode);
 	}
+# endif
+
+	/* a node that never made it into the tree */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__destroyNode(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem)
+	{
+		__alloc.destroy(elem);
+		__pool.deallocate(elem);
+	}
 
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::__createNilNode(void)
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__createNilNode(void)
 	{
 		this->__nil = __alloc.allocate(1);
-		this->__nil->__is_red = false;
+		this->__stat_allocation(sizeof(node));
+		this->__nil->set_parent_and_color(NULL, false);
+		this->__nil->__right = NULL;
+		this->__nil->__left = NULL;
+		node::link(this->__nil, this->__nil);
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::node 
-		*rbtree<T, Compare, Allocator>::__findMin(typename rbtree<T, Compare, Allocator>::node *elem) const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node 
+		*rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__findMin(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem) const
 	{
 		node *min = elem;
 
@@ -369,9 +845,9 @@ namespace ft
 		return min;
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::node 
-		*rbtree<T, Compare, Allocator>::__findMax(typename rbtree<T, Compare, Allocator>::node *elem) const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node 
+		*rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__findMax(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem) const
 	{
 		node *max = elem;
 		while (max && max->__right && max->__right != __nil)
@@ -379,17 +855,36 @@ namespace ft
 		return max;
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::node *
-			rbtree<T, Compare, Allocator>::__findNode(const typename rbtree<T, Compare, Allocator>::value_type & value) const 
+	/* level of a linked node, the root is 1 */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size_type 
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__depth(const typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem) const
+	{
+		size_type depth = 1;
+
+		for (; elem != __root; elem = elem->parent())
+			++depth;
+		return depth;
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	container_stats rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::stats() const
+	{
+		return this->__stats();
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+			rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__findNode(const K & key) const 
 	{
 		node *tmp = __root;
 
 		while (tmp)
 		{
-			if (__compare(tmp->_value, value))
+			if (__less(__key(tmp), key))
 				tmp = tmp->__right;
-			else if (__compare(value, tmp->_value))
+			else if (__less(key, __key(tmp)))
 				tmp = tmp->__left;
 			else
 			{
@@ -400,14 +895,17 @@ namespace ft
 	}
 
 	/* Modifiers ------------------------------------------------------------- */
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::swap(rbtree & rhs)
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::swap(rbtree & rhs)
 	{
 		std::swap(__compare, rhs.__compare);
 		std::swap(__alloc, rhs.__alloc);
+		__pool.swap(rhs.__pool);
 		std::swap(__size, rhs.__size);
 		std::swap(__root, rhs.__root);
 		std::swap(__nil, rhs.__nil);
+		std::swap(__leftmost, rhs.__leftmost);
+		std::swap(__rightmost, rhs.__rightmost);
 	}
 
 	/* Insert ---------------------------------------------------------------- */
@@ -417,437 +915,847 @@ namespace ft
 		- Assign the red color to the new node
 	*/
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::iterator 
-	rbtree<T, Compare, Allocator>::insert(	typename rbtree<T, Compare, Allocator>::iterator hint,
-											const typename rbtree<T, Compare, Allocator>::value_type& x)
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator 
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::insert(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator hint,
+											const typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::value_type& x)
 	{
-		iterator 				tmp(hint);
-		ft::pair<node *, bool> 	res;
+		node 	*parent;
+		bool 	left;
+		node 	*found = this->__find_hint_slot(hint, key_of_value()(x), parent, left);
 
-		if (hint.base() && hint != this->end() 
-			&& this->__compare(*hint, x) && this->__compare(x, *(tmp++)))
-		{
-			res = this->__insert_system(x, hint.base());
-			return iterator(res.first);
-		}
-		else
-			res = this->__insert_system(x, __root);
-		return iterator(res.first);
+		if (found)
+			return iterator(found);
+		return iterator(this->__link(this->__createNode(x), parent, left));
 	}
 
-	template <class T, class Compare, class Allocator>
-	template <class InputIterator>
-    void rbtree<T, Compare, Allocator>::insert(InputIterator first, InputIterator last)
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__insert_hint(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator hint,
+											typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *newNode)
 	{
-		for (; first != last; ++first)
+		node 	*parent;
+		bool 	left;
+		node 	*found = this->__find_hint_slot(hint, __key(newNode), parent, left);
+
+		if (found)
 		{
-			insert(*first);
+			__destroyNode(newNode);
+			return found;
 		}
+		return this->__link(newNode, parent, left);
 	}
 
-	template <class T, class Compare, class Allocator>
-	ft::pair<typename rbtree<T, Compare, Allocator>::iterator, bool> 
-	rbtree<T, Compare, Allocator>::insert(const typename rbtree<T, Compare, Allocator>::value_type & x)
-	{
-		ft::pair<node *, bool> res = this->__insert_system(x, this->__root);
-		return ft::make_pair(iterator(res.first), res.second);
-	}
-
-	/* Insert helper --------------------------------------------------------- */
-	template <class T, class Compare, class Allocator>
-	ft::pair<typename rbtree<T, Compare, Allocator>::node *, bool> 
-	rbtree<T, Compare, Allocator>::__insert_system(	const typename rbtree<T, Compare, Allocator>::value_type & value, 
-													typename rbtree<T, Compare, Allocator>::node * subtreeRoot)
+	/* 
+		an empty tree first takes the longest sorted prefix of the range in 
+		linear time, whatever is left is inserted one by one
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class InputIterator>
+    void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::insert(InputIterator first, InputIterator last)
 	{
 		if (__root == NULL)
+			__build_sorted(first, last);
+		/* sorted leftovers append in constant time through the end() hint */
+		for (; first != last; ++first)
 		{
-			__root = this->__createNode(value);
-			__root->__is_red = false;
-			__size++;
-			this->__nil->__left = this->__root;
-			this->__root->__parent = this->__nil;
-			return ft::make_pair(this->__root, true);
+			insert(this->end(), *first);
 		}
-		
-		this->__nil->__left = NULL;
-		this->__root->__parent = NULL;
+	}
 
-		node *a = subtreeRoot;
-		node *b = NULL;
-		node *newNode = this->__createNode(value); 		/* red by default */
-		__size++;
-		while (a)
-		{
-			b = a;
-			if (__compare(newNode->_value, a->_value)) 	/* comparator, second template argument */
-				a = a->__left;
-			else if (__compare(a->_value, newNode->_value))
-				a = a->__right;
-			else
-			{
-				__remove_node(newNode);
-				this->__nil->__left = this->__root;
-				this->__root->__parent = this->__nil;
-				return ft::make_pair(a, false);
-			}
-		}
-		newNode->__parent = b;
-		if (!b)
-			subtreeRoot = newNode;
-		else if (__compare(newNode->_value, b->_value))
-			b->__left = newNode;
-		else 
-			b->__right = newNode;
-		__tree_insert_fixup(newNode);
-		this->__nil->__left = this->__root;
-		this->__root->__parent = this->__nil;
-		return ft::make_pair(newNode, true);
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class InputIterator>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::build_sorted(InputIterator first, InputIterator last)
+	{
+		__build_sorted(first, last, false);
 	}
 
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::__tree_insert_fixup(typename rbtree<T, Compare, Allocator>::node *elem)
+	/* Bulk build ------------------------------------------------------------ */
+	/*
+		O(n) time complexity 
+		- Create nodes in input order, chained through __right, while the input 
+		  is sorted (equal neighbours keep the first one, like insert does)
+		- Stop without consuming the first element that is out of order
+		- Link the chain into a perfectly balanced tree
+		Unchecked, the whole range is taken as strictly increasing
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class InputIterator>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__build_sorted(InputIterator & first, InputIterator last, bool checked)
 	{
-		node *uncle = NULL;
+		node		*head = NULL;
+		node		*tail = NULL;
+		size_type	n = 0;
 
-		while (elem->__parent && elem->__parent->__is_red) 			/* check double red */
+		try
 		{
-			if (elem->__parent == elem->__parent->__parent->__left) /* parent of new node is a left child */
+			for (; first != last; ++first)
 			{
-				uncle = elem->__parent->__parent->__right; 		/* uncle of a new node */
-				if (uncle && uncle->__is_red)					/* red uncle */
+				if (checked && tail && !__less(__key(tail), key_of_value()(*first)))
 				{
-					elem->__parent->__is_red = false;
-					uncle->__is_red = false;
-					elem->__parent->__parent->__is_red = true;
-					elem = elem->__parent->__parent;
+					if (__less(key_of_value()(*first), __key(tail)))
+						break ;						/* out of order */
+					continue ;						/* duplicate */
 				}
+				node *newNode = __createNode(*first);
+				if (tail)
+					tail->__right = newNode;
 				else
-				{
-					if (elem == elem->__parent->__right)
-					{
-						elem = elem->__parent;
-						this->___leftRotate(elem);
-					}
-					elem->__parent->__is_red = false;
-					elem->__parent->__parent->__is_red = true;
-					this->___rightRotate(elem->__parent->__parent); 		/* do rotation in any case */
-				}
+					head = newNode;
+				tail = newNode;
+				n++;
 			}
-			else
+		}
+		catch (...)
+		{
+			while (head)
 			{
-				uncle = elem->__parent->__parent->__left;
-				if (uncle && uncle->__is_red)
-				{											
-					elem->__parent->__is_red = false;
-					uncle->__is_red = false;
-					elem->__parent->__parent->__is_red = true;
-					elem = elem->__parent->__parent;
-				}
-				else
-				{
-					if (elem == elem->__parent->__left)
-					{
-						elem = elem->__parent;
-						this->___rightRotate(elem);
-					}
-					elem->__parent->__is_red = false;
-					elem->__parent->__parent->__is_red = true;
-					this->___leftRotate(elem->__parent->__parent);
-				}
+				tail = head->__right;
+				__alloc.destroy(head);
+				__pool.deallocate(head);
+				head = tail;
 			}
+			throw ;
 		}
-		this->__root->__is_red = false;
+		if (n == 0)
+			return ;
+		__attach_vine(head, n);
 	}
 
-	/* Rotation  ------------------------------------------------------------- */
-	/* O(1) time complexity */
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::___leftRotate(typename rbtree<T, Compare, Allocator>::node *a)
+	/* the tree must be empty, head is a sorted list of n nodes */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__attach_vine(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *head, 
+																					size_type n)
 	{
-		node *b;
+		size_type	red_depth = 0;
 
-		/* Initialize b */
-		b = a->__right;
-		/* Left b subtree becomes a right subtree */
-		a->__right = b->__left;
-		/* Establish parent-child relationship */
-		if (b->__left)
-			b->__left->__parent = a;
-		b->__parent = a->__parent;
-		if (a == __root)
-			__root = b;
-		else if (a == a->__parent->__left)
-			a->__parent->__left = b;
-		else 
-			a->__parent->__right = b;
-		b->__left = a;
-		a->__parent = b;
+		if (n == 0)
+			return ;
+		__thread_vine(head);
+		/* every level above red_depth is full, the last partial level is red */
+		while ((size_type(2) << red_depth) <= n + 1)
+			red_depth++;
+		__attach(__build_balanced(head, n, 0, red_depth), n);
 	}
 
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::___rightRotate(typename rbtree<T, Compare, Allocator>::node *a)
+	/* Threading, only with a threaded policy ------------------------------- */
+	/* the list follows the vine, a sorted list linked through __right */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__thread_vine(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *head)
 	{
-		node *b;
+		node *prev = this->__nil;
 
-		b = a->__left;
-		a->__left = b->__right;
-		if (b->__right)
-			b->__right->__parent = a;
-		b->__parent = a->__parent;
-		if (a == __root)
-			__root = b;
-		else if (a == a->__parent->__right)
-			a->__parent->__right = b;
-		else
-			a->__parent->__left = b;
-		b->__right = a;
-		a->__parent = b;
+		if (!node::is_threaded)
+			return ;
+		for (; head; head = head->__right)
+		{
+			node::link(prev, head);
+			prev = head;
+		}
+		node::link(prev, this->__nil);
 	}
 
-	/* Lower & Upper bound --------------------------------------------------- */
-	/* returns an iterator pointing to the next smallest number just greater than or equal to that number */
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::iterator 
-				rbtree<T, Compare, Allocator>::lower_bound(const T & key)
+	/* O(n): relinks the whole list from the tree's own links */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__thread_all()
 	{
-		node *tmp = this->__root;
-		node *res = this->__nil;
+		node *prev = this->__nil;
 
-		while (tmp)
+		if (!node::is_threaded)
+			return ;
+		for (node *curr = __leftmost; curr && curr != this->__nil; curr = node_walk<node>::successor(curr))
 		{
-			if (__compare(tmp->_value, key))
-				tmp = tmp->__right;
-			else
-			{
-				res = tmp;
-				tmp = tmp->__left;
-			}
+			node::link(prev, curr);
+			prev = curr;
 		}
-		return iterator(res);
+		node::link(prev, this->__nil);
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::const_iterator 
-				rbtree<T, Compare, Allocator>::lower_bound(const T & key) const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__build_balanced(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&chain, 
+			size_type n, size_type depth, size_type red_depth)
 	{
-		node *tmp = this->__root;
-		node *res = this->__nil;
+		if (n == 0)
+			return NULL;
+
+		node *left = __build_balanced(chain, (n - 1) / 2, depth + 1, red_depth);
+		node *root = chain;
+
+		chain = chain->__right;
+		root->__left = left;
+		if (left)
+			left->set_parent(root);
+		root->__right = __build_balanced(chain, n - 1 - (n - 1) / 2, depth + 1, red_depth);
+		if (root->__right)
+			root->__right->set_parent(root);
+		root->set_red(depth == red_depth);
+		Augment::update(root);
+		return root;
+	}
 
-		while (tmp)
-		{
-			if (__compare(tmp->_value, key))
-				tmp = tmp->__right;
-			else
-			{
-				res = tmp;
-				tmp = tmp->__left;
-			}
-		}
-		return const_iterator(res);
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	ft::pair<typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator, bool> 
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::insert(const typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::value_type & x)
+	{
+		node 	*parent;
+		bool 	left;
+		node 	*found = this->__find_slot(key_of_value()(x), parent, left);
+
+		if (found)
+			return ft::make_pair(iterator(found), false);
+		return ft::make_pair(iterator(this->__link(this->__createNode(x), parent, left)), true);
 	}
-	/* returns an iterator pointing to the first element in the range [first, last) that is greater than value */
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::iterator 
-				rbtree<T, Compare, Allocator>::upper_bound(const T & key)
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K, class Maker>
+	ft::pair<typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator, bool> 
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::find_or_insert(const K & k, const Maker & make)
 	{
-		node *tmp = this->__root;
-		node *res = this->__nil;
+		node 	*parent;
+		bool 	left;
+		node 	*found = this->__find_slot(k, parent, left);
 
-		while (tmp)
-		{
-			if (__compare(key, tmp->_value))
-			{
-				res = tmp;
-				tmp = tmp->__left;
-			}
-			else
-				tmp = tmp->__right;
-		}
-		return iterator(res);
+		if (found)
+			return ft::make_pair(iterator(found), false);
+		return ft::make_pair(iterator(this->__link(this->__createNode(make()), parent, left)), true);
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::const_iterator 
-				rbtree<T, Compare, Allocator>::upper_bound(const T & key) const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K, class Maker>
+	ft::pair<typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator, bool> 
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::find_or_insert_hint(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator hint, 
+														const K & k, const Maker & make)
 	{
-		node *tmp = this->__root;
-		node *res = this->__nil;
+		node 	*parent;
+		bool 	left;
+		node 	*found = this->__find_hint_slot(hint, k, parent, left);
 
-		while (tmp)
-		{
-			if (__compare(key, tmp->_value))
-			{
-				res = tmp;
-				tmp = tmp->__left;
-			}
-			else
-				tmp = tmp->__right;
-		}
-		return const_iterator(res);
+		if (found)
+			return ft::make_pair(iterator(found), false);
+		return ft::make_pair(iterator(this->__link(this->__createNode(make()), parent, left)), true);
 	}
 
-	/* Erase ----------------------------------------------------------------- */
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::__erase(typename rbtree<T, Compare, Allocator>::node *elem)
+# if FT_CXX11
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K, class... Args>
+	ft::pair<typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator, bool> 
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::find_or_emplace(const K & k, Args &&... args)
 	{
-		node *tmp;
-		node *tmpTwo;
-		bool trueColor = elem->__is_red;
-		tmp = elem;
-		
-		if (!elem->__left)				 			/* a node to delete has only left or no child */
-		{
-			tmpTwo = elem->__right;
-			__transplant(elem, elem->__right);
-			__remove_node(elem);
-		}
+		node 	*parent;
+		bool 	left;
+		node 	*found = this->__find_slot(k, parent, left);
+
+		if (found)
+			return ft::make_pair(iterator(found), false);
+		return ft::make_pair(iterator(this->__link(this->__createNode(std::forward<Args>(args)...), parent, left)), true);
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K, class... Args>
+	ft::pair<typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator, bool> 
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::find_or_emplace_hint(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator hint, 
+														const K & k, Args &&... args)
+	{
+		node 	*parent;
+		bool 	left;
+		node 	*found = this->__find_hint_slot(hint, k, parent, left);
+
+		if (found)
+			return ft::make_pair(iterator(found), false);
+		return ft::make_pair(iterator(this->__link(this->__createNode(std::forward<Args>(args)...), parent, left)), true);
+	}
+# endif
+
+# if FT_CXX11
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class... Args>
+	ft::pair<typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator, bool> 
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::emplace(Args &&... args)
+	{
+		ft::pair<node *, bool> res = this->__insert_node(this->__createNode(std::forward<Args>(args)...));
+		return ft::make_pair(iterator(res.first), res.second);
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class... Args>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator 
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::emplace_hint(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator hint, Args &&... args)
+	{
+		return iterator(this->__insert_hint(hint, this->__createNode(std::forward<Args>(args)...)));
+	}
+# endif
+
+	/* Insert helper --------------------------------------------------------- */
+	/* 
+		returns the node holding key, or NULL and the leaf position where key 
+		belongs: under parent (NULL in an empty tree), on its left side or not 
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__find_slot(	const K & key, 
+											typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&parent, 
+											bool &left) const
+	{
+		node *curr = __root;
+
+		parent = NULL;
+		left = false;
+		while (curr)
+		{
+			parent = curr;
+			if (__less(key, __key(curr)))
+			{
+				left = true;
+				curr = curr->__left;
+			}
+			else if (__less(__key(curr), key))
+			{
+				left = false;
+				curr = curr->__right;
+			}
+			else
+				return curr;
+		}
+		return NULL;
+	}
+
+	/* 
+		same contract as __find_slot, trying the position right before hint 
+		first, then right after it. A good hint costs a predecessor or successor 
+		step, amortized O(1): insert(end(), x) of increasing keys never descends. 
+		A wrong hint falls back to the full descent 
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__find_hint_slot(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator hint, 
+												const K & key, 
+												typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&parent, 
+												bool &left) const
+	{
+		node *pos = hint.base();
+
+		if (pos == __nil)
+		{
+			if (__rightmost && __less(__key(__rightmost), key))
+			{
+				parent = __rightmost;
+				left = false;
+				return NULL;
+			}
+			return __find_slot(key, parent, left);
+		}
+		if (__less(key, __key(pos))) 				/* key goes before hint */
+		{
+			if (pos == __leftmost)
+			{
+				parent = pos;
+				left = true;
+				return NULL;
+			}
+			node *before = (--iterator(hint)).base();
+			if (__less(__key(before), key))
+			{
+				/* one of the two neighbours has a free slot facing the other */
+				left = before->__right != NULL;
+				parent = left ? pos : before;
+				return NULL;
+			}
+			return __find_slot(key, parent, left);
+		}
+		if (__less(__key(pos), key)) 				/* key goes after hint */
+		{
+			if (pos == __rightmost)
+			{
+				parent = pos;
+				left = false;
+				return NULL;
+			}
+			node *after = (++iterator(hint)).base();
+			if (__less(key, __key(after)))
+			{
+				left = pos->__right != NULL;
+				parent = left ? after : pos;
+				return NULL;
+			}
+			return __find_slot(key, parent, left);
+		}
+		return pos;
+	}
+
+	/* hangs a fresh red node at a slot found by __find_slot and rebalances */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__link(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *newNode, 
+										typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *parent, 
+										bool left)
+	{
+		__size++;
+		newNode->set_parent(parent);
+		if (parent == NULL)
+		{
+			node::link(this->__nil, newNode);
+			node::link(newNode, this->__nil);
+			__leftmost = newNode;
+			__rightmost = newNode;
+			__root = newNode;
+			__root->set_red(false);
+			__root->set_parent(this->__nil);
+			this->__nil->__left = __root;
+			this->__stat_height(1);
+			return newNode;
+		}
+		if (left)
+		{
+			parent->__left = newNode;
+			node::insert_before(parent, newNode);
+			if (parent == __leftmost)
+				__leftmost = newNode;
+		}
+		else
+		{
+			parent->__right = newNode;
+			node::insert_after(parent, newNode);
+			if (parent == __rightmost)
+				__rightmost = newNode;
+		}
+		Augment::propagate(parent, this->__nil);
+		if (stats_enabled)
+			this->__stat_height(__depth(newNode));
+
+		/* the fixup stops at a NULL parent */
+		this->__nil->__left = NULL;
+		this->__root->set_parent(NULL);
+		__tree_insert_fixup(newNode);
+		this->__nil->__left = this->__root;
+		this->__root->set_parent(this->__nil);
+		return newNode;
+	}
+
+	/* for nodes built before their key is known (emplace), dropped if taken */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	ft::pair<typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *, bool> 
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__insert_node(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *newNode)
+	{
+		node 	*parent;
+		bool 	left;
+		node 	*found = this->__find_slot(__key(newNode), parent, left);
+
+		if (found)
+		{
+			__destroyNode(newNode);
+			return ft::make_pair(found, false);
+		}
+		return ft::make_pair(this->__link(newNode, parent, left), true);
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__tree_insert_fixup(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem)
+	{
+		__insert_fixup(elem, __root, this);
+	}
+
+	/* 
+		the loop stops at a NULL parent, root is the root of that tree. Steps 
+		and rotations are counted in the stats of counted, unless it is NULL 
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__insert_fixup(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem, 
+														typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&root,
+														const rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment> *counted)
+	{
+		node *uncle = NULL;
+
+		while (elem->parent() && elem->parent()->is_red()) 			/* check double red */
+		{
+			if (counted)
+				counted->__stat_fixup_step();
+			if (elem->parent() == elem->parent()->parent()->__left) /* parent of new node is a left child */
+			{
+				uncle = elem->parent()->parent()->__right; 		/* uncle of a new node */
+				if (uncle && uncle->is_red())					/* red uncle */
+				{
+					elem->parent()->set_red(false);
+					uncle->set_red(false);
+					elem->parent()->parent()->set_red(true);
+					elem = elem->parent()->parent();
+				}
+				else
+				{
+					if (elem == elem->parent()->__right)
+					{
+						elem = elem->parent();
+						__rotate_left(elem, root, counted);
+					}
+					elem->parent()->set_red(false);
+					elem->parent()->parent()->set_red(true);
+					__rotate_right(elem->parent()->parent(), root, counted); 		/* do rotation in any case */
+				}
+			}
+			else
+			{
+				uncle = elem->parent()->parent()->__left;
+				if (uncle && uncle->is_red())
+				{											
+					elem->parent()->set_red(false);
+					uncle->set_red(false);
+					elem->parent()->parent()->set_red(true);
+					elem = elem->parent()->parent();
+				}
+				else
+				{
+					if (elem == elem->parent()->__left)
+					{
+						elem = elem->parent();
+						__rotate_right(elem, root, counted);
+					}
+					elem->parent()->set_red(false);
+					elem->parent()->parent()->set_red(true);
+					__rotate_left(elem->parent()->parent(), root, counted);
+				}
+			}
+		}
+		root->set_red(false);
+	}
+
+	/* Rotation  ------------------------------------------------------------- */
+	/* O(1) time complexity */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::___leftRotate(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *a)
+	{
+		__rotate_left(a, __root, this);
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::___rightRotate(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *a)
+	{
+		__rotate_right(a, __root, this);
+	}
+
+	/* 
+		root is the root of the tree a is in, the tree's or a detached one. 
+		counted, when not NULL, is the tree whose stats count the rotation 
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__rotate_left(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *a, 
+														typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&root,
+														const rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment> *counted)
+	{
+		node *b;
+
+		if (counted)
+			counted->__stat_rotation();
+
+		/* Initialize b */
+		b = a->__right;
+		/* Left b subtree becomes a right subtree */
+		a->__right = b->__left;
+		/* Establish parent-child relationship */
+		if (b->__left)
+			b->__left->set_parent(a);
+		b->set_parent(a->parent());
+		if (a == root)
+			root = b;
+		else if (a == a->parent()->__left)
+			a->parent()->__left = b;
+		else 
+			a->parent()->__right = b;
+		b->__left = a;
+		a->set_parent(b);
+		Augment::update(a);
+		Augment::update(b);
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__rotate_right(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *a, 
+														typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&root,
+														const rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment> *counted)
+	{
+		node *b;
+
+		if (counted)
+			counted->__stat_rotation();
+
+		b = a->__left;
+		a->__left = b->__right;
+		if (b->__right)
+			b->__right->set_parent(a);
+		b->set_parent(a->parent());
+		if (a == root)
+			root = b;
+		else if (a == a->parent()->__right)
+			a->parent()->__right = b;
+		else
+			a->parent()->__left = b;
+		b->__right = a;
+		a->set_parent(b);
+		Augment::update(a);
+		Augment::update(b);
+	}
+
+	/* Lower & Upper bound --------------------------------------------------- */
+	/* returns the node holding the smallest key not less than key, or nil */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+				rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__lower_bound(const K & key) const
+	{
+		node *tmp = this->__root;
+		node *res = this->__nil;
+
+		while (tmp)
+		{
+			if (__less(__key(tmp), key))
+				tmp = tmp->__right;
+			else
+			{
+				res = tmp;
+				tmp = tmp->__left;
+			}
+		}
+		return res;
+	}
+
+	/* returns the node holding the smallest key greater than key, or nil */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+				rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__upper_bound(const K & key) const
+	{
+		node *tmp = this->__root;
+		node *res = this->__nil;
+
+		while (tmp)
+		{
+			if (__less(key, __key(tmp)))
+			{
+				res = tmp;
+				tmp = tmp->__left;
+			}
+			else
+				tmp = tmp->__right;
+		}
+		return res;
+	}
+
+	/* returns an iterator pointing to the next smallest number just greater than or equal to that number */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator 
+				rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::lower_bound(const K & key)
+	{
+		return iterator(__lower_bound(key));
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator 
+				rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::lower_bound(const K & key) const
+	{
+		return const_iterator(__lower_bound(key));
+	}
+
+	/* returns an iterator pointing to the first element in the range [first, last) that is greater than value */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator 
+				rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::upper_bound(const K & key)
+	{
+		return iterator(__upper_bound(key));
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator 
+				rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::upper_bound(const K & key) const
+	{
+		return const_iterator(__upper_bound(key));
+	}
+
+	/* Erase ----------------------------------------------------------------- */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__erase(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem)
+	{
+		__unlink(elem);
+		__destroyNode(elem);
+	}
+
+	/* takes elem out of the tree, its value is left alone */
+		template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__unlink(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem)
+	{
+		node *tmp;
+		node *tmpTwo;
+		node *tmpTwoParent;							/* tmpTwo may be a NULL leaf */
+		bool trueColor = elem->is_red();
+		tmp = elem;
+
+		node::unthread(elem);
+		/* erase keeps the other nodes in place, the neighbour takes over */
+		if (elem == __leftmost)
+			__leftmost = elem->__right ? __findMin(elem->__right) : 
+						(elem->parent() == __nil ? NULL : elem->parent());
+		if (elem == __rightmost)
+			__rightmost = elem->__left ? __findMax(elem->__left) : 
+						(elem->parent() == __nil ? NULL : elem->parent());
+		
+		if (!elem->__left)				 			/* a node to delete has only left or no child */
+		{
+			tmpTwo = elem->__right;
+			tmpTwoParent = elem->parent();
+			__transplant(elem, elem->__right);
+		}
 		else if (!elem->__right) 					/* a node to delete has only right or no child */
 		{
 			tmpTwo = elem->__left;
+			tmpTwoParent = elem->parent();
 			__transplant(elem, elem->__left);
-			__remove_node(elem);
 		}
 		else										/* a node to delete has two children */
 		{
 			tmp = __findMin(elem->__right);
-			trueColor = tmp->__is_red;
+			trueColor = tmp->is_red();
 			tmpTwo = tmp->__right;
-			if (tmp->__parent && tmp->__parent != elem)
+			tmpTwoParent = tmp;
+			if (tmp->parent() != elem)
 			{
+				tmpTwoParent = tmp->parent();
 				__transplant(tmp, tmp->__right);
 				tmp->__right = elem->__right;
-				tmp->__right->__parent = tmp;
+				tmp->__right->set_parent(tmp);
 			}
 			__transplant(elem, tmp);
 			tmp->__left = elem->__left;
-			tmp->__left->__parent = tmp;
-			tmp->__is_red = elem->__is_red;
-			__remove_node(elem);
+			tmp->__left->set_parent(tmp);
+			tmp->set_red(elem->is_red());
 		}
-		if (trueColor == false && tmpTwo)
-			__tree_erase_fixup(tmpTwo);
+		this->__size--;
+		Augment::propagate(tmpTwoParent, this->__nil);
+		if (trueColor == false)
+			__tree_erase_fixup(tmpTwo, tmpTwoParent);
 		if (this->__root)
 		{
 			this->__nil->__left = this->__root;
-			this->__root->__parent = this->__nil;
+			this->__root->set_parent(this->__nil);
 		}
+		else
+			this->__nil->__left = NULL;
 	}
 
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::__tree_erase_fixup(typename 
-							rbtree<T, Compare, Allocator>::node *elem)
+	/* 
+		elem carries an extra black; it may be NULL, hence its parent is passed 
+		along. The sibling of a doubly black node always exists
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__tree_erase_fixup(typename 
+							rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem, 
+							typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *parent)
 	{
 		node *sibling = NULL;
-		while (elem != this->__root && !elem->__is_red)
+
+		while (elem != this->__root && (!elem || !elem->is_red()))
 		{
-			if (elem && elem == elem->__parent->__left)	
+			this->__stat_fixup_step();
+			if (elem == parent->__left)	
 			{
-				sibling = elem->__parent->__right;
-				if (sibling && sibling->__is_red)	/* case 1 */
+				sibling = parent->__right;
+				if (sibling->is_red())	/* case 1 */
 				{
-					sibling->__is_red = false;
-					elem->__parent->__is_red = true;
-					___leftRotate(elem->__parent);
-					sibling = elem->__parent->__right;
+					sibling->set_red(false);
+					parent->set_red(true);
+					___leftRotate(parent);
+					sibling = parent->__right;
 				}
-				if (sibling && sibling->__left && sibling->__right && 
-					!sibling->__left->__is_red && !sibling->__right->__is_red)	/* case 2 */
+				if ((!sibling->__left || !sibling->__left->is_red())
+					&& (!sibling->__right || !sibling->__right->is_red()))	/* case 2 */
 				{
-					sibling->__is_red = true;
-					elem = elem->__parent;
+					sibling->set_red(true);
+					elem = parent;
+					parent = elem->parent();
 				}	
 				else
 				{
-					if (sibling && sibling->__right && !sibling->__right->__is_red)
+					if (!sibling->__right || !sibling->__right->is_red())	/* case 3 */
 					{
-						sibling->__left->__is_red = false;
-						sibling->__is_red = true;
+						sibling->__left->set_red(false);
+						sibling->set_red(true);
 						___rightRotate(sibling);
-						sibling = elem->__parent->__right;
+						sibling = parent->__right;
 					}
-					if (sibling)
-						sibling->__is_red = elem->__parent->__is_red; /* case 4 */
-					elem->__parent->__is_red = false;
-					if (sibling && sibling->__right)
-						sibling->__right->__is_red = false;
-					___leftRotate(elem->__parent);
+					sibling->set_red(parent->is_red()); /* case 4 */
+					parent->set_red(false);
+					if (sibling->__right)
+						sibling->__right->set_red(false);
+					___leftRotate(parent);
 					elem = this->__root;
 				}
 			}
-			else if (elem == elem->__parent->__right)
+			else
 			{
-				sibling = elem->__parent->__left;
-				if (sibling && sibling->__is_red)
+				sibling = parent->__left;
+				if (sibling->is_red())
 				{
-					sibling->__is_red = false;
-					elem->__parent->__is_red = true;
-					___rightRotate(elem->__parent);
-					sibling = elem->__parent->__left;
+					sibling->set_red(false);
+					parent->set_red(true);
+					___rightRotate(parent);
+					sibling = parent->__left;
 				}
-				if (sibling && sibling->__left && sibling->__right && 
-					!sibling->__left->__is_red && !sibling->__right->__is_red)
+				if ((!sibling->__left || !sibling->__left->is_red())
+					&& (!sibling->__right || !sibling->__right->is_red()))
 				{
-					sibling->__is_red = true;
-					elem = elem->__parent;
-					sibling = elem->__parent->__left;
+					sibling->set_red(true);
+					elem = parent;
+					parent = elem->parent();
 				}
 				else
 				{
-					if (sibling && sibling->__left && !sibling->__left->__is_red)
+					if (!sibling->__left || !sibling->__left->is_red())
 					{
-						sibling->__right->__is_red = false;
-						sibling->__is_red = true;
+						sibling->__right->set_red(false);
+						sibling->set_red(true);
 						___leftRotate(sibling);
-						sibling = elem->__parent->__left;
-					}
-					if (sibling)
-						sibling->__is_red = elem->__parent->__is_red;
-					elem->__parent->__is_red = false;
-					if (sibling && sibling->__left)
-					{
-						sibling->__left->__is_red = false;
+						sibling = parent->__left;
 					}
-					___rightRotate(elem->__parent);
+					sibling->set_red(parent->is_red());
+					parent->set_red(false);
+					if (sibling->__left)
+						sibling->__left->set_red(false);
+					___rightRotate(parent);
 					elem = this->__root;
 				}
 			}
 		}	
-		elem->__is_red = false;
+		if (elem)
+			elem->set_red(false);
 	}
 
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::__transplant(	typename rbtree<T, Compare, Allocator>::node *toDel, 
-														typename rbtree<T, Compare, Allocator>::node *toReplace)
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__transplant(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *toDel, 
+														typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *toReplace)
 	{
-		if (toDel->__parent == this->__nil)
+		if (toDel->parent() == this->__nil)
 			this->__root = toReplace;
-		else if (toDel == toDel->__parent->__left)
-			toDel->__parent->__left = toReplace;
+		else if (toDel == toDel->parent()->__left)
+			toDel->parent()->__left = toReplace;
 		else
-			toDel->__parent->__right = toReplace;
+			toDel->parent()->__right = toReplace;
 		if (toReplace)
-			toReplace->__parent = toDel->__parent;
+			toReplace->set_parent(toDel->parent());
 	}
 
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::__remove_node(typename rbtree<T, Compare, Allocator>::node * elem)
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::erase(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator pos)
 	{
-		this->__alloc.destroy(elem);
-		this->__alloc.deallocate(elem, 1);
-		this->__size--;
-	}
-
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::erase(typename rbtree<T, Compare, Allocator>::iterator pos)
-	{
-		erase(*pos);
+		__erase(pos.base());
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::size_type rbtree<T, Compare, Allocator>::erase(const T & value)
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size_type rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::erase(const 
+		typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::key_type & key)
 	{
-		node *toErase = __findNode(value);
+		node *toErase = __findNode(key);
 
 		if (toErase)
 		{
@@ -857,36 +1765,775 @@ namespace ft
 		return 0;
 	}
 
-	template <class T, class Compare, class Allocator>
-	void rbtree<T, Compare, Allocator>::erase(	typename rbtree<T, Compare, Allocator>::iterator first, 
-												typename rbtree<T, Compare, Allocator>::iterator last)
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::erase(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator first, 
+												typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator last)
 	{
-		while (first != last)
-			erase(first++);
+		iterator	curr = first;
+		size_type	walk = 2 * __black_height(__root);
+		size_type	n = __size;
+		size_type	k = 0;
+		node		*l;
+		node		*r;
+		node		*range;
+		node		*stop = last.base() == this->__nil ? NULL : last.base();
+
+		if (first == last)
+			return ;
+		if (first == begin() && last == end())
+		{
+			clear();
+			return ;
+		}
+		for (; curr != last && k < walk; ++curr)
+			k++;
+		/* a short range is unlinked node by node */
+		if (curr == last)
+		{
+			while (first != last)
+				__erase((first++).base());
+			return ;
+		}
+		/* 
+			a long one is cut out by two splits at its ends and the rest is 
+			joined back: O(log n), plus O(k) to free the k erased nodes
+		*/
+		node::unthread(first.base(), stop ? stop : this->__nil);
+		__detach();
+		__split_at(first.base(), l, range);
+		if (stop)
+		{
+			__split_at(stop, range, r);
+			l = __join(l, stop, r);
+		}
+		k = 1 + __free_vine(__to_vine(range));
+		__destroyNode(first.base());
+		__attach(l, n - k);
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::iterator rbtree<T, Compare, Allocator>::find(const 
-		typename rbtree<T, Compare, Allocator>::value_type & key)
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator 
+				rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::find(const K & key)
 	{
 		node * tmp = __findNode(key);
 	
 		if (tmp)
-			return iterator(__findNode(key));
+			return iterator(tmp);
 		return iterator(this->end());
 	}
 
-	template <class T, class Compare, class Allocator>
-	typename rbtree<T, Compare, Allocator>::const_iterator rbtree<T, Compare, Allocator>::find(const 
-		typename rbtree<T, Compare, Allocator>::value_type & key) const
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator 
+				rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::find(const K & key) const
 	{
 		node * tmp = __findNode(key);
 	
 		if (tmp)
-			return const_iterator(__findNode(key));
+			return const_iterator(tmp);
 		return const_iterator(this->end());
 	}
 
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size_type 
+				rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::count(const K & key) const
+	{
+		return __findNode(key) ? 1 : 0;
+	}
+
+	/* Order statistics ------------------------------------------------------ */
+	/* the element at position n in key order, end() when n >= size() */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::nth(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size_type n)
+	{
+		node *curr = __root;
+
+		if (n >= __size)
+			return this->end();
+		while (curr)
+		{
+			size_type left = Augment::count(curr->__left);
+
+			if (n < left)
+				curr = curr->__left;
+			else if (n == left)
+				break ;
+			else
+			{
+				n -= left + 1;
+				curr = curr->__right;
+			}
+		}
+		return iterator(curr);
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::nth(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size_type n) const
+	{
+		return const_iterator(const_cast<rbtree *>(this)->nth(n).base());
+	}
+
+	/* the number of elements whose key is less than key */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size_type rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::rank(const K & key) const
+	{
+		node 		*curr = __root;
+		size_type 	res = 0;
+
+		while (curr)
+		{
+			if (__less(__key(curr), key))
+			{
+				res += Augment::count(curr->__left) + 1;
+				curr = curr->__right;
+			}
+			else
+				curr = curr->__left;
+		}
+		return res;
+	}
+
+	/* the position of pos in key order, size() for end() */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size_type rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::index_of(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator pos) const
+	{
+		node 		*curr = pos.base();
+		size_type 	res;
+
+		if (curr == __nil)
+			return __size;
+		res = Augment::count(curr->__left);
+		for (; curr->parent() != __nil; curr = curr->parent())
+		{
+			if (curr == curr->parent()->__right)
+				res += Augment::count(curr->parent()->__left) + 1;
+		}
+		return res;
+	}
+
+	/* same as std::distance(first, last), without walking the range */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::difference_type rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::distance(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator first, 
+											typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::const_iterator last) const
+	{
+		return static_cast<difference_type>(index_of(last)) 
+				- static_cast<difference_type>(index_of(first));
+	}
+
+	/* Node handles ---------------------------------------------------------- */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::extract(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator pos)
+	{
+		node *elem = pos.base();
+
+		__unlink(elem);
+		/* a lone red leaf, ready for __link */
+		elem->__left = NULL;
+		elem->__right = NULL;
+		elem->set_parent_and_color(NULL, true);
+		Augment::update(elem);
+		return elem;
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	ft::pair<typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator, bool> 
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::insert_node(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem)
+	{
+		node 	*parent;
+		bool 	left;
+		node 	*found = this->__find_slot(__key(elem), parent, left);
+
+		if (found)
+			return ft::make_pair(iterator(found), false);
+		return ft::make_pair(iterator(this->__link(elem, parent, left)), true);
+	}
+
+	/* the result is elem when it was linked */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator 
+	rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::insert_node(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::iterator hint, 
+											typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem)
+	{
+		node 	*parent;
+		bool 	left;
+		node 	*found = this->__find_hint_slot(hint, __key(elem), parent, left);
+
+		if (found)
+			return iterator(found);
+		return iterator(this->__link(elem, parent, left));
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::share_pool(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::pool_type::group_ref & group)
+	{
+		__pool.share(group);
+	}
+
+	/* Join & split ---------------------------------------------------------- */
+	/*
+		The tree is detached, worked on with the static helpers below, and 
+		attached again. Joining two trees of black heights h1 >= h2 around a 
+		node walks the right spine of the taller one down to a black node of 
+		height h2, hangs the node there, red, and fixes the double red the 
+		usual way: O(h1 - h2). Splitting at a key joins back the subtrees hung 
+		off the search path, O(log n) in total
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::join(rbtree & greater)
+	{
+		size_type	n;
+		node		*r;
+
+		if (this == &greater || greater.__size == 0)
+			return ;
+		__pool.share(greater.__pool);
+		n = __size + greater.__size;
+		if (__rightmost)
+			node::link(__rightmost, greater.__leftmost);
+		r = greater.__detach();
+		__attach(__join2(__detach(), r), n);
+	}
+
+	/* 
+		O(log n) for the split itself. The parts are sized from the root 
+		counts with order_statistics; otherwise they are walked together 
+		until the smaller one ends, O(min(k, n - k)) more
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::split(const K & key, rbtree & greater)
+	{
+		typedef node_count<node, Augment::counts_nodes>	counts;
+
+		size_type	n = __size;
+		size_type	k = 0;
+		node		*l;
+		node		*r;
+		node		*mid;
+		node		*a;
+		node		*b;
+
+		if (this == &greater)
+			return ;
+		greater.clear();
+		__pool.share(greater.__pool);
+		mid = __split(__detach(), key, l, r);
+		if (mid)
+			r = __join(NULL, mid, r);
+		if (counts::known)
+			k = counts::of(l);
+		else
+		{
+			a = __findMin(l);
+			b = __findMin(r);
+			for (; a && b; a = node_walk<node>::successor(a), b = node_walk<node>::successor(b))
+				k++;
+			if (a)
+				k = n - k;
+		}
+		__attach(l, k);
+		greater.__attach(r, n - __size);
+	}
+
+	/* 
+		The set operations split this tree by the root key of the other one 
+		and recurse on both sides, then join the results back: 
+		O(m log(n / m + 1)) for trees of m <= n elements, so a small tree 
+		merged into a large one costs about as much as its insertions, and 
+		two large trees cost O(n) at most. The two recursions are independent 
+		and run in parallel when forks allows it. Compare must not throw 
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::merge(rbtree & other, size_type forks)
+	{
+		__vine		dups = {NULL, NULL, 0};
+		size_type	n;
+		node		*t1;
+		node		*t2;
+
+		if (this == &other || other.__size == 0)
+			return ;
+		__pool.share(other.__pool);
+		n = __size + other.__size;
+		t2 = other.__detach();
+		t1 = __combine(__detach(), t2, __op_union, dups, forks);
+		__attach(t1, n - dups.__count);
+		other.__attach_vine(dups.__head, dups.__count);
+	}
+
+	/* the other tree is copied first, its copies are then merged */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::unite(const rbtree & other, size_type forks)
+	{
+		if (this == &other || other.__size == 0)
+			return ;
+
+		rbtree	tmp(other);
+
+		merge(tmp, forks);
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::intersect(const rbtree & other, size_type forks)
+	{
+		__vine		drop = {NULL, NULL, 0};
+		size_type	n = __size;
+		node		*root;
+
+		if (this == &other)
+			return ;
+		root = __combine(__detach(), other.__root, __op_intersect, drop, forks);
+		__attach(root, n - drop.__count);
+		__free_vine(drop.__head);
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::subtract(const rbtree & other, size_type forks)
+	{
+		__vine		drop = {NULL, NULL, 0};
+		size_type	n = __size;
+		node		*root;
+
+		if (this == &other)
+		{
+			clear();
+			return ;
+		}
+		root = __combine(__detach(), other.__root, __op_subtract, drop, forks);
+		__attach(root, n - drop.__count);
+		__free_vine(drop.__head);
+	}
+
+	/* enough forks for one branch per hardware thread, 0 without threads */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size_type rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::parallel_forks()
+	{
+		size_type	forks = 0;
+# if FT_CXX11
+		size_type	threads = std::thread::hardware_concurrency();
+
+		while ((size_type(1) << forks) < threads)
+			forks++;
+# endif
+		return forks;
+	}
+
+	/* the tree is left empty, its former root is returned with a NULL parent */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__detach()
+	{
+		node *root = __root;
+
+		if (root)
+			root->set_parent(NULL);
+		__root = NULL;
+		__leftmost = NULL;
+		__rightmost = NULL;
+		__size = 0;
+		this->__nil->__left = NULL;
+		node::link(this->__nil, this->__nil);
+		return root;
+	}
+
+	/* the tree must be empty, root is a detached tree of n elements */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__attach(typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *root, 
+																				size_type n)
+	{
+		__root = root;
+		__size = n;
+		if (!root)
+			return ;
+		root->set_parent_and_color(this->__nil, false);
+		this->__nil->__left = root;
+		__leftmost = __findMin(root);
+		__rightmost = __findMax(root);
+		/* the list inside is the caller's business, its ends are fixed here */
+		node::link(this->__nil, __leftmost);
+		node::link(__rightmost, this->__nil);
+	}
+
+	/* black nodes on the way down to a leaf, the same on every way */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::size_type rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__black_height(const typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *t)
+	{
+		size_type	height = 0;
+
+		for (; t; t = t->__left)
+			height += !t->is_red();
+		return height;
+	}
+
+	/* every key of l is below k's, every key of r above, k is a lone node */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__join(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *l, 
+																			typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *k, 
+																			typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *r)
+	{
+		size_type	hl;
+		size_type	hr;
+
+		/* a red root can always turn black */
+		if (l)
+			l->set_red(false);
+		if (r)
+			r->set_red(false);
+		hl = __black_height(l);
+		hr = __black_height(r);
+		if (hl > hr)
+			return __join_right(l, k, r, hr);
+		if (hl < hr)
+			return __join_left(l, k, r, hl);
+		k->__left = l;
+		k->__right = r;
+		k->set_parent_and_color(NULL, false);
+		if (l)
+			l->set_parent(k);
+		if (r)
+			r->set_parent(k);
+		Augment::update(k);
+		return k;
+	}
+
+	/* l is the taller tree, height is the black height of r */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__join_right(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *l, 
+																					typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *k, 
+																					typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *r, 
+																					size_type height)
+	{
+		size_type	h = __black_height(l);
+		node		*parent = NULL;
+		node		*curr = l;
+
+		while (curr && (curr->is_red() || h > height))
+		{
+			h -= !curr->is_red();
+			parent = curr;
+			curr = curr->__right;
+		}
+		k->__left = curr;
+		k->__right = r;
+		k->set_parent_and_color(parent, true);
+		if (curr)
+			curr->set_parent(k);
+		if (r)
+			r->set_parent(k);
+		parent->__right = k;
+		Augment::update(k);
+		Augment::propagate(parent, static_cast<node *>(NULL));
+		__insert_fixup(k, l);
+		return l;
+	}
+
+	/* r is the taller tree, height is the black height of l */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__join_left(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *l, 
+																					typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *k, 
+																					typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *r, 
+																					size_type height)
+	{
+		size_type	h = __black_height(r);
+		node		*parent = NULL;
+		node		*curr = r;
+
+		while (curr && (curr->is_red() || h > height))
+		{
+			h -= !curr->is_red();
+			parent = curr;
+			curr = curr->__left;
+		}
+		k->__left = l;
+		k->__right = curr;
+		k->set_parent_and_color(parent, true);
+		if (curr)
+			curr->set_parent(k);
+		if (l)
+			l->set_parent(k);
+		parent->__left = k;
+		Augment::update(k);
+		Augment::propagate(parent, static_cast<node *>(NULL));
+		__insert_fixup(k, r);
+		return r;
+	}
+
+	/* same as __join, without a middle node */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__join2(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *l, 
+																				typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *r)
+	{
+		node *last;
+
+		if (!l)
+			return r;
+		if (!r)
+			return l;
+		l = __split_last(l, last);
+		return __join(l, last, r);
+	}
+
+	/* takes the last node out of t, returns what is left */
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__split_last(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *t, 
+																					typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&last)
+	{
+		node *a = t->__left;
+		node *b = t->__right;
+
+		if (a)
+			a->set_parent(NULL);
+		if (!b)
+		{
+			last = t;
+			return a;
+		}
+		b->set_parent(NULL);
+		b = __split_last(b, last);
+		return __join(a, t, b);
+	}
+
+	/* 
+		l gets the keys below key, r the keys above; the node of key, if 
+		any, is returned alone
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	template <class K>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__split(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *t, 
+																				const K & key,
+																				typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&l, 
+																				typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&r) const
+	{
+		node *a;
+		node *b;
+		node *mid;
+
+		if (!t)
+		{
+			l = NULL;
+			r = NULL;
+			return NULL;
+		}
+		a = t->__left;
+		b = t->__right;
+		if (a)
+			a->set_parent(NULL);
+		if (b)
+			b->set_parent(NULL);
+		if (__less(key, __key(t)))
+		{
+			mid = __split(a, key, l, r);
+			r = __join(r, t, b);
+			return mid;
+		}
+		if (__less(__key(t), key))
+		{
+			mid = __split(b, key, l, r);
+			l = __join(a, t, l);
+			return mid;
+		}
+		l = a;
+		r = b;
+		t->__left = NULL;
+		t->__right = NULL;
+		return t;
+	}
+
+	/* 
+		same as __split at the key of elem, found by its parents instead of 
+		comparisons: elem is taken out alone, l and r get what was before and 
+		after it
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__split_at(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem, 
+																				typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&l, 
+																				typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *&r)
+	{
+		node *child = elem;
+		node *parent = elem->parent();
+		node *up;
+		node *side;
+
+		l = elem->__left;
+		r = elem->__right;
+		if (l)
+			l->set_parent(NULL);
+		if (r)
+			r->set_parent(NULL);
+		for (; parent; child = parent, parent = up)
+		{
+			up = parent->parent();
+			if (parent->__right == child)
+			{
+				side = parent->__left;
+				if (side)
+					side->set_parent(NULL);
+				l = __join(side, parent, l);
+			}
+			else
+			{
+				side = parent->__right;
+				if (side)
+					side->set_parent(NULL);
+				r = __join(r, parent, side);
+			}
+		}
+		elem->__left = NULL;
+		elem->__right = NULL;
+		elem->set_parent(NULL);
+	}
+
+	/* 
+		t1 is split by the root key of t2 and each side is combined with the 
+		matching subtree of t2. The union consumes t2, whose nodes already 
+		in t1 go to out; otherwise t2 is only read and out gets the nodes 
+		taken out of t1
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *
+		rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__combine(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *t1, 
+																				typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *t2, 
+																				__set_op op, __vine & out, size_type forks) const
+	{
+		__vine	right_out = {NULL, NULL, 0};
+		node	*a;
+		node	*b;
+		node	*l1;
+		node	*r1;
+		node	*mid;
+		node	*left;
+		node	*right;
+
+		if (!t1 || !t2)
+		{
+			if (op == __op_union)
+				return t1 ? t1 : t2;
+			if (op == __op_intersect)
+			{
+				__vine_push_tree(out, t1);
+				return NULL;
+			}
+			return t1;
+		}
+		a = t2->__left;
+		b = t2->__right;
+		if (op == __op_union)
+		{
+			if (a)
+				a->set_parent(NULL);
+			if (b)
+				b->set_parent(NULL);
+		}
+		mid = __split(t1, __key(t2), l1, r1);
+# if FT_CXX11
+		if (forks && __black_height(t2) >= __parallel_grain)
+		{
+			std::future<node *> pending = std::async(std::launch::async | std::launch::deferred, 
+													&rbtree::__combine, this, l1, a, op, std::ref(out), forks - 1);
+
+			right = __combine(r1, b, op, right_out, forks - 1);
+			left = pending.get();
+		}
+		else
+# endif
+		{
+			left = __combine(l1, a, op, out, forks);
+			right = __combine(r1, b, op, right_out, forks);
+		}
+		if (op == __op_union)
+		{
+			if (mid)
+				__vine_push(out, t2);
+			else
+				mid = t2;
+		}
+		else if (op == __op_subtract && mid)
+		{
+			__vine_push(out, mid);
+			mid = NULL;
+		}
+		__vine_append(out, right_out);
+		__thread_seams(left, mid, right);
+		if (mid)
+			return __join(left, mid, right);
+		return __join2(left, right);
+	}
+
+	/* 
+		Each result of __combine keeps a list linked in key order: a part of 
+		either tree is a range of its list, and two results are linked here 
+		where they meet, around k when it is not NULL. O(log n) a call, as the 
+		split that comes with it 
+	*/
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__thread_seams(	typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *l, 
+																					typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *k, 
+																					typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *r)
+	{
+		node *prev;
+
+		if (!node::is_threaded)
+			return ;
+		prev = node_walk<node>::maximum(l);
+		if (k)
+		{
+			if (prev)
+				node::link(prev, k);
+			prev = k;
+		}
+		if (prev && r)
+			node::link(prev, node_walk<node>::minimum(r));
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__vine_push(	__vine & v, 
+																					typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *elem)
+	{
+		elem->__left = NULL;
+		elem->__right = NULL;
+		if (v.__tail)
+			v.__tail->__right = elem;
+		else
+			v.__head = elem;
+		v.__tail = elem;
+		v.__count++;
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__vine_append(__vine & v, const __vine & w)
+	{
+		if (!w.__head)
+			return ;
+		if (v.__tail)
+			v.__tail->__right = w.__head;
+		else
+			v.__head = w.__head;
+		v.__tail = w.__tail;
+		v.__count += w.__count;
+	}
+
+	template <class T, class Compare, class Allocator, bool Pooled, class KeyOfValue, class Augment>
+	void rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::__vine_push_tree(	__vine & v, 
+																						typename rbtree<T, Compare, Allocator, Pooled, KeyOfValue, Augment>::node *t)
+	{
+		__vine	w = {__to_vine(t), NULL, 0};
+
+		for (node *curr = w.__head; curr; curr = curr->__right)
+		{
+			w.__tail = curr;
+			w.__count++;
+		}
+		__vine_append(v, w);
+	}
+
 } // end of namespace ft
 
 #endif
\ No newline at end of file
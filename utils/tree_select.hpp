@@ -0,0 +1,41 @@
+#ifndef 	TREE_SELECT_HPP
+# define 	TREE_SELECT_HPP
+
+# include "tree.hpp"
+# include "btree.hpp"
+# include "node_handle.hpp"
+
+namespace ft
+{
+	/*
+		Tree behind map and set, picked by their Policy parameter: a node
+		policy of rbtree (no_augment, order_statistics, see node.hpp), or
+		btree_nodes<N> for the B+ tree with nodes of about N bytes
+	*/
+	template <class Policy, class T, class Compare, class Allocator, class KeyOfValue>
+	struct select_tree
+	{
+		typedef ft::rbtree<T, Compare, Allocator, true, KeyOfValue, Policy>		type;
+	};
+
+	template <size_t NodeBytes, class T, class Compare, class Allocator, class KeyOfValue>
+	struct select_tree<btree_nodes<NodeBytes>, T, Compare, Allocator, KeyOfValue>
+	{
+		typedef ft::btree<T, Compare, Allocator, KeyOfValue, NodeBytes>		type;
+	};
+
+	/* node_type of map and set, Handle unless the tree has no node handles */
+	template <class Policy, class Handle>
+	struct select_node_handle
+	{
+		typedef Handle		type;
+	};
+
+	template <size_t NodeBytes, class Handle>
+	struct select_node_handle<btree_nodes<NodeBytes>, Handle>
+	{
+		typedef no_node_handle	type;
+	};
+}
+
+#endif
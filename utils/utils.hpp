@@ -2,6 +2,7 @@
 # define 	ITERATOR_TRAITS_HPP
 
 # include <iterator>
+# include <cstddef>
 
 namespace ft
 {
@@ -140,6 +141,29 @@ typename ft::iterator_traits<It>::difference_type
     return result;
 }
 
+/* -------------------------------- from sorted ------------------------------ */
+/* 
+	tag for the constructors of ordered containers whose input range is already 
+	sorted by the container's comparator. map and set trust it: the range must 
+	be strictly increasing, and the tree is built bottom-up in linear time 
+	without a comparison. flat_map, flat_set and static_set check the order as 
+	they copy and sort whatever is out of place 
+*/
+struct from_sorted_t
+{};
+
+const from_sorted_t from_sorted = from_sorted_t();
+
+/* --------------------------------- parallel -------------------------------- */
+/* 
+	tag for the bulk set operations of map and set: the work is split between 
+	the hardware threads. Without C++11 threads it runs on the calling thread 
+*/
+struct parallel_t
+{};
+
+const parallel_t parallel = parallel_t();
+
 }
 
 #endif
\ No newline at end of file